@@ -14,8 +14,13 @@
 #include "components/AsyncNotificationComponent.h"
 #include "VolumeControl.h"
 #include "EsLocale.h"
+#include "SystemMetrics.h"
 #include <algorithm>
 
+// Name of the internet check on the CommandExecutor : concurrent requests share the same run
+#define INTERNET_STATUS_TASK "ApiSystem::getInternetStatus"
+#define NETWORK_STATUS_TIMEOUT 10000
+
 UpdateState::State ApiSystem::state = UpdateState::State::NO_UPDATE;
 
 class ThreadedUpdater
@@ -144,6 +149,113 @@ bool ApiSystem::executeScript(const std::string command)
 	return executeSystemScript(command);
 }
 
+std::string ApiSystem::getScriptSerial(const std::string& command)
+{
+	return command.substr(0, command.find(' '));
+}
+
+void ApiSystem::executeScriptAsync(const std::string command, Window* window, const std::function<void(bool)>& func, int timeout)
+{
+	if (window == nullptr || func == nullptr)
+		CommandExecutor::run(command, timeout, getScriptSerial(command));
+	else
+		CommandExecutor::run(command, window, [func](const CommandResult& result) { func(result.succeeded()); }, timeout, nullptr, getScriptSerial(command));
+}
+
+// The commands read by the screens of a script. A getter missing here still works : it runs its command when called
+std::vector<std::string> ApiSystem::getScriptGetters(ScriptId script)
+{
+	switch (script)
+	{
+		case POWER_KEY:
+				return { "es-powerkey get two_push_shutdown", "es-powerkey get max_interval_time", "es-powerkey get action" };
+		case DISPLAY:
+				return { "es-display get auto_dim_stay_awake_while_charging", "es-display get auto_dim_time", "es-display get auto_dim_timeout", "es-display get auto_dim_brightness" };
+		case SYSTEM_HOTKEY_EVENTS:
+				return { "es-system_hotkey get brightness", "es-system_hotkey get brightness_step", "es-system_hotkey get volume", "es-system_hotkey get volume_step",
+					"es-system_hotkey get wifi", "es-system_hotkey get performance", "es-system_hotkey get suspend" };
+		case AUTO_SUSPEND:
+				return { "es-auto_suspend get auto_suspend_time", "es-auto_suspend get auto_suspend_timeout", "es-auto_suspend get auto_suspend_battery",
+					"es-auto_suspend get auto_suspend_battery_level", "es-auto_suspend get auto_suspend_stay_awake_while_charging" };
+		case RETROACHIVEMENTS:
+				return { "es-cheevos get cheevos_enable", "es-cheevos get cheevos_hardcore_mode_enable", "es-cheevos get cheevos_leaderboards_enable",
+					"es-cheevos get cheevos_verbose_enable", "es-cheevos get cheevos_auto_screenshot", "es-cheevos get cheevos_sound_folders",
+					"es-cheevos get cheevos_username", "es-cheevos get cheevos_challenge_indicators", "es-cheevos get cheevos_richpresence_enable",
+					"es-cheevos get cheevos_badges_enable", "es-cheevos get cheevos_test_unofficial", "es-cheevos get cheevos_start_active",
+					"es-cheevos get cheevos_password" };
+		case LOG_SCRIPTS:
+				return { "es-log_scripts is_actived_scripts_log" };
+		case SHOW_FPS:
+				return { "es-show_fps get fps_show" };
+		case OVERCLOCK:
+				return { "es-overclock_system get" };
+		default:
+				return { };
+	}
+}
+
+void ApiSystem::prefetchScriptOutputs(const std::vector<ScriptId>& scripts, Window* window, const std::function<void()>& func, void* data)
+{
+	std::vector<std::string> commands;
+	for (auto script : scripts)
+		if (isScriptingSupported(script))
+			for (auto command : getScriptGetters(script))
+				if (std::find(commands.cbegin(), commands.cend(), command) == commands.cend())
+					commands.push_back(command);
+
+	if (commands.empty())
+	{
+		func();
+		return;
+	}
+
+	// Filled on the UI thread by the callbacks, the last one builds the screen
+	auto outputs = std::make_shared<std::map<std::string, std::string>>();
+	size_t count = commands.size();
+
+	for (auto command : commands)
+	{
+		// Read-only : the getters run together, but after the setters already requested for the script
+		CommandExecutor::run(command, window, [this, command, outputs, count, func](const CommandResult& result)
+		{
+			(*outputs)[command] = result.output;
+			if (outputs->size() < count)
+				return;
+
+			{
+				std::unique_lock<std::mutex> lock(mScriptOutputsLock);
+				mScriptOutputs = *outputs;
+			}
+
+			func();
+
+			std::unique_lock<std::mutex> lock(mScriptOutputsLock);
+			mScriptOutputs.clear();
+		}, COMMAND_DEFAULT_TIMEOUT, data, getScriptSerial(command), true);
+	}
+}
+
+bool ApiSystem::getPrefetchedOutput(const std::string& command, std::string& output)
+{
+	std::unique_lock<std::mutex> lock(mScriptOutputsLock);
+
+	auto it = mScriptOutputs.find(command);
+	if (it == mScriptOutputs.cend())
+		return false;
+
+	output = it->second;
+	return true;
+}
+
+std::string ApiSystem::getScriptOutput(const std::string& command)
+{
+	std::string output;
+	if (getPrefetchedOutput(command, output))
+		return Utils::String::replace(output, "\n", ""); // Same as getShOutput
+
+	return getShOutput(command);
+}
+
 bool ApiSystem::isScriptingSupported(ScriptId script)
 {
 	std::vector<std::string> executables;
@@ -474,7 +586,7 @@ std::string ApiSystem::getIpAddress()
 {
 	LOG(LogDebug) << "ApiSystem::getIpAddress()";
 
-	std::string result = queryIPAddress(); // platform.h
+	std::string result = getNetworkInformation(true).ip_address;
 	if (result.empty())
 		return "___.___.___.___/__";
 
@@ -484,30 +596,56 @@ std::string ApiSystem::getIpAddress()
 float ApiSystem::getLoadCpu()
 {
 	LOG(LogDebug) << "ApiSystem::getLoadCpu()";
+
+	// The sampler reads /proc/stat, top would be forked otherwise
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr)
+		return metrics->cpuLoad;
+
 	return queryLoadCpu();
 }
 
 int ApiSystem::getFrequencyCpu()
 {
 	LOG(LogDebug) << "ApiSystem::getFrequencyCpu()";
+
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr)
+		return metrics->cpuFrequency;
+
 	return queryFrequencyCpu();
 }
 
 float ApiSystem::getTemperatureCpu()
 {
 	LOG(LogDebug) << "ApiSystem::getTemperatureCpu()";
+
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr)
+		return metrics->cpuTemperature;
+
 	return queryTemperatureCpu();
 }
 
 float ApiSystem::getTemperatureGpu()
 {
 	LOG(LogDebug) << "ApiSystem::getTemperatureGpu()";
+
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr)
+		return metrics->gpuTemperature;
+
 	return queryTemperatureGpu();
 }
 
 int ApiSystem::getFrequencyGpu()
 {
 	LOG(LogDebug) << "ApiSystem::getFrequencyGpu()";
+
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr)
+		return metrics->gpuFrequency;
+
 	return queryFrequencyGpu();
 }
 
@@ -517,10 +655,20 @@ bool ApiSystem::isNetworkConnected()
 	return queryNetworkConnected();
 }
 
+void ApiSystem::isNetworkConnectedAsync(Window* window, const std::function<void(bool)>& func)
+{
+	LOG(LogDebug) << "ApiSystem::isNetworkConnectedAsync()";
+	executeScriptAsync("es-wifi is_connected", window, func, NETWORK_STATUS_TIMEOUT);
+}
+
 NetworkInformation ApiSystem::getNetworkInformation(bool summary)
 {
 	LOG(LogDebug) << "ApiSystem::getNetworkInformation()";
 
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr && (summary || metrics->networkDetailed))
+		return metrics->network;
+
 	return queryNetworkInformation(summary); // platform.h
 }
 
@@ -528,6 +676,10 @@ BatteryInformation ApiSystem::getBatteryInformation(bool summary)
 {
 	LOG(LogDebug) << "ApiSystem::getBatteryInformation()";
 
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr)
+		return metrics->battery;
+
 	return queryBatteryInformation(summary); // platform.h
 }
 
@@ -535,6 +687,18 @@ CpuAndSocketInformation ApiSystem::getCpuAndChipsetInformation(bool summary)
 {
 	LOG(LogDebug) << "ApiSystem::getCpuAndChipsetInformation()";
 
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr)
+	{
+		if (!summary)
+			return metrics->chipset;
+
+		CpuAndSocketInformation chipset;
+		chipset.cpu_load = metrics->cpuLoad;
+		chipset.temperature = metrics->cpuTemperature;
+		return chipset;
+	}
+
 	return queryCpuAndChipsetInformation(summary); // platform.h
 }
 
@@ -542,6 +706,11 @@ RamMemoryInformation ApiSystem::getRamMemoryInformation(bool summary)
 {
 	LOG(LogDebug) << "ApiSystem::getRamMemoryInformation()";
 
+	// Read from /proc/meminfo by the sampler, top is forked up to 4 times otherwise
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr)
+		return metrics->memory;
+
 	return queryRamMemoryInformation(summary); // platform.h
 }
 
@@ -605,6 +774,10 @@ int ApiSystem::getBatteryLevel()
 {
 	LOG(LogDebug) << "ApiSystem::getBatteryLevel()";
 
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr)
+		return metrics->battery.level;
+
 	return queryBatteryLevel();
 }
 
@@ -612,6 +785,10 @@ bool ApiSystem::isBatteryCharging()
 {
 	LOG(LogDebug) << "ApiSystem::isBatteryCharging()";
 
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr)
+		return metrics->battery.hasBattery && metrics->battery.isCharging;
+
 	return queryBatteryCharging();
 }
 
@@ -619,6 +796,10 @@ float ApiSystem::getBatteryVoltage()
 {
 	LOG(LogDebug) << "ApiSystem::getBatteryVoltage()";
 
+	auto metrics = SystemMetrics::get();
+	if (metrics != nullptr)
+		return metrics->battery.voltage;
+
 	return queryBatteryVoltage();
 }
 
@@ -647,21 +828,25 @@ bool ApiSystem::setTimezone(std::string timezone)
 {
 	LOG(LogInfo) << "ApiSystem::setTimezone() - TZ: " << timezone;
 
-	return setCurrentTimezone(timezone);
+	if (timezone.empty())
+		return false;
+
+	CommandExecutor::runTask("setCurrentTimezone " + timezone, [timezone] { return setCurrentTimezone(timezone); }, "setCurrentTimezone");
+	return true;
 }
 
 bool ApiSystem::isPowerkeyState()
 {
 	LOG(LogInfo) << "ApiSystem::isPowerkeyState()";
 
-	return stringToState(getShOutput(R"(es-powerkey get two_push_shutdown)"));
+	return stringToState(getScriptOutput(R"(es-powerkey get two_push_shutdown)"));
 }
 
 int ApiSystem::getPowerkeyTimeInterval()
 {
 	LOG(LogInfo) << "ApiSystem::getPowerkeyTimeInterval()";
 	
-	std::string time_interval = Utils::String::replace(getShOutput(R"(es-powerkey get max_interval_time)"), "\n", "");
+	std::string time_interval = Utils::String::replace(getScriptOutput(R"(es-powerkey get max_interval_time)"), "\n", "");
 	if (time_interval.empty())
 		return 5;
 
@@ -678,7 +863,7 @@ std::string ApiSystem::getPowerkeyAction()
 {
 	LOG(LogInfo) << "ApiSystem::getPowerkeyAction()";
 
-	std::string action = Utils::String::replace(getShOutput(R"(es-powerkey get action)"), "\n", "");
+	std::string action = Utils::String::replace(getScriptOutput(R"(es-powerkey get action)"), "\n", "");
 	if (action.empty())
 		return "shutdown";
 
@@ -694,28 +879,30 @@ bool ApiSystem::setPowerkeyValues(const std::string action, bool two_push_state,
 	else if (time_interval > 10)
 		time_interval = 10;
 
-	return executeScript("es-powerkey set_all_values " + action + " " + stateToString(two_push_state) + " " + std::to_string(time_interval) + " &");
+	executeScriptAsync("es-powerkey set_all_values " + action + " " + stateToString(two_push_state) + " " + std::to_string(time_interval));
+	return true;
 }
 
 bool ApiSystem::setDisplayBlinkLowBattery(bool state)
 {
 	LOG(LogInfo) << "ApiSystem::setDisplayBlinkLowBattery()";
 
-	return executeScript("es-display set blink_low_battery " + stateToString(state) + " &");
+	executeScriptAsync("es-display set blink_low_battery " + stateToString(state));
+	return true;
 }
 
 bool ApiSystem::isSystemHotkeyBrightnessEvent()
 {
 	LOG(LogInfo) << "ApiSystem::isSystemHotkeyBrightnessEvent()";
 
-	return stringToState(getShOutput(R"(es-system_hotkey get brightness)"));
+	return stringToState(getScriptOutput(R"(es-system_hotkey get brightness)"));
 }
 
 int ApiSystem::getSystemHotkeyBrightnessStep()
 {
 	LOG(LogInfo) << "ApiSystem::isSystemHotkeyBrightnessStep()";
 
-	int brightness_step = std::atoi(getShOutput(R"(es-system_hotkey get brightness_step)").c_str());
+	int brightness_step = std::atoi(getScriptOutput(R"(es-system_hotkey get brightness_step)").c_str());
 	if (brightness_step <= 0)
 		return 1;
 	else if (brightness_step > 25)
@@ -728,14 +915,14 @@ bool ApiSystem::isSystemHotkeyVolumeEvent()
 {
 	LOG(LogInfo) << "ApiSystem::isSystemHotkeyVolumeEvent()";
 
-	return stringToState(getShOutput(R"(es-system_hotkey get volume)"));
+	return stringToState(getScriptOutput(R"(es-system_hotkey get volume)"));
 }
 
 int ApiSystem::getSystemHotkeyVolumeStep()
 {
 	LOG(LogInfo) << "ApiSystem::getSystemHotkeyVolumeStep()";
 
-	int volume_step = std::atoi(getShOutput(R"(es-system_hotkey get volume_step)").c_str());
+	int volume_step = std::atoi(getScriptOutput(R"(es-system_hotkey get volume_step)").c_str());
 	if (volume_step <= 0)
 		return 1;
 	else if (volume_step > 25)
@@ -748,21 +935,21 @@ bool ApiSystem::isSystemHotkeyWifiEvent()
 {
 	LOG(LogInfo) << "ApiSystem::isSystemHotkeyWifiEvent()";
 
-	return stringToState(getShOutput(R"(es-system_hotkey get wifi)"));
+	return stringToState(getScriptOutput(R"(es-system_hotkey get wifi)"));
 }
 
 bool ApiSystem::isSystemHotkeyPerformanceEvent()
 {
 	LOG(LogInfo) << "ApiSystem::isSystemHotkeyPerformanceEvent()";
 
-	return stringToState(getShOutput(R"(es-system_hotkey get performance)"));
+	return stringToState(getScriptOutput(R"(es-system_hotkey get performance)"));
 }
 
 bool ApiSystem::isSystemHotkeySuspendEvent()
 {
 	LOG(LogInfo) << "ApiSystem::isSystemHotkeySuspendEvent()";
 
-	return stringToState(getShOutput(R"(es-system_hotkey get suspend)"));
+	return stringToState(getScriptOutput(R"(es-system_hotkey get suspend)"));
 }
 
 bool ApiSystem::setSystemHotkeysValues(bool brightness_state, int brightness_step, bool volume_state, int volume_step, bool wifi_state, bool performance_state, bool suspend_state)
@@ -779,21 +966,22 @@ bool ApiSystem::setSystemHotkeysValues(bool brightness_state, int brightness_ste
 	else if (volume_step > 25)
 		volume_step = 25;
 
-	return executeScript("es-system_hotkey set_all_values " + stateToString(brightness_state) + " " + std::to_string(brightness_step) + " " + stateToString(volume_state) + " " + std::to_string(volume_step) + " " + stateToString(wifi_state) + " " + stateToString(performance_state) + " " + stateToString(suspend_state) + " &");
+	executeScriptAsync("es-system_hotkey set_all_values " + stateToString(brightness_state) + " " + std::to_string(brightness_step) + " " + stateToString(volume_state) + " " + std::to_string(volume_step) + " " + stateToString(wifi_state) + " " + stateToString(performance_state) + " " + stateToString(suspend_state));
+	return true;
 }
 
 bool ApiSystem::isDeviceAutoSuspendByTime()
 {
 	LOG(LogInfo) << "ApiSystem::isDeviceAutoSuspendByTime()";
 
-	return stringToState(getShOutput(R"(es-auto_suspend get auto_suspend_time)"));
+	return stringToState(getScriptOutput(R"(es-auto_suspend get auto_suspend_time)"));
 }
 
 int ApiSystem::getAutoSuspendTimeout()
 {
 	LOG(LogInfo) << "ApiSystem::getAutoSuspendTimeout()";
 
-	int timeout = std::atoi(getShOutput(R"(es-auto_suspend get auto_suspend_timeout)").c_str());
+	int timeout = std::atoi(getScriptOutput(R"(es-auto_suspend get auto_suspend_timeout)").c_str());
 	if (timeout <= 0)
 		return 5;
 	else if (timeout > 120)
@@ -806,14 +994,14 @@ bool ApiSystem::isDeviceAutoSuspendByBatteryLevel()
 {
 	LOG(LogInfo) << "ApiSystem::isDeviceAutoSuspendByBatteryLevel()";
 
-	return stringToState(getShOutput(R"(es-auto_suspend get auto_suspend_battery)"));
+	return stringToState(getScriptOutput(R"(es-auto_suspend get auto_suspend_battery)"));
 }
 
 int ApiSystem::getAutoSuspendBatteryLevel()
 {
 	LOG(LogInfo) << "ApiSystem::getAutoSuspendBatteryLevel()";
 
-	int battery_level = std::atoi(getShOutput(R"(es-auto_suspend get auto_suspend_battery_level)").c_str());
+	int battery_level = std::atoi(getScriptOutput(R"(es-auto_suspend get auto_suspend_battery_level)").c_str());
 	if (battery_level <= 0)
 		return 10;
 	else if (battery_level > 100)
@@ -833,7 +1021,7 @@ bool ApiSystem::isDeviceAutoSuspendStayAwakeCharging()
 {
 	LOG(LogInfo) << "ApiSystem::isDeviceAutoSuspendStayAwakeCharging()";
 
-	return stringToState(getShOutput(R"(es-auto_suspend get auto_suspend_stay_awake_while_charging)"));
+	return stringToState(getScriptOutput(R"(es-auto_suspend get auto_suspend_stay_awake_while_charging)"));
 }
 
 bool ApiSystem::setDeviceAutoSuspendValues(bool stay_awake_charging_state, bool time_state, int timeout, bool battery_state, int battery_level)
@@ -850,7 +1038,8 @@ bool ApiSystem::setDeviceAutoSuspendValues(bool stay_awake_charging_state, bool
 	else if (battery_level > 100)
 		battery_level = 100;
 
-	return executeScript("es-auto_suspend set_all_values " + stateToString(stay_awake_charging_state) + " " + stateToString(time_state) + " " + std::to_string(timeout) + " " + stateToString(battery_state) + " " + std::to_string(battery_level) + " &");
+	executeScriptAsync("es-auto_suspend set_all_values " + stateToString(stay_awake_charging_state) + " " + stateToString(time_state) + " " + std::to_string(timeout) + " " + stateToString(battery_state) + " " + std::to_string(battery_level));
+	return true;
 
 }
 
@@ -858,21 +1047,21 @@ bool ApiSystem::isDisplayAutoDimStayAwakeCharging()
 {
 	LOG(LogInfo) << "ApiSystem::isDisplayAutoDimStayAwakeCharging()";
 
-	return stringToState(getShOutput(R"(es-display get auto_dim_stay_awake_while_charging)"));
+	return stringToState(getScriptOutput(R"(es-display get auto_dim_stay_awake_while_charging)"));
 }
 
 bool ApiSystem::isDisplayAutoDimByTime()
 {
 	LOG(LogInfo) << "ApiSystem::isDisplayAutoDimByTime()";
 
-	return stringToState(getShOutput(R"(es-display get auto_dim_time)"));
+	return stringToState(getScriptOutput(R"(es-display get auto_dim_time)"));
 }
 
 int ApiSystem::getDisplayAutoDimTimeout()
 {
 	LOG(LogInfo) << "ApiSystem::getDisplayAutoDimTimeout()";
 
-	int timeout = std::atoi(getShOutput(R"(es-display get auto_dim_timeout)").c_str());
+	int timeout = std::atoi(getScriptOutput(R"(es-display get auto_dim_timeout)").c_str());
 	if (timeout <= 0)
 		return 5;
 	else if (timeout > 120)
@@ -885,7 +1074,7 @@ int ApiSystem::getDisplayAutoDimBrightness()
 {
 	LOG(LogInfo) << "ApiSystem::getDisplayAutoDimBrightness()";
 
-	int brightness_level = std::atoi(getShOutput(R"(es-display get auto_dim_brightness)").c_str());
+	int brightness_level = std::atoi(getScriptOutput(R"(es-display get auto_dim_brightness)").c_str());
 	if (brightness_level <= 0)
 		return 25;
 	else if (brightness_level > 100)
@@ -908,7 +1097,8 @@ bool ApiSystem::setDisplayAutoDimValues(bool stay_awake_charging_state, bool tim
 	else if (brightness_level > 100)
 		brightness_level = 100;
 
-	return executeScript("es-display set_auto_dim_all_values " + stateToString(stay_awake_charging_state) + " " + stateToString(time_state) + " " + std::to_string(timeout) + " " + std::to_string(brightness_level) + " &");
+	executeScriptAsync("es-display set_auto_dim_all_values " + stateToString(stay_awake_charging_state) + " " + stateToString(time_state) + " " + std::to_string(timeout) + " " + std::to_string(brightness_level));
+	return true;
 }
 
 bool ApiSystem::ping()
@@ -919,15 +1109,28 @@ bool ApiSystem::ping()
 	return true;
 }
 
-bool ApiSystem::getInternetStatus()
+bool ApiSystem::checkInternetStatus()
 {
-	LOG(LogInfo) << "ApiSystem::getInternetStatus()";
 	if (ping())
 		return true;
 
 	return executeScript("es-wifi internet_status");
 }
 
+bool ApiSystem::getInternetStatus()
+{
+	LOG(LogInfo) << "ApiSystem::getInternetStatus()";
+
+	// Shares the result of a check already started by getInternetStatusAsync
+	return CommandExecutor::runTask(INTERNET_STATUS_TASK, [this] { return checkInternetStatus(); }).get().succeeded();
+}
+
+void ApiSystem::getInternetStatusAsync(Window* window, const std::function<void(bool)>& func)
+{
+	LOG(LogInfo) << "ApiSystem::getInternetStatusAsync()";
+	CommandExecutor::runTask(INTERNET_STATUS_TASK, [this] { return checkInternetStatus(); }, window, [func](const CommandResult& result) { func(result.succeeded()); });
+}
+
 std::vector<std::string> ApiSystem::getWifiNetworks(bool scan)
 {
 	LOG(LogInfo) << "ApiSystem::getWifiNetworks()";
@@ -1058,42 +1261,42 @@ bool ApiSystem::getRetroachievementsEnabled()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsEnabled()";
 
-	return Utils::String::toBool(getShOutput(R"(es-cheevos get cheevos_enable)"));
+	return Utils::String::toBool(getScriptOutput(R"(es-cheevos get cheevos_enable)"));
 }
 
 bool ApiSystem::getRetroachievementsHardcoreEnabled()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsHardcoreEnabled()";
 
-	return Utils::String::toBool(getShOutput(R"(es-cheevos get cheevos_hardcore_mode_enable)"));
+	return Utils::String::toBool(getScriptOutput(R"(es-cheevos get cheevos_hardcore_mode_enable)"));
 }
 
 bool ApiSystem::getRetroachievementsLeaderboardsEnabled()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsLeaderboardsEnabled()";
 
-	return Utils::String::toBool(getShOutput(R"(es-cheevos get cheevos_leaderboards_enable)"));
+	return Utils::String::toBool(getScriptOutput(R"(es-cheevos get cheevos_leaderboards_enable)"));
 }
 
 bool ApiSystem::getRetroachievementsVerboseEnabled()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsVerboseEnabled()";
 
-	return Utils::String::toBool(getShOutput(R"(es-cheevos get cheevos_verbose_enable)"));
+	return Utils::String::toBool(getScriptOutput(R"(es-cheevos get cheevos_verbose_enable)"));
 }
 
 bool ApiSystem::getRetroachievementsAutomaticScreenshotEnabled()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsAutomaticScreenshotEnabled()";
 
-	return Utils::String::toBool(getShOutput(R"(es-cheevos get cheevos_auto_screenshot)"));
+	return Utils::String::toBool(getScriptOutput(R"(es-cheevos get cheevos_auto_screenshot)"));
 }
 
 bool ApiSystem::getRetroachievementsUnlockSoundEnabled()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsUnlockSoundEnabled()";
 
-	return Utils::String::toBool(getShOutput(R"(es-cheevos get cheevos_unlock_sound_enable)"));
+	return Utils::String::toBool(getScriptOutput(R"(es-cheevos get cheevos_unlock_sound_enable)"));
 }
 
 std::vector<std::string> ApiSystem::getRetroachievementsSoundsList()
@@ -1104,7 +1307,9 @@ std::vector<std::string> ApiSystem::getRetroachievementsSoundsList()
 
 	LOG(LogDebug) << "ApiSystem::getRetroAchievementsSoundsList";
 
-	std::vector<std::string> folderList = executeEnumerationScript(R"(es-cheevos get cheevos_sound_folders)");
+	std::string folders;
+	std::vector<std::string> folderList = getPrefetchedOutput(R"(es-cheevos get cheevos_sound_folders)", folders) ?
+		Utils::String::split(folders, '\n', true) : executeEnumerationScript(R"(es-cheevos get cheevos_sound_folders)");
 
 	if (folderList.empty()) {
 		folderList = {
@@ -1134,49 +1339,49 @@ std::string ApiSystem::getRetroachievementsUsername()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsUsername()";
 
-	return getShOutput(R"(es-cheevos get cheevos_username)");
+	return getScriptOutput(R"(es-cheevos get cheevos_username)");
 }
 
 bool ApiSystem::getRetroachievementsChallengeIndicators()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsChallengeIndicators()";
 
-	return Utils::String::toBool( getShOutput(R"(es-cheevos get cheevos_challenge_indicators)") );
+	return Utils::String::toBool( getScriptOutput(R"(es-cheevos get cheevos_challenge_indicators)") );
 }
 
 bool ApiSystem::getRetroachievementsRichpresenceEnable()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsRichpresenceEnable()";
 
-	return Utils::String::toBool( getShOutput(R"(es-cheevos get cheevos_richpresence_enable)") );
+	return Utils::String::toBool( getScriptOutput(R"(es-cheevos get cheevos_richpresence_enable)") );
 }
 
 bool ApiSystem::getRetroachievementsBadgesEnable()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsBadgesEnable()";
 
-	return Utils::String::toBool( getShOutput(R"(es-cheevos get cheevos_badges_enable)") );
+	return Utils::String::toBool( getScriptOutput(R"(es-cheevos get cheevos_badges_enable)") );
 }
 
 bool ApiSystem::getRetroachievementsTestUnofficial()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsTestUnofficial()";
 
-	return Utils::String::toBool( getShOutput(R"(es-cheevos get cheevos_test_unofficial)") );
+	return Utils::String::toBool( getScriptOutput(R"(es-cheevos get cheevos_test_unofficial)") );
 }
 
 bool ApiSystem::getRetroachievementsStartActive()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsStartActive()";
 
-	return Utils::String::toBool( getShOutput(R"(es-cheevos get cheevos_start_active)") );
+	return Utils::String::toBool( getScriptOutput(R"(es-cheevos get cheevos_start_active)") );
 }
 
 std::string ApiSystem::getRetroachievementsPassword()
 {
 	LOG(LogInfo) << "ApiSystem::getRetroachievementsPassword()";
 
-	return getShOutput(R"(es-cheevos get cheevos_password)");
+	return getScriptOutput(R"(es-cheevos get cheevos_password)");
 }
 
 bool  ApiSystem::setRetroachievementsValues(bool retroachievements_state, bool hardcore_state, bool leaderboards_state, bool verbose_state, bool automatic_screenshot_state, bool challenge_indicators_state, bool richpresence_state, bool badges_state, bool test_unofficial_state, bool start_active_state, const std::string sound, const std::string username, const std::string password)
@@ -1197,7 +1402,7 @@ bool ApiSystem::isEsScriptsLoggingActivated()
 {
 	LOG(LogInfo) << "ApiSystem::isEsScriptsLoggingActivated()";
 
-	return Utils::String::toBool( getShOutput(R"(es-log_scripts is_actived_scripts_log)") );
+	return Utils::String::toBool( getScriptOutput(R"(es-log_scripts is_actived_scripts_log)") );
 }
 
 bool ApiSystem::setEsScriptsLoggingActivated(bool state, const std::string level)
@@ -1225,7 +1430,7 @@ bool ApiSystem::isShowRetroarchFps()
 {
 	LOG(LogInfo) << "ApiSystem::isShowRetroarchFps()";
 
-	return Utils::String::toBool( getShOutput(R"(es-show_fps get fps_show)") );
+	return Utils::String::toBool( getScriptOutput(R"(es-show_fps get fps_show)") );
 }
 
 bool ApiSystem::setOverclockSystem(bool state)
@@ -1239,7 +1444,7 @@ bool ApiSystem::isOverclockSystem()
 {
 	LOG(LogInfo) << "ApiSystem::isOverclockSystem()";
 
-	return Utils::String::toBool( getShOutput(R"(es-overclock_system get)") );
+	return Utils::String::toBool( getScriptOutput(R"(es-overclock_system get)") );
 }
 
 
@@ -3,8 +3,11 @@
 
 #include <string>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <vector>
 #include "platform.h"
+#include "CommandExecutor.h"
 
 class Window;
 
@@ -33,6 +36,14 @@ protected:
 	virtual bool executeScript(const std::string command);
 	virtual std::pair<std::string, int> executeScript(const std::string command, const std::function<void(const std::string)>& func);
 	virtual std::vector<std::string> executeEnumerationScript(const std::string command);
+	// Runs on the CommandExecutor after the previous commands of the same script, func gets the success of the command on the UI thread. Without window or func, the result is ignored
+	virtual void executeScriptAsync(const std::string command, Window* window = nullptr, const std::function<void(bool)>& func = nullptr, int timeout = COMMAND_DEFAULT_TIMEOUT);
+	// CommandExecutor serial of a command : the script it calls
+	static std::string getScriptSerial(const std::string& command);
+
+	// Output of a getter, taken from prefetchScriptOutputs when it's running, else read now
+	bool getPrefetchedOutput(const std::string& command, std::string& output);
+	std::string getScriptOutput(const std::string& command);
 
 	static ApiSystem* instance;
 
@@ -113,6 +124,7 @@ public:
 	float getTemperatureGpu();
 	int getFrequencyGpu();
 	bool isNetworkConnected();
+	void isNetworkConnectedAsync(Window* window, const std::function<void(bool)>& func);
 	int getBatteryLevel();
 	bool isBatteryCharging();
 	float getBatteryVoltage();
@@ -168,7 +180,10 @@ public:
 	bool setDisplayAutoDimValues(bool stay_awake_charging_state, bool time_state, int timeout, int brightness_level);
 
 	virtual bool ping();
+	// ping() then the es-wifi check. Blocking, see getInternetStatusAsync
+	bool checkInternetStatus();
 	bool getInternetStatus();
+	void getInternetStatusAsync(Window* window, const std::function<void(bool)>& func);
 	std::vector<std::string> getWifiNetworks(bool scan = false);
 	bool connectWifi(const std::string ssid, const std::string pwd);
 	bool disconnectWifi(const std::string ssid);
@@ -242,6 +257,16 @@ public:
 	RemoteServiceInformation getRemoteServiceStatus(RemoteServicesId id);
 	bool configRemoteService(RemoteServiceInformation service);
 
+	// Reads the getters of the scripts together on the CommandExecutor, then calls func on the UI thread.
+	// While func runs, the getters return these values, so that a screen can build its rows without waiting for the scripts.
+	// data is the container given to Window::postToUiThread
+	void prefetchScriptOutputs(const std::vector<ScriptId>& scripts, Window* window, const std::function<void()>& func, void* data = nullptr);
+
+private:
+	static std::vector<std::string> getScriptGetters(ScriptId script);
+
+	std::mutex mScriptOutputsLock;
+	std::map<std::string, std::string> mScriptOutputs;
 };
 
 #endif
@@ -517,9 +517,7 @@ void CollectionSystemManager::sortLastPlayed(SystemData* system)
 	const FileSorts::SortType& sort = FileSorts::getSortTypes().at(system->getSortId());
 
 	std::vector<FileData*>& childs = (std::vector<FileData*>&) rootFolder->getChildren();
-	std::sort(childs.begin(), childs.end(), sort.comparisonFunction);
-	if (!sort.ascending)
-		std::reverse(childs.begin(), childs.end());
+	FileSorts::sortFiles(childs, sort);
 }
 
 void CollectionSystemManager::trimCollectionCount(FolderData* rootFolder, int limit)
@@ -13,18 +13,29 @@
 #include "platform.h"
 #include "Scripting.h"
 #include "SystemData.h"
+#include "ThumbnailPregenerator.h"
+#include "SystemMetrics.h"
 #include "VolumeControl.h"
 #include "Window.h"
 #include "views/UIModeController.h"
 #include <assert.h>
+#include <climits>
+#include <ctype.h>
 #include "Gamelist.h"
 #include "MetaData.h"
 #include <fstream>
 #include "guis/GuiMsgBox.h"
 
+// Read for every item of the lists
+static BoolSetting sShowFilenames("ShowFilenames");
+static BoolSetting sLocalArt("LocalArt");
+static BoolSetting sCollectionShowSystemInfo("CollectionShowSystemInfo");
+static BoolSetting sShowHiddenFiles("ShowHiddenFiles");
+static BoolSetting sForceDisableFilters("ForceDisableFilters");
+
 
 FileData::FileData(FileType type, const std::string& path, SystemData* system)
-	: mType(type), mSystem(system), mParent(NULL), mMetadata(type == GAME ? GAME_METADATA : FOLDER_METADATA) // metadata is REALLY set in the constructor!
+	: mType(type), mSystem(system), mParent(NULL), mMetadata(type == GAME ? GAME_METADATA : FOLDER_METADATA), mSortKeys(nullptr) // metadata is REALLY set in the constructor!
 {
 	mPath = Utils::FileSystem::createRelativePath(path, getSystemEnvData()->mStartPath, false);
 	
@@ -88,7 +99,7 @@ const std::string FileData::getThumbnailPath()
 		thumbnail = getMetadata(MetaDataId::Image);
 		
 		// no image, try to use local image
-		if(thumbnail.empty() && Settings::getInstance()->getBool("LocalArt"))
+		if(thumbnail.empty() && sLocalArt)
 		{
 			const char* extList[2] = { ".png", ".jpg" };
 			for(int i = 0; i < 2; i++)
@@ -96,7 +107,7 @@ const std::string FileData::getThumbnailPath()
 				if(thumbnail.empty())
 				{
 					std::string path = getSystemEnvData()->mStartPath + "/images/" + getDisplayName() + "-thumb" + extList[i];
-					if (Utils::FileSystem::exists(path))
+					if (mSystem->hasLocalMedia(path))
 					{
 						setMetadata(MetaDataId::Thumbnail, path);
 						thumbnail = path;
@@ -109,7 +120,7 @@ const std::string FileData::getThumbnailPath()
 			thumbnail = getMetadata(MetaDataId::Image);
 
 		// no image, try to use local image
-		if (thumbnail.empty() && Settings::getInstance()->getBool("LocalArt"))
+		if (thumbnail.empty() && sLocalArt)
 		{
 			const char* extList[2] = { ".png", ".jpg" };
 			for (int i = 0; i < 2; i++)
@@ -117,10 +128,10 @@ const std::string FileData::getThumbnailPath()
 				if (thumbnail.empty())
 				{
 					std::string path = getSystemEnvData()->mStartPath + "/images/" + getDisplayName() + "-image" + extList[i];					
-					if (!Utils::FileSystem::exists(path))
+					if (!mSystem->hasLocalMedia(path))
 						path = getSystemEnvData()->mStartPath + "/images/" + getDisplayName() + extList[i];
 
-					if (Utils::FileSystem::exists(path))
+					if (mSystem->hasLocalMedia(path))
 						thumbnail = path;
 				}
 			}
@@ -132,36 +143,63 @@ const std::string FileData::getThumbnailPath()
 
 const bool FileData::getFavorite()
 {
-	auto data = getMetadata(MetaDataId::Favorite);
-	return !data.empty() && data == "true";
+	return getMetadata().getRef(MetaDataId::Favorite) == "true";
 }
 
 const bool FileData::getHidden()
 {
-	auto data = getMetadata(MetaDataId::Hidden);
-	return !data.empty() && data == "true";
+	return getMetadata().getRef(MetaDataId::Hidden) == "true";
 }
 
 const bool FileData::getKidGame()
 {
-	auto data = getMetadata(MetaDataId::KidGame);
-	return !data.empty() && data == "true";
+	return getMetadata().getRef(MetaDataId::KidGame) == "true";
 }
 
-static std::shared_ptr<bool> showFilenames;
-
 void FileData::resetSettings()
 {
-	showFilenames = nullptr;
+	FileSorts::invalidateSortKeys();
 }
 
-const std::string FileData::getName()
+std::shared_ptr<const FileSortKeys> FileData::getSortKeys() const
 {
-	if (showFilenames == nullptr)
-		showFilenames = std::make_shared<bool>(Settings::getInstance()->getBool("ShowFilenames"));
+	const MetaDataList& metadata = getMetadata();
+	unsigned int generation = FileSorts::getSortKeysGeneration();
+
+	// The loading threads sort too : keys being compared elsewhere must not change under the comparison
+	auto keys = std::atomic_load(&mSortKeys);
+	if (keys != nullptr && keys->revision == metadata.getRevision() && keys->generation == generation)
+		return keys;
+
+	auto ret = std::make_shared<FileSortKeys>();
+
+	FileData* file = const_cast<FileData*>(this);
+
+	ret->revision = metadata.getRevision();
+	ret->generation = generation;
+	ret->name = FileSorts::getSortName(file->getName());
+	ret->systemName = Utils::String::toUpper(file->getSourceFileData()->getSystemName());
+	ret->rating = metadata.getFloat(MetaDataId::Rating);
+	ret->playCount = metadata.getInt(MetaDataId::PlayCount);
+	ret->gameTime = metadata.getInt(MetaDataId::GameTime);
+	ret->players = metadata.getInt(MetaDataId::Players);
+
+	// Keep the ordering of the former string comparison : empty dates first, invalid ones last
+	const std::string& releaseDate = metadata.getRef(MetaDataId::ReleaseDate);
+	if (releaseDate.empty())
+		ret->releaseYear = -1;
+	else if (releaseDate.size() >= 4 && isdigit(releaseDate[0]) && isdigit(releaseDate[1]) && isdigit(releaseDate[2]) && isdigit(releaseDate[3]))
+		ret->releaseYear = atoi(releaseDate.substr(0, 4).c_str());
+	else
+		ret->releaseYear = INT_MAX;
 
-	// Faster than accessing map each time
-	if (*showFilenames)
+	std::atomic_store(&mSortKeys, std::shared_ptr<const FileSortKeys>(ret));
+	return ret;
+}
+
+const std::string FileData::getName()
+{
+	if (sShowFilenames)
 	{
 		if (mSystem != nullptr && !mSystem->hasPlatformId(PlatformIds::ARCADE) && !mSystem->hasPlatformId(PlatformIds::NEOGEO))
 			return Utils::FileSystem::getStem(getPath());
@@ -187,10 +225,10 @@ const std::string FileData::getVideoPath()
 	std::string video = getMetadata(MetaDataId::Video);
 	
 	// no video, try to use local video
-	if(video.empty() && Settings::getInstance()->getBool("LocalArt"))
+	if(video.empty() && sLocalArt)
 	{
 		std::string path = getSystemEnvData()->mStartPath + "/images/" + getDisplayName() + "-video.mp4";
-		if (Utils::FileSystem::exists(path))
+		if (mSystem->hasLocalMedia(path))
 		{
 			setMetadata(MetaDataId::Video, path);
 			video = path;
@@ -205,7 +243,7 @@ const std::string FileData::getMarqueePath()
 	std::string marquee = getMetadata(MetaDataId::Marquee);
 
 	// no marquee, try to use local marquee
-	if (marquee.empty() && Settings::getInstance()->getBool("LocalArt"))
+	if (marquee.empty() && sLocalArt)
 	{
 		const char* extList[2] = { ".png", ".jpg" };
 		for(int i = 0; i < 2; i++)
@@ -213,7 +251,7 @@ const std::string FileData::getMarqueePath()
 			if(marquee.empty())
 			{
 				std::string path = getSystemEnvData()->mStartPath + "/images/" + getDisplayName() + "-marquee" + extList[i];
-				if(Utils::FileSystem::exists(path))
+				if(mSystem->hasLocalMedia(path))
 				{
 					setMetadata(MetaDataId::Marquee, path);
 					marquee = path;
@@ -242,7 +280,7 @@ const std::string FileData::getImagePath()
 			if(image.empty())
 			{
 				std::string path = getSystemEnvData()->mStartPath + "/images/" + getDisplayName() + "-image" + extList[i];
-				if(Utils::FileSystem::exists(path))
+				if(mSystem->hasLocalMedia(path))
 				{
 						setMetadata(MetaDataId::Image, path);
 						image = path;
@@ -335,6 +373,8 @@ void FileData::launchGame(Window* window)
 	AudioManager::getInstance()->deinit();
 	VolumeControl::getInstance()->deinit();
 	InputManager::getInstance()->deinit();
+	ThumbnailPregenerator::pause();
+	SystemMetrics::pause();
 
 	bool hideWindow = Settings::getInstance()->getBool("HideWindow");
 	window->deinit(hideWindow);
@@ -390,6 +430,8 @@ void FileData::launchGame(Window* window)
 	InputManager::getInstance()->init();
 	VolumeControl::getInstance()->init();
 	AudioManager::getInstance()->init();
+	ThumbnailPregenerator::resume();
+	SystemMetrics::resume();
 	window->normalizeNextUpdate();
 
 	//update number of times the game has been launched
@@ -478,7 +520,7 @@ const std::string CollectionFileData::getName()
 		mDirty = false;
 	}
 
-	if (Settings::getInstance()->getBool("CollectionShowSystemInfo"))
+	if (sCollectionShowSystemInfo)
 		return mCollectionFileName;
 		
 	return Utils::String::removeParenthesis(mSourceFileData->getMetadata(MetaDataId::Name));
@@ -490,10 +532,10 @@ const std::vector<FileData*> FolderData::getChildrenListToDisplay()
 
 	std::string showFoldersMode = Settings::getInstance()->getString("FolderViewMode");
 	
-	bool showHiddenFiles = Settings::getInstance()->getBool("ShowHiddenFiles");
+	bool showHiddenFiles = sShowHiddenFiles;
 	bool filterKidGame = false;
 
-	if (!Settings::getInstance()->getBool("ForceDisableFilters")) 
+	if (!sForceDisableFilters) 
 	{
 		if (UIModeController::getInstance()->isUIModeKiosk())
 			showHiddenFiles = false;
@@ -558,11 +600,7 @@ const std::vector<FileData*> FolderData::getChildrenListToDisplay()
 	if (currentSortId >= FileSorts::getSortTypes().size())
 		currentSortId = 0;
 
-	const FileSorts::SortType& sort = FileSorts::getSortTypes().at(currentSortId);
-	std::sort(ret.begin(), ret.end(), sort.comparisonFunction);
-
-	if (!sort.ascending)
-		std::reverse(ret.begin(), ret.end());
+	FileSorts::sortFiles(ret, FileSorts::getSortTypes().at(currentSortId));
 
 	return ret;
 }
@@ -588,12 +626,7 @@ std::vector<FileData*> FolderData::getFlatGameList(bool displayedOnly, SystemDat
 	if (currentSortId < 0 || currentSortId >= FileSorts::getSortTypes().size())
 		currentSortId = 0;
 
-	auto sort = FileSorts::getSortTypes().at(currentSortId);
-
-	std::stable_sort(ret.begin(), ret.end(), sort.comparisonFunction);
-
-	if (!sort.ascending)
-		std::reverse(ret.begin(), ret.end());
+	FileSorts::sortFiles(ret, FileSorts::getSortTypes().at(currentSortId), true);
 
 	return ret;
 }
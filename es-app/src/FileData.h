@@ -4,6 +4,7 @@
 
 #include "utils/FileSystemUtil.h"
 #include "MetaData.h"
+#include <memory>
 #include <unordered_map>
 #include <set>
 
@@ -28,6 +29,21 @@ enum FileChangeType
 
 class FolderData;
 
+// Values compared by FileSorts, computed once and refreshed when the metadata or the sort settings change.
+struct FileSortKeys
+{
+	unsigned int revision;
+	unsigned int generation;
+
+	std::string name; // upper-cased, without leading article when IgnoreLeadingArticles is set
+	std::string systemName; // upper-cased name of the source system
+	int releaseYear;
+	float rating;
+	int playCount;
+	int gameTime;
+	int players;
+};
+
 // A tree node that holds information for a file.
 class FileData
 {
@@ -95,10 +111,14 @@ public:
 	bool hasContentFiles();
 	std::set<std::string> getContentFiles();
 
+	// Safe on any thread : a published record is never modified, a stale one is replaced
+	std::shared_ptr<const FileSortKeys> getSortKeys() const;
+
 private:
 	std::string getMessageFromExitCode(int exitCode);
 
 	MetaDataList mMetadata;
+	mutable std::shared_ptr<const FileSortKeys> mSortKeys; // atomic_load / atomic_store only
 
 protected:
 	FolderData* mParent;
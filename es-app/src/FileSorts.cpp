@@ -3,9 +3,15 @@
 #include "EsLocale.h"
 #include "Settings.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 namespace FileSorts
 {
 	static Singleton* sInstance = nullptr;
+	static std::atomic<unsigned int> sSortKeysGeneration(1);
+	static std::mutex sArticlesLock; // Sort keys are built on the loading threads, the settings change on the UI thread
 
 	Singleton* getInstance()
 	{
@@ -21,6 +27,37 @@ namespace FileSorts
 			delete sInstance;
 
 		sInstance = nullptr;
+		sSortKeysGeneration++;
+	}
+
+	unsigned int getSortKeysGeneration()
+	{
+		return sSortKeysGeneration;
+	}
+
+	void invalidateSortKeys()
+	{
+		Singleton* instance = getInstance();
+		std::vector<std::string> articles = Utils::String::commaStringToVector(_("A,AN,THE"));
+
+		{
+			std::unique_lock<std::mutex> lock(sArticlesLock);
+			instance->mIgnoreLeadingArticles = Settings::getInstance()->getBool("IgnoreLeadingArticles");
+			instance->mLeadingArticles = articles;
+		}
+
+		sSortKeysGeneration++;
+	}
+
+	std::string getSortName(const std::string& name)
+	{
+		Singleton* instance = getInstance();
+
+		std::unique_lock<std::mutex> lock(sArticlesLock);
+		if (instance->mIgnoreLeadingArticles)
+			return Utils::String::toUpper(stripLeadingArticle(name, instance->mLeadingArticles));
+
+		return Utils::String::toUpper(name);
 	}
 
 	const std::vector<SortType>& getSortTypes()
@@ -28,6 +65,34 @@ namespace FileSorts
 		return getInstance()->mSortTypes;
 	}
 
+	void sortFiles(std::vector<FileData*>& files, const SortType& sort, bool stable)
+	{
+		// Keys are resolved once, the comparisons only read plain fields.
+		// The shared pointers keep them alive if another thread replaces them meanwhile
+		std::vector<std::shared_ptr<const FileSortKeys>> keys;
+		keys.reserve(files.size());
+
+		std::vector<SortEntry> entries;
+		entries.reserve(files.size());
+
+		for (auto file : files)
+		{
+			keys.push_back(file->getSortKeys());
+			entries.push_back(SortEntry(keys.back().get(), file));
+		}
+
+		if (stable)
+			std::stable_sort(entries.begin(), entries.end(), sort.comparisonFunction);
+		else
+			std::sort(entries.begin(), entries.end(), sort.comparisonFunction);
+
+		for (size_t i = 0; i < entries.size(); i++)
+			files[i] = entries[i].file;
+
+		if (!sort.ascending)
+			std::reverse(files.begin(), files.end());
+	}
+
 	SortType getSortType(int sortId)
 	{
 		for (auto sort : getSortTypes())
@@ -39,6 +104,9 @@ namespace FileSorts
 
 	Singleton::Singleton()
 	{
+		mIgnoreLeadingArticles = Settings::getInstance()->getBool("IgnoreLeadingArticles");
+		mLeadingArticles = Utils::String::commaStringToVector(_("A,AN,THE"));
+
 		mSortTypes.push_back(SortType(FILENAME_ASCENDING, &compareName, true, _("FILENAME, ASCENDING"), _U("\uF15D ")));
 		mSortTypes.push_back(SortType(FILENAME_DESCENDING, &compareName, false, _("FILENAME, DESCENDING"), _U("\uF15E ")));
 		mSortTypes.push_back(SortType(RATING_ASCENDING, &compareRating, true, _("RATING, ASCENDING"), _U("\uF165 ")));
@@ -71,23 +139,14 @@ namespace FileSorts
 	}
 
 	//returns if file1 should come before file2
-	bool compareName(const FileData* file1, const FileData* file2)
+	bool compareName(const SortEntry& file1, const SortEntry& file2)
 	{
-		if (file1->getType() != file2->getType())
+		if (file1.file->getType() != file2.file->getType())
 		{
-			return file1->getType() == FOLDER;
+			return file1.file->getType() == FOLDER;
 		}
 		// we compare the actual metadata name, as collection files have the system appended which messes up the order
-		auto name1 = ((FileData *) file1)->getName();
-		auto name2 = ((FileData *) file2)->getName();
-		const bool ignoreArticles = Settings::getInstance()->getBool("IgnoreLeadingArticles");
-		if (ignoreArticles)
-		{
-			const auto articles = Utils::String::commaStringToVector(_("A,AN,THE"));
-			name1 = stripLeadingArticle(name1, articles);
-			name2 = stripLeadingArticle(name2, articles);
-		}
-		return Utils::String::compareIgnoreCase(name1, name2) < 0;
+		return file1.keys->name < file2.keys->name;
 	}
 
 	std::string stripLeadingArticle(const std::string &string, const std::vector<std::string> &articles)
@@ -109,118 +168,110 @@ namespace FileSorts
 		return string;
 	}
 
-	bool compareRating(const FileData* file1, const FileData* file2)
+	bool compareRating(const SortEntry& file1, const SortEntry& file2)
 	{
-		return file1->getMetadata().getFloat(MetaDataId::Rating) < file2->getMetadata().getFloat(MetaDataId::Rating);
+		return file1.keys->rating < file2.keys->rating;
 	}
 
-	bool compareTimesPlayed(const FileData* file1, const FileData* file2)
+	bool compareTimesPlayed(const SortEntry& file1, const SortEntry& file2)
 	{
 		//only games have playcount metadata
-		if (file1->getMetadata().getType() == GAME_METADATA && file2->getMetadata().getType() == GAME_METADATA)
-			return (file1)->getMetadata().getInt(MetaDataId::PlayCount) < (file2)->getMetadata().getInt(MetaDataId::PlayCount);
+		if (file1.file->getMetadata().getType() == GAME_METADATA && file2.file->getMetadata().getType() == GAME_METADATA)
+			return file1.keys->playCount < file2.keys->playCount;
 
 		return false;
 	}
 
-	bool compareGameTime(const FileData* file1, const FileData* file2)
+	bool compareGameTime(const SortEntry& file1, const SortEntry& file2)
 	{
 		//only games have playcount metadata
-		if (file1->getMetadata().getType() == GAME_METADATA && file2->getMetadata().getType() == GAME_METADATA)
-			return (file1)->getMetadata().getInt(MetaDataId::GameTime) < (file2)->getMetadata().getInt(MetaDataId::GameTime);
+		if (file1.file->getMetadata().getType() == GAME_METADATA && file2.file->getMetadata().getType() == GAME_METADATA)
+			return file1.keys->gameTime < file2.keys->gameTime;
 
 		return false;
 	}
 
-	bool compareLastPlayed(const FileData* file1, const FileData* file2)
+	bool compareLastPlayed(const SortEntry& file1, const SortEntry& file2)
 	{
 		// since it's stored as an ISO string (YYYYMMDDTHHMMSS), we can compare as a string
 		// as it's a lot faster than the time casts and then time comparisons
-		return (file1)->getMetadata().get(MetaDataId::LastPlayed) < (file2)->getMetadata().get(MetaDataId::LastPlayed);
+		return file1.file->getMetadata().getRef(MetaDataId::LastPlayed) < file2.file->getMetadata().getRef(MetaDataId::LastPlayed);
 	}
 
-	bool compareNumPlayers(const FileData* file1, const FileData* file2)
+	bool compareNumPlayers(const SortEntry& file1, const SortEntry& file2)
 	{
-		return (file1)->getMetadata().getInt(MetaDataId::Players) < (file2)->getMetadata().getInt(MetaDataId::Players);
+		return file1.keys->players < file2.keys->players;
 	}
 
-	bool compareSystemReleaseYear(const FileData* file1, const FileData* file2)
+	bool compareSystemReleaseYear(const SortEntry& file1, const SortEntry& file2)
 	{
-		std::string system1 = ((FileData*)file1)->getSourceFileData()->getSystemName();
-		std::string system2 = ((FileData*)file2)->getSourceFileData()->getSystemName();
+		const FileSortKeys* keys1 = file1.keys;
+		const FileSortKeys* keys2 = file2.keys;
 
-		if (system1 == system2)
+		if (keys1->systemName == keys2->systemName)
 		{
-			std::string year1 = file1->getMetadata().get(MetaDataId::ReleaseDate).substr(0, 4);
-			std::string year2 = file2->getMetadata().get(MetaDataId::ReleaseDate).substr(0, 4);
-
-			if (year1 == year2)
-				return Utils::String::compareIgnoreCase(((FileData*)file1)->getName(), ((FileData*)file2)->getName()) < 0;
+			if (keys1->releaseYear == keys2->releaseYear)
+				return keys1->name < keys2->name;
 
-			return year1 < year2;
+			return keys1->releaseYear < keys2->releaseYear;
 		}
-		return Utils::String::compareIgnoreCase(system1, system2) < 0;
+		return keys1->systemName < keys2->systemName;
 	}
 
-	bool compareReleaseYearSystem(const FileData* file1, const FileData* file2)
+	bool compareReleaseYearSystem(const SortEntry& file1, const SortEntry& file2)
 	{
-		std::string year1 = file1->getMetadata().get(MetaDataId::ReleaseDate).substr(0, 4);
-		std::string year2 = file2->getMetadata().get(MetaDataId::ReleaseDate).substr(0, 4);
+		const FileSortKeys* keys1 = file1.keys;
+		const FileSortKeys* keys2 = file2.keys;
 
-		if (year1 == year2)
+		if (keys1->releaseYear == keys2->releaseYear)
 		{
-			std::string system1 = ((FileData*)file1)->getSourceFileData()->getSystemName();
-			std::string system2 = ((FileData*)file2)->getSourceFileData()->getSystemName();
-
-			if (system1 == system2)
-				return Utils::String::compareIgnoreCase(((FileData*)file1)->getName(), ((FileData*)file2)->getName()) < 0;
+			if (keys1->systemName == keys2->systemName)
+				return keys1->name < keys2->name;
 
-			return Utils::String::compareIgnoreCase(system1, system2) < 0;
+			return keys1->systemName < keys2->systemName;
 		}
 
-		return year1 < year2;
+		return keys1->releaseYear < keys2->releaseYear;
 	}
 
-	bool compareReleaseDate(const FileData* file1, const FileData* file2)
+	bool compareReleaseDate(const SortEntry& file1, const SortEntry& file2)
 	{
 		// since it's stored as an ISO string (YYYYMMDDTHHMMSS), we can compare as a string
 		// as it's a lot faster than the time casts and then time comparisons
-		return (file1)->getMetadata().get(MetaDataId::ReleaseDate) < (file2)->getMetadata().get(MetaDataId::ReleaseDate);
+		return file1.file->getMetadata().getRef(MetaDataId::ReleaseDate) < file2.file->getMetadata().getRef(MetaDataId::ReleaseDate);
 	}
 
-	bool compareFileCreationDate(const FileData* file1, const FileData* file2)
+	bool compareFileCreationDate(const SortEntry& file1, const SortEntry& file2)
 	{
 		// As this sort mode is rarely used, don't care about storing date, always ask the file system
-		auto dt1 = Utils::FileSystem::getFileCreationDate(file1->getPath()).getIsoString();
-		auto dt2 = Utils::FileSystem::getFileCreationDate(file2->getPath()).getIsoString();
+		auto dt1 = Utils::FileSystem::getFileCreationDate(file1.file->getPath()).getIsoString();
+		auto dt2 = Utils::FileSystem::getFileCreationDate(file2.file->getPath()).getIsoString();
 		return dt1 < dt2;
 	}
 
-	bool compareGenre(const FileData* file1, const FileData* file2)
+	bool compareGenre(const SortEntry& file1, const SortEntry& file2)
 	{
-		std::string genre1 = file1->getMetadata().get(MetaDataId::Genre);
-		std::string genre2 = file2->getMetadata().get(MetaDataId::Genre);
+		const std::string& genre1 = file1.file->getMetadata().getRef(MetaDataId::Genre);
+		const std::string& genre2 = file2.file->getMetadata().getRef(MetaDataId::Genre);
 		return Utils::String::compareIgnoreCase(genre1, genre2) < 0;
 	}
 
-	bool compareDeveloper(const FileData* file1, const FileData* file2)
+	bool compareDeveloper(const SortEntry& file1, const SortEntry& file2)
 	{
-		std::string developer1 = file1->getMetadata().get(MetaDataId::Developer);
-		std::string developer2 = file2->getMetadata().get(MetaDataId::Developer);
+		const std::string& developer1 = file1.file->getMetadata().getRef(MetaDataId::Developer);
+		const std::string& developer2 = file2.file->getMetadata().getRef(MetaDataId::Developer);
 		return Utils::String::compareIgnoreCase(developer1, developer2) < 0;
 	}
 
-	bool comparePublisher(const FileData* file1, const FileData* file2)
+	bool comparePublisher(const SortEntry& file1, const SortEntry& file2)
 	{
-		std::string publisher1 = file1->getMetadata().get(MetaDataId::Publisher);
-		std::string publisher2 = file2->getMetadata().get(MetaDataId::Publisher);
+		const std::string& publisher1 = file1.file->getMetadata().getRef(MetaDataId::Publisher);
+		const std::string& publisher2 = file2.file->getMetadata().getRef(MetaDataId::Publisher);
 		return Utils::String::compareIgnoreCase(publisher1, publisher2) < 0;
 	}
 
-	bool compareSystem(const FileData* file1, const FileData* file2)
+	bool compareSystem(const SortEntry& file1, const SortEntry& file2)
 	{
-		std::string system1 = ((FileData*)file1)->getSourceFileData()->getSystemName();
-		std::string system2 = ((FileData*)file2)->getSourceFileData()->getSystemName();
-		return Utils::String::compareIgnoreCase(system1, system2) < 0;
+		return file1.keys->systemName < file2.keys->systemName;
 	}
 };
@@ -40,7 +40,16 @@ namespace FileSorts
 		RELEASEDATE_SYSTEM_DESCENDING = 27
 	};
 
-	typedef bool ComparisonFunction(const FileData* a, const FileData* b);
+	// A file and its sort keys, resolved before sorting
+	struct SortEntry
+	{
+		SortEntry(const FileSortKeys* _keys, FileData* _file) : keys(_keys), file(_file) { }
+
+		const FileSortKeys* keys;
+		FileData* file;
+	};
+
+	typedef bool ComparisonFunction(const SortEntry& a, const SortEntry& b);
 
 	struct SortType
 	{
@@ -60,27 +69,40 @@ namespace FileSorts
 		Singleton();
 
 		std::vector<SortType> mSortTypes;
+
+		bool mIgnoreLeadingArticles;
+		std::vector<std::string> mLeadingArticles;
 	};
 
 	void reset();
+
+	// Sort keys cached in FileData are rebuilt when this generation changes. invalidateSortKeys also reloads the leading articles, which are translated
+	unsigned int getSortKeysGeneration();
+	void invalidateSortKeys();
+
+	// Name as compared by compareName
+	std::string getSortName(const std::string& name);
 	SortType getSortType(int sortId);
+
+	// Sorts files with sort, reversed when it's descending
+	void sortFiles(std::vector<FileData*>& files, const SortType& sort, bool stable = false);
 	const std::vector<SortType>& getSortTypes();
 
-	bool compareName(const FileData* file1, const FileData* file2);
-	bool compareRating(const FileData* file1, const FileData* file2);
-	bool compareTimesPlayed(const FileData* file1, const FileData* fil2);
-	bool compareLastPlayed(const FileData* file1, const FileData* file2);
-	bool compareNumPlayers(const FileData* file1, const FileData* file2);
-	bool compareReleaseDate(const FileData* file1, const FileData* file2);
-	bool compareGenre(const FileData* file1, const FileData* file2);
-	bool compareDeveloper(const FileData* file1, const FileData* file2);
-	bool comparePublisher(const FileData* file1, const FileData* file2);
-	bool compareSystem(const FileData* file1, const FileData* file2);
-	bool compareFileCreationDate(const FileData* file1, const FileData* file2);
-	bool compareGameTime(const FileData* file1, const FileData* file2);
-
-	bool compareSystemReleaseYear(const FileData* file1, const FileData* file2);
-	bool compareReleaseYearSystem(const FileData* file1, const FileData* file2);
+	bool compareName(const SortEntry& file1, const SortEntry& file2);
+	bool compareRating(const SortEntry& file1, const SortEntry& file2);
+	bool compareTimesPlayed(const SortEntry& file1, const SortEntry& file2);
+	bool compareLastPlayed(const SortEntry& file1, const SortEntry& file2);
+	bool compareNumPlayers(const SortEntry& file1, const SortEntry& file2);
+	bool compareReleaseDate(const SortEntry& file1, const SortEntry& file2);
+	bool compareGenre(const SortEntry& file1, const SortEntry& file2);
+	bool compareDeveloper(const SortEntry& file1, const SortEntry& file2);
+	bool comparePublisher(const SortEntry& file1, const SortEntry& file2);
+	bool compareSystem(const SortEntry& file1, const SortEntry& file2);
+	bool compareFileCreationDate(const SortEntry& file1, const SortEntry& file2);
+	bool compareGameTime(const SortEntry& file1, const SortEntry& file2);
+
+	bool compareSystemReleaseYear(const SortEntry& file1, const SortEntry& file2);
+	bool compareReleaseYearSystem(const SortEntry& file1, const SortEntry& file2);
 
 	std::string stripLeadingArticle(const std::string &string, const std::vector<std::string> &articles);
 };
@@ -1,5 +1,6 @@
 #include "Gamelist.h"
 
+#include "GamelistCache.h"
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
 #include "FileData.h"
@@ -13,6 +14,7 @@
 
 #include <future>
 #include "utils/AsyncUtil.h"
+#include "utils/ProfilingUtil.h"
 
 FileData* findOrCreateFile(SystemData* system, const std::string& path, FileType type, std::unordered_map<std::string, FileData*>& fileMap)
 {
@@ -102,7 +104,40 @@ FileData* findOrCreateFile(SystemData* system, const std::string& path, FileType
 	return NULL;
 }
 
-void loadGamelistFile (const std::string xmlpath, SystemData* system, std::unordered_map<std::string, FileData*>& fileMap, size_t checkSize = SIZE_MAX)
+FileData* loadGamelistEntry(SystemData* system, const GamelistEntry& entry, std::unordered_map<std::string, FileData*>& fileMap, bool trustGamelist)
+{
+	if (!trustGamelist && !Utils::FileSystem::exists(entry.path))
+	{
+		LOG(LogWarning) << "Gamelist::loadGamelistEntry() - File \"" << entry.path << "\" does not exist! Ignoring.";
+		return nullptr;
+	}
+
+	FileData* file = findOrCreateFile(system, entry.path, entry.type, fileMap);
+	if (!file)
+	{
+		LOG(LogError) << "Gamelist::loadGamelistEntry() - Error finding/creating FileData for \"" << entry.path << "\", skipping.";
+		return nullptr;
+	}
+
+	if (file->isArcadeAsset())
+		return nullptr;
+
+	std::string defaultName = file->getMetadata(MetaDataId::Name);
+
+	file->setMetadata(entry.metadata);
+
+	//make sure name gets set if one didn't exist
+	if (file->getMetadata(MetaDataId::Name).empty())
+		file->setMetadata(MetaDataId::Name, defaultName);
+
+	if (!trustGamelist && !file->getHidden() && Utils::FileSystem::isHidden(entry.path))
+		file->setMetadata(MetaDataId::Hidden, "true");
+
+	return file;
+}
+
+// entries receives every node of the gamelist, including the ones whose file is missing
+bool loadGamelistFile (const std::string xmlpath, SystemData* system, std::unordered_map<std::string, FileData*>& fileMap, size_t checkSize = SIZE_MAX, std::vector<GamelistEntry>* entries = nullptr)
 {
 	LOG(LogInfo) << "Gamelist::loadGamelistFile() - Parsing XML file \"" << xmlpath << "\"...";
 
@@ -111,7 +146,7 @@ void loadGamelistFile (const std::string xmlpath, SystemData* system, std::unord
 	if ( !Utils::String::endsWith(xmlpath, ".xml") )
 	{
 		LOG(LogWarning) << "Gamelist::loadGamelistFile() - file \"" << xmlpath << "\" isn't a XML file, skipped!";
-		return;
+		return false;
 	}
 
 	pugi::xml_document doc;
@@ -120,14 +155,14 @@ void loadGamelistFile (const std::string xmlpath, SystemData* system, std::unord
 	if (!result)
 	{
 		LOG(LogError) << "Gamelist::loadGamelistFile() - Error parsing XML file \"" << xmlpath << "\"!\n	" << result.description();
-		return;
+		return false;
 	}
 
 	pugi::xml_node root = doc.child("gameList");
 	if (!root)
 	{
 		LOG(LogError) << "Gamelist::loadGamelistFile() - Could not find <gameList> node in gamelist \"" << xmlpath << "\"!";
-		return;
+		return false;
 	}
 
 	if (checkSize != SIZE_MAX)
@@ -136,7 +171,7 @@ void loadGamelistFile (const std::string xmlpath, SystemData* system, std::unord
 		if (parentSize != checkSize)
 		{
 			LOG(LogWarning) << "Gamelist::loadGamelistFile() - gamelist size don't match !";
-			return;
+			return false;
 		}
 	}
 
@@ -153,38 +188,24 @@ void loadGamelistFile (const std::string xmlpath, SystemData* system, std::unord
 			continue;
 
 		const std::string path = Utils::FileSystem::resolveRelativePath(fileNode.child("path").text().get(), relativeTo, false);
-		if (!trustGamelist && !Utils::FileSystem::exists(path))
-		{
-			LOG(LogWarning) << "Gamelist::loadGamelistFile() - File \"" << path << "\" does not exist! Ignoring.";
-			continue;
-		}
-
-		FileData* file = findOrCreateFile(system, path, type, fileMap);
-		if (!file)
-		{
-			LOG(LogError) << "Gamelist::loadGamelistFile() - Error finding/creating FileData for \"" << path << "\", skipping.";
-			continue;
-		}
-		else if (!file->isArcadeAsset())
-		{
-			std::string defaultName = file->getMetadata(MetaDataId::Name);
-
-			file->setMetadata(MetaDataList::createFromXML(type == FOLDER ? FOLDER_METADATA : GAME_METADATA, fileNode, system));
-			file->getMetadata().migrate(file, fileNode);
 
-			//make sure name gets set if one didn't exist
-			if (file->getMetadata(MetaDataId::Name).empty())
-				file->setMetadata(MetaDataId::Name, defaultName);
-
-			if (!trustGamelist && !file->getHidden() && Utils::FileSystem::isHidden(path))
-				file->setMetadata(MetaDataId::Hidden, "true");
+		GamelistEntry entry(type, path, MetaDataList::createFromXML(type == FOLDER ? FOLDER_METADATA : GAME_METADATA, fileNode, system));
+		entry.metadata.migrate(fileNode);
 
+		FileData* file = loadGamelistEntry(system, entry, fileMap, trustGamelist);
+		if (file != nullptr)
+		{
 			if (checkSize != SIZE_MAX)
 				file->getMetadata().setDirty();
 			else
 				file->getMetadata().resetChangedFlag();
 		}
+
+		if (entries != nullptr)
+			entries->push_back(std::move(entry));
 	}
+
+	return true;
 }
 
 std::string getTemporaryGamelistRecovery(SystemData* system)
@@ -215,13 +236,19 @@ void clearTemporaryGamelistRecovery(SystemData* system)
 
 void parseGamelist(SystemData* system, std::unordered_map<std::string, FileData*>& fileMap)
 {
+	ProfileScope("parseGamelist");
+
 	std::string xmlpath = system->getGamelistPath(false);
 
 	LOG(LogInfo) << "GameList::parseGamelist() - system: " << system->getName() << ", path: " << xmlpath;
 
 	auto size = Utils::FileSystem::getFileSize(xmlpath);
-	if (size != 0)
-		loadGamelistFile(xmlpath, system, fileMap);
+	if (size != 0 && !GamelistCache::load(system, xmlpath, fileMap))
+	{
+		std::vector<GamelistEntry> entries;
+		if (loadGamelistFile(xmlpath, system, fileMap, SIZE_MAX, &entries))
+			GamelistCache::save(system, xmlpath, entries);
+	}
 
 	auto files = Utils::FileSystem::getDirContent(getTemporaryGamelistRecovery(system), true, false);
 	for (auto file : files)
@@ -455,6 +482,8 @@ void updateGamelist(SystemData* system)
 				if (std::rename(tmpFile.c_str(), xmlWritePath.c_str()) != 0)
 					LOG(LogError) << "Gamelist::updateGamelist() - Unable to rename \"" << tmpFile << "to " << xmlWritePath << "\"!";
 
+				GamelistCache::remove(system);
+
 				clearTemporaryGamelistRecovery(system);
 			}
 			else 
@@ -2,10 +2,29 @@
 #ifndef ES_APP_GAME_LIST_H
 #define ES_APP_GAME_LIST_H
 
+#include <string>
 #include <unordered_map>
+#include <vector>
+
+#include "FileData.h"
 
 class SystemData;
-class FileData;
+
+// Returns the FileData for path, creating it (and missing parent folders) in the system tree if needed.
+FileData* findOrCreateFile(SystemData* system, const std::string& path, FileType type, std::unordered_map<std::string, FileData*>& fileMap);
+
+// A <game> or <folder> node of a gamelist, before it is matched against the files on disk.
+struct GamelistEntry
+{
+	GamelistEntry(FileType _type, const std::string& _path, MetaDataList&& _metadata) : type(_type), path(_path), metadata(std::move(_metadata)) { }
+
+	FileType type;
+	std::string path;
+	MetaDataList metadata;
+};
+
+// Adds the entry to the system tree, unless its file doesn't exist (see ParseGamelistOnly) or its extension is unknown.
+FileData* loadGamelistEntry(SystemData* system, const GamelistEntry& entry, std::unordered_map<std::string, FileData*>& fileMap, bool trustGamelist);
 
 // Loads gamelist.xml data into a SystemData.
 void parseGamelist(SystemData* system, std::unordered_map<std::string, FileData*>& fileMap);
@@ -0,0 +1,206 @@
+#include "GamelistCache.h"
+
+#include "utils/BinaryFileUtil.h"
+#include "utils/FileSystemUtil.h"
+#include "FileData.h"
+#include "Gamelist.h"
+#include "Log.h"
+#include "Settings.h"
+#include "SystemData.h"
+
+#include <string.h>
+#include <sys/stat.h>
+
+#define GAMELIST_CACHE_MAGIC   0x4C475345 // "ESGL"
+#define GAMELIST_CACHE_VERSION 2
+
+namespace
+{
+	struct SnapshotKey
+	{
+		uint64_t size;
+		int64_t  mtime;
+		int64_t  mtimeNsec;
+		uint8_t  flags;
+	};
+
+	enum SnapshotFlags : uint8_t
+	{
+		SNAPSHOT_PRELOAD_MEDIAS = 1
+	};
+
+	bool getSnapshotKey(const std::string& xmlPath, SnapshotKey& key)
+	{
+		struct stat64 info;
+		if (stat64(xmlPath.c_str(), &info) != 0)
+			return false;
+
+		memset(&key, 0, sizeof(key));
+		key.size = (uint64_t)info.st_size;
+		key.mtime = (int64_t)info.st_mtim.tv_sec;
+		key.mtimeNsec = (int64_t)info.st_mtim.tv_nsec;
+
+		if (Settings::getInstance()->getBool("PreloadMedias"))
+			key.flags |= SNAPSHOT_PRELOAD_MEDIAS;
+
+		return true;
+	}
+}
+
+std::string GamelistCache::getCachePath()
+{
+	return Utils::FileSystem::getEsConfigPath() + "/cache/gamelists";
+}
+
+std::string GamelistCache::getCacheFile(SystemData* system)
+{
+	return getCachePath() + "/" + system->getName() + ".bin";
+}
+
+bool GamelistCache::load(SystemData* system, const std::string& xmlPath, std::unordered_map<std::string, FileData*>& fileMap)
+{
+	if (!Settings::getInstance()->getBool("GamelistCache"))
+		return false;
+
+	SnapshotKey key;
+	if (!getSnapshotKey(xmlPath, key))
+		return false;
+
+	std::string cacheFile = getCacheFile(system);
+
+	Utils::MappedFile mapped(cacheFile);
+	if (mapped.data() == nullptr)
+		return false;
+
+	Utils::BinaryReader reader(mapped.data(), mapped.size());
+
+	if (reader.read<uint32_t>() != GAMELIST_CACHE_MAGIC || reader.read<uint32_t>() != GAMELIST_CACHE_VERSION)
+	{
+		LOG(LogDebug) << "GamelistCache::load() - Ignoring snapshot with unknown format \"" << cacheFile << "\"";
+		return false;
+	}
+
+	SnapshotKey snapshotKey = reader.read<SnapshotKey>();
+	std::string startPath = reader.readString();
+
+	if (!reader.isValid() || memcmp(&key, &snapshotKey, sizeof(SnapshotKey)) != 0 || startPath != system->getStartPath())
+	{
+		LOG(LogDebug) << "GamelistCache::load() - Snapshot is stale for system \"" << system->getName() << "\"";
+		return false;
+	}
+
+	LOG(LogInfo) << "GamelistCache::load() - Loading snapshot \"" << cacheFile << "\"...";
+
+	bool trustGamelist = Settings::getInstance()->getBool("ParseGamelistOnly");
+
+	uint32_t count = reader.read<uint32_t>();
+	for (uint32_t i = 0; i < count && reader.isValid(); i++)
+	{
+		FileType type = (FileType)reader.read<uint8_t>();
+		std::string path = reader.readString();
+
+		MetaDataList mdl(type == FOLDER ? FOLDER_METADATA : GAME_METADATA);
+		mdl.mRelativeTo = system;
+		mdl.mName = reader.readString();
+
+		uint8_t values = reader.read<uint8_t>();
+		for (uint8_t v = 0; v < values && reader.isValid(); v++)
+		{
+			MetaDataId id = (MetaDataId)reader.read<uint8_t>();
+			std::string value = reader.readString();
+
+			if (id > MetaDataId::Name && id < META_DATA_SLOTS)
+				mdl.setSlot(id, value);
+		}
+
+		uint16_t unknowns = reader.read<uint16_t>();
+		for (uint16_t u = 0; u < unknowns && reader.isValid(); u++)
+		{
+			std::string name = reader.readString();
+			std::string value = reader.readString();
+			bool isElement = reader.read<uint8_t>() != 0;
+			mdl.mUnKnownElements.push_back(std::tuple<std::string, std::string, bool>(name, value, isElement));
+		}
+
+		if (!reader.isValid())
+			break;
+
+		if (type != GAME && type != FOLDER)
+			continue;
+
+		FileData* file = loadGamelistEntry(system, GamelistEntry(type, path, std::move(mdl)), fileMap, trustGamelist);
+		if (file != nullptr)
+			file->getMetadata().resetChangedFlag();
+	}
+
+	if (!reader.isValid())
+		LOG(LogError) << "GamelistCache::load() - Snapshot \"" << cacheFile << "\" is truncated, some entries were not restored";
+
+	return true;
+}
+
+bool GamelistCache::save(SystemData* system, const std::string& xmlPath, const std::vector<GamelistEntry>& entries)
+{
+	if (!Settings::getInstance()->getBool("GamelistCache"))
+		return false;
+
+	SnapshotKey key;
+	if (!getSnapshotKey(xmlPath, key))
+		return false;
+
+	Utils::BinaryWriter writer;
+	writer.write<uint32_t>(GAMELIST_CACHE_MAGIC);
+	writer.write<uint32_t>(GAMELIST_CACHE_VERSION);
+	writer.write<SnapshotKey>(key);
+	writer.writeString(system->getStartPath());
+	writer.write<uint32_t>((uint32_t)entries.size());
+
+	for (const auto& entry : entries)
+	{
+		const MetaDataList& mdl = entry.metadata;
+
+		writer.write<uint8_t>((uint8_t)entry.type);
+		writer.writeString(entry.path);
+		writer.writeString(mdl.mName);
+
+		uint8_t values = 0;
+		for (int id = 0; id < META_DATA_SLOTS; id++)
+			if (mdl.mSlots[id] != nullptr)
+				values++;
+
+		writer.write<uint8_t>(values);
+		for (int id = 0; id < META_DATA_SLOTS; id++)
+		{
+			if (mdl.mSlots[id] == nullptr)
+				continue;
+
+			writer.write<uint8_t>((uint8_t)id);
+			writer.writeString(*mdl.mSlots[id]);
+		}
+
+		writer.write<uint16_t>((uint16_t)mdl.mUnKnownElements.size());
+		for (const auto& element : mdl.mUnKnownElements)
+		{
+			writer.writeString(std::get<0>(element));
+			writer.writeString(std::get<1>(element));
+			writer.write<uint8_t>(std::get<2>(element) ? 1 : 0);
+		}
+	}
+
+	std::string cacheFile = getCacheFile(system);
+	if (!writer.save(cacheFile))
+		return false;
+
+	LOG(LogDebug) << "GamelistCache::save() - Saved " << entries.size() << " entries to \"" << cacheFile << "\"";
+	return true;
+}
+
+void GamelistCache::remove(SystemData* system)
+{
+	Utils::FileSystem::removeFile(getCacheFile(system));
+}
+
+void GamelistCache::clear()
+{
+	Utils::FileSystem::deleteDirectoryFiles(getCachePath());
+}
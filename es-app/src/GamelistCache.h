@@ -0,0 +1,35 @@
+#pragma once
+#ifndef ES_APP_GAMELIST_CACHE_H
+#define ES_APP_GAMELIST_CACHE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class SystemData;
+class FileData;
+struct GamelistEntry;
+
+// Binary snapshot of a parsed gamelist.xml, stored per system in the ES config folder.
+// The snapshot is keyed by the size & modification time of the gamelist it was built from,
+// so it is silently ignored (and rebuilt) as soon as the xml file changes.
+// It holds every node of the gamelist : missing files & unknown extensions are filtered when it is loaded,
+// so games coming back (e.g. a remounted SD card) are not lost while the gamelist is unchanged.
+class GamelistCache
+{
+public:
+	// Applies the snapshot to the system tree. Returns false if there is no valid snapshot for xmlPath.
+	static bool load(SystemData* system, const std::string& xmlPath, std::unordered_map<std::string, FileData*>& fileMap);
+
+	// Writes a snapshot of the given entries, which must have been parsed from xmlPath.
+	static bool save(SystemData* system, const std::string& xmlPath, const std::vector<GamelistEntry>& entries);
+
+	static void remove(SystemData* system);
+	static void clear();
+
+private:
+	static std::string getCachePath();
+	static std::string getCacheFile(SystemData* system);
+};
+
+#endif // ES_APP_GAMELIST_CACHE_H
@@ -10,6 +10,11 @@
 #include "FileData.h"
 #include "ImageIO.h"
 
+#include <atomic>
+#include <mutex>
+#include <string.h>
+#include <unordered_set>
+
 std::vector<MetaDataDecl> MetaDataList::mMetaDataDecls;
 
 static std::map<MetaDataId, int> mMetaDataIndexes;
@@ -17,6 +22,20 @@ static std::string* mDefaultGameMap = nullptr;
 static MetaDataType* mGameTypeMap = nullptr;
 static std::map<std::string, MetaDataId> mGameIdMap;
 
+// Sharded by hash, so that the loading threads don't all wait on the same lock
+#define STRING_POOL_SHARDS 16
+
+struct StringPoolShard
+{
+	std::mutex lock;
+	std::unordered_set<std::string> strings;
+};
+
+static StringPoolShard mStringPool[STRING_POOL_SHARDS];
+
+// The pool can only be released when no list points to it anymore
+static std::atomic<int> mLiveLists(0);
+
 void MetaDataList::initMetadata()
 {
 	MetaDataDecl gameDecls[] =
@@ -86,7 +105,7 @@ void MetaDataList::initMetadata()
 	for (int i = 0 ; i < mMetaDataDecls.size() ; i++)
 		mMetaDataIndexes[mMetaDataDecls[i].id] = i;
 
-	int maxID = mMetaDataDecls.size() + 1;
+	int maxID = META_DATA_SLOTS;
 
 	if (mDefaultGameMap != nullptr)
 		delete[] mDefaultGameMap;
@@ -123,9 +142,154 @@ MetaDataId MetaDataList::getId(const std::string& key) const
 	return mGameIdMap[key];
 }
 
-MetaDataList::MetaDataList(MetaDataListType type) : mType(type), mWasChanged(false), mRelativeTo(nullptr)
+MetaDataList::MetaDataList(MetaDataListType type) : mType(type), mWasChanged(false), mRevision(0), mRelativeTo(nullptr)
+{
+	memset(mSlots, 0, sizeof(mSlots));
+	mLiveLists++;
+}
+
+MetaDataList::MetaDataList(const MetaDataList& source) : mType(source.mType), mWasChanged(false), mRevision(0), mRelativeTo(nullptr)
+{
+	memset(mSlots, 0, sizeof(mSlots));
+	mLiveLists++;
+	*this = source;
+}
+
+MetaDataList::MetaDataList(MetaDataList&& source) : mType(source.mType), mWasChanged(false), mRevision(0), mRelativeTo(nullptr)
+{
+	memset(mSlots, 0, sizeof(mSlots));
+	mLiveLists++;
+	*this = std::move(source);
+}
+
+MetaDataList::~MetaDataList()
+{
+	clearSlots();
+	mLiveLists--;
+}
+
+MetaDataList& MetaDataList::operator=(const MetaDataList& source)
+{
+	if (this == &source)
+		return *this;
+
+	clearSlots();
+
+	for (int i = 0; i < META_DATA_SLOTS; i++)
+	{
+		const std::string* value = source.mSlots[i];
+		if (value != nullptr && !isShared((MetaDataId)i))
+			value = new std::string(*value);
+
+		mSlots[i] = value;
+	}
+
+	mName = source.mName;
+	mType = source.mType;
+	mWasChanged = source.mWasChanged;
+	mRelativeTo = source.mRelativeTo;
+	mUnKnownElements = source.mUnKnownElements;
+	mRevision++;
+	return *this;
+}
+
+MetaDataList& MetaDataList::operator=(MetaDataList&& source)
+{
+	if (this == &source)
+		return *this;
+
+	clearSlots();
+
+	memcpy(mSlots, source.mSlots, sizeof(mSlots));
+	memset(source.mSlots, 0, sizeof(source.mSlots));
+
+	mName = std::move(source.mName);
+	mType = source.mType;
+	mWasChanged = source.mWasChanged;
+	mRelativeTo = source.mRelativeTo;
+	mUnKnownElements = std::move(source.mUnKnownElements);
+	mRevision++;
+	return *this;
+}
+
+// Fields whose values are shared by a lot of games are stored once in the string pool.
+// Not the ones with nearly one value per game (dates, ratings) : the pool would only grow
+bool MetaDataList::isShared(MetaDataId id)
+{
+	switch (id)
+	{
+	case MetaDataId::Emulator:
+	case MetaDataId::Core:
+	case MetaDataId::Developer:
+	case MetaDataId::Publisher:
+	case MetaDataId::Genre:
+	case MetaDataId::ArcadeSystemName:
+	case MetaDataId::Players:
+	case MetaDataId::Favorite:
+	case MetaDataId::Hidden:
+	case MetaDataId::KidGame:
+		return true;
+	default:
+		return false;
+	}
+}
+
+const std::string* MetaDataList::intern(const std::string& value)
+{
+	StringPoolShard& shard = mStringPool[std::hash<std::string>()(value) % STRING_POOL_SHARDS];
+
+	std::unique_lock<std::mutex> lock(shard.lock);
+	return &(*shard.strings.insert(value).first);
+}
+
+bool MetaDataList::releaseStringPool()
+{
+	if (mLiveLists != 0)
+	{
+		LOG(LogDebug) << "MetaDataList::releaseStringPool() - " << mLiveLists << " lists still alive, the pool is kept";
+		return false;
+	}
+
+	size_t count = 0;
+
+	for (auto& shard : mStringPool)
+	{
+		std::unique_lock<std::mutex> lock(shard.lock);
+		count += shard.strings.size();
+
+		std::unordered_set<std::string> empty;
+		shard.strings.swap(empty);
+	}
+
+	LOG(LogDebug) << "MetaDataList::releaseStringPool() - " << count << " strings released";
+	return true;
+}
+
+void MetaDataList::setSlot(MetaDataId id, const std::string& value)
+{
+	mRevision++;
+
+	if (isShared(id))
+	{
+		mSlots[id] = intern(value);
+		return;
+	}
+
+	if (mSlots[id] != nullptr)
+		*const_cast<std::string*>(mSlots[id]) = value;
+	else
+		mSlots[id] = new std::string(value);
+}
+
+void MetaDataList::clearSlots()
 {
+	for (int i = 0; i < META_DATA_SLOTS; i++)
+	{
+		if (mSlots[i] != nullptr && !isShared((MetaDataId)i))
+			delete mSlots[i];
 
+		mSlots[i] = nullptr;
+	}
 }
 
 MetaDataList MetaDataList::createFromXML(MetaDataListType type, pugi::xml_node& node, SystemData* system)
@@ -227,9 +391,8 @@ MetaDataList MetaDataList::createFromXML(MetaDataListType type, pugi::xml_node&
 }
 
 // Add migration for alternative formats & old tags
-void MetaDataList::migrate(FileData* file, pugi::xml_node& node)
+void MetaDataList::migrate(pugi::xml_node& node)
 {
-	std::string ext = Utils::String::toLower(Utils::FileSystem::getExtension(file->getPath()));
 	if (get(MetaDataId::Crc32).empty())
 	{
 		pugi::xml_node xelement = node.child("hash");
@@ -255,16 +418,16 @@ void MetaDataList::appendToXML(pugi::xml_node& parent, bool ignoreDefaults, cons
 		if (mddIter->id == MetaDataId::GenreIds)
 			continue;
 */
-		auto mapIter = mMap.find(mddIter->id);
-		if(mapIter != mMap.cend())
+		const std::string* slot = mSlots[mddIter->id];
+		if (slot != nullptr)
 		{
 			// we have this value!
 			// if it's just the default (and we ignore defaults), don't write it
-			if (ignoreDefaults && mapIter->second == mddIter->defaultValue)
+			if (ignoreDefaults && *slot == mddIter->defaultValue)
 				continue;
 
 			// try and make paths relative if we can
-			std::string value = mapIter->second;
+			std::string value = *slot;
 			if (mddIter->type == MD_PATH)
 			{
 				if (fullPaths && mRelativeTo != nullptr)
@@ -299,24 +462,25 @@ void MetaDataList::set(MetaDataId id, const std::string& value)
 
 		mName = value;
 		mWasChanged = true;
+		mRevision++;
 		return;
 	}
 
 	// Players -> remove "1-"
 	if (mType == GAME_METADATA && id == 12 && Utils::String::startsWith(value, "1-")) // "players"
 	{
-		mMap[id] = Utils::String::replace(value, "1-", "");
+		setSlot(id, Utils::String::replace(value, "1-", ""));
 		return;
 	}
 
-	auto prev = mMap.find(id);
-	if (prev != mMap.cend() && prev->second == value)
+	const std::string* prev = mSlots[id];
+	if (prev != nullptr && *prev == value)
 		return;
 
 	if (mGameTypeMap[id] == MD_PATH && mRelativeTo != nullptr) // if it's a path, resolve relative paths
-		mMap[id] = Utils::FileSystem::createRelativePath(value, mRelativeTo->getStartPath(), true);
+		setSlot(id, Utils::FileSystem::createRelativePath(value, mRelativeTo->getStartPath(), true));
 	else
-		mMap[id] = Utils::String::trim(value);
+		setSlot(id, Utils::String::trim(value));
 
 	mWasChanged = true;
 }
@@ -326,18 +490,30 @@ const std::string MetaDataList::get(MetaDataId id, bool resolveRelativePaths) co
 	if (id == MetaDataId::Name)
 		return mName;
 
-	auto it = mMap.find(id);
-	if (it != mMap.end())
+	const std::string* slot = mSlots[id];
+	if (slot != nullptr)
 	{
 		if (resolveRelativePaths && mGameTypeMap[id] == MD_PATH && mRelativeTo != nullptr) // if it's a path, resolve relative paths
-			return Utils::FileSystem::resolveRelativePath(it->second, mRelativeTo->getStartPath(), true);
+			return Utils::FileSystem::resolveRelativePath(*slot, mRelativeTo->getStartPath(), true);
 
-		return it->second;
+		return *slot;
 	}
 
 	return mDefaultGameMap[id];
 }
 
+const std::string& MetaDataList::getRef(MetaDataId id) const
+{
+	if (id == MetaDataId::Name)
+		return mName;
+
+	const std::string* slot = mSlots[id];
+	if (slot != nullptr)
+		return *slot;
+
+	return mDefaultGameMap[id];
+}
+
 void MetaDataList::set(const std::string& key, const std::string& value)
 {
 	if (mGameIdMap.find(key) == mGameIdMap.cend())
@@ -356,12 +532,12 @@ const std::string MetaDataList::get(const std::string& key, bool resolveRelative
 
 int MetaDataList::getInt(MetaDataId id) const
 {
-	return atoi(get(id).c_str());
+	return atoi(getRef(id).c_str());
 }
 
 float MetaDataList::getFloat(MetaDataId id) const
 {
-	return Utils::String::toFloat(get(id));
+	return Utils::String::toFloat(getRef(id));
 }
 
 bool MetaDataList::wasChanged() const
@@ -105,6 +105,9 @@ enum MetaDataId
 	ScraperId = 24
 };
 
+// Number of storage slots in a MetaDataList, one per MetaDataId
+static const int META_DATA_SLOTS = MetaDataId::ScraperId + 1;
+
 namespace MetaDataImportType
 {
 	enum Types : int
@@ -159,20 +162,34 @@ enum MetaDataListType
 
 class MetaDataList
 {
+	friend class GamelistCache;
+
 public:
 	static void initMetadata();
 
+	// Frees the shared values once every list is destroyed, e.g. when the systems are reloaded
+	static bool releaseStringPool();
+
 	static MetaDataList createFromXML(MetaDataListType type, pugi::xml_node& node, SystemData* system);
 	void appendToXML(pugi::xml_node& parent, bool ignoreDefaults, const std::string& relativeTo, bool fullPaths = false) const;
 
-	void migrate(FileData* file, pugi::xml_node& node);
+	void migrate(pugi::xml_node& node);
 
 	MetaDataList(MetaDataListType type);
+	MetaDataList(const MetaDataList& source);
+	MetaDataList(MetaDataList&& source);
+	~MetaDataList();
+
+	MetaDataList& operator=(const MetaDataList& source);
+	MetaDataList& operator=(MetaDataList&& source);
 
 	void set(MetaDataId id, const std::string& value);
 
 	const std::string get(MetaDataId id, bool resolveRelativePaths = true) const;
 
+	// Returns the stored (or default) value without copying it. Paths are returned unresolved.
+	const std::string& getRef(MetaDataId id) const;
+
 	void set(const std::string& key, const std::string& value);
 	const std::string get(const std::string& key, bool resolveRelativePaths = true) const;
 
@@ -192,6 +209,8 @@ public:
 	}
 
 	inline MetaDataListType getType() const { return mType; }
+	// Changes every time a value of this list is modified
+	inline unsigned int getRevision() const { return mRevision; }
 	static const std::vector<MetaDataDecl>& getMDD() { return mMetaDataDecls; }
 	inline const std::string& getName() const { return mName; }
 
@@ -200,10 +219,22 @@ public:
 	std::string getRelativeRootPath();
 
 private:
+	void setSlot(MetaDataId id, const std::string& value);
+	void clearSlots();
+
+	static bool isShared(MetaDataId id);
+	static const std::string* intern(const std::string& value);
+
 	std::string		mName;
 	MetaDataListType mType;
-	std::map<MetaDataId, std::string> mMap;
+
+	// Dense storage indexed by MetaDataId, nullptr means the default value.
+	// Fields with few distinct values (genre, developer, core...) point to a process-wide string pool,
+	// the other slots own their string.
+	const std::string* mSlots[META_DATA_SLOTS];
+
 	bool mWasChanged;
+	unsigned int mRevision;
 	SystemData*		mRelativeTo;
 
 	static std::vector<MetaDataDecl> mMetaDataDecls;
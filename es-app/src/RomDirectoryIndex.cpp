@@ -0,0 +1,150 @@
+#include "RomDirectoryIndex.h"
+
+#include "utils/BinaryFileUtil.h"
+#include "Log.h"
+#include "SystemData.h"
+
+#include <sys/stat.h>
+
+#define ROM_INDEX_MAGIC   0x49445345 // "ESDI"
+#define ROM_INDEX_VERSION 1
+
+enum RomIndexFlags : uint8_t
+{
+	ROM_INDEX_HIDDEN = 1,
+	ROM_INDEX_DIRECTORY = 2,
+	ROM_INDEX_SYMLINK = 4
+};
+
+RomDirectoryIndex::RomDirectoryIndex(SystemData* system) : mSystem(system), mChanged(false), mHits(0), mMisses(0)
+{
+
+}
+
+std::string RomDirectoryIndex::getCachePath()
+{
+	return Utils::FileSystem::getEsConfigPath() + "/cache/directories";
+}
+
+std::string RomDirectoryIndex::getCacheFile()
+{
+	return getCachePath() + "/" + mSystem->getName() + ".bin";
+}
+
+void RomDirectoryIndex::load()
+{
+	Utils::MappedFile mapped(getCacheFile());
+	if (mapped.data() == nullptr)
+		return;
+
+	Utils::BinaryReader reader(mapped.data(), mapped.size());
+	if (reader.read<uint32_t>() != ROM_INDEX_MAGIC || reader.read<uint32_t>() != ROM_INDEX_VERSION)
+		return;
+
+	// Paths are absolute : the index is useless if the system moved
+	if (reader.readString() != mSystem->getStartPath())
+		return;
+
+	uint32_t count = reader.read<uint32_t>();
+	for (uint32_t i = 0; i < count && reader.isValid(); i++)
+	{
+		std::string path = reader.readString();
+
+		Directory& directory = mLoaded[path];
+		directory.mtime = reader.read<int64_t>();
+		directory.mtimeNsec = reader.read<int64_t>();
+
+		uint32_t files = reader.read<uint32_t>();
+		for (uint32_t f = 0; f < files && reader.isValid(); f++)
+		{
+			Utils::FileSystem::FileInfo fi;
+			fi.path = reader.readString();
+
+			uint8_t flags = reader.read<uint8_t>();
+			fi.hidden = (flags & ROM_INDEX_HIDDEN) != 0;
+			fi.directory = (flags & ROM_INDEX_DIRECTORY) != 0;
+			fi.symlink = (flags & ROM_INDEX_SYMLINK) != 0;
+
+			directory.content.push_back(fi);
+		}
+	}
+
+	if (!reader.isValid())
+	{
+		LOG(LogWarning) << "RomDirectoryIndex::load() - Index of system \"" << mSystem->getName() << "\" is truncated, ignoring it";
+		mLoaded.clear();
+	}
+}
+
+void RomDirectoryIndex::save()
+{
+	LOG(LogDebug) << "RomDirectoryIndex::save() - " << mSystem->getName() << " : " << mHits << " folders from index, " << mMisses << " listed";
+
+	// Nothing listed again, and no folder vanished
+	if (!mChanged && mVisited.size() == mLoaded.size())
+		return;
+
+	Utils::BinaryWriter writer;
+	writer.write<uint32_t>(ROM_INDEX_MAGIC);
+	writer.write<uint32_t>(ROM_INDEX_VERSION);
+	writer.writeString(mSystem->getStartPath());
+	writer.write<uint32_t>((uint32_t)mVisited.size());
+
+	for (auto& it : mVisited)
+	{
+		writer.writeString(it.first);
+		writer.write<int64_t>(it.second.mtime);
+		writer.write<int64_t>(it.second.mtimeNsec);
+		writer.write<uint32_t>((uint32_t)it.second.content.size());
+
+		for (auto& fi : it.second.content)
+		{
+			writer.writeString(fi.path);
+			writer.write<uint8_t>((fi.hidden ? ROM_INDEX_HIDDEN : 0) | (fi.directory ? ROM_INDEX_DIRECTORY : 0) | (fi.symlink ? ROM_INDEX_SYMLINK : 0));
+		}
+	}
+
+	writer.save(getCacheFile());
+}
+
+Utils::FileSystem::fileList RomDirectoryIndex::getDirInfo(const std::string& path)
+{
+	// stat before listing : a change made while listing will be caught by the next scan
+	struct stat64 info;
+	if (stat64(path.c_str(), &info) != 0)
+		return Utils::FileSystem::getDirInfo(path);
+
+	{
+		std::unique_lock<std::mutex> lock(mLock);
+
+		auto it = mLoaded.find(path);
+		if (it != mLoaded.cend() && it->second.mtime == (int64_t)info.st_mtim.tv_sec && it->second.mtimeNsec == (int64_t)info.st_mtim.tv_nsec)
+		{
+			mVisited[path] = it->second;
+			mHits++;
+
+			Utils::FileSystem::fileList content = it->second.content;
+			lock.unlock();
+
+			Utils::FileSystem::cacheDirInfo(path, content);
+			return content;
+		}
+	}
+
+	Directory directory;
+	directory.mtime = (int64_t)info.st_mtim.tv_sec;
+	directory.mtimeNsec = (int64_t)info.st_mtim.tv_nsec;
+	directory.content = Utils::FileSystem::getDirInfo(path);
+
+	std::unique_lock<std::mutex> lock(mLock);
+	mVisited[path] = directory;
+	mChanged = true;
+	mMisses++;
+
+	return directory.content;
+}
+
+void RomDirectoryIndex::clear()
+{
+	Utils::FileSystem::deleteDirectoryFiles(getCachePath());
+}
@@ -0,0 +1,51 @@
+#pragma once
+#ifndef ES_APP_ROM_DIRECTORY_INDEX_H
+#define ES_APP_ROM_DIRECTORY_INDEX_H
+
+#include "utils/FileSystemUtil.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <stdint.h>
+
+class SystemData;
+
+// Persisted listing of the folders of a system, stored in the ES config folder.
+// A folder is only listed again when its modification time changed since the previous scan.
+// getDirInfo is thread safe, so the folders of a system can be scanned concurrently.
+class RomDirectoryIndex
+{
+public:
+	RomDirectoryIndex(SystemData* system);
+
+	void load();
+	void save();
+
+	Utils::FileSystem::fileList getDirInfo(const std::string& path);
+
+	static void clear();
+
+private:
+	struct Directory
+	{
+		int64_t mtime;
+		int64_t mtimeNsec;
+		Utils::FileSystem::fileList content;
+	};
+
+	static std::string getCachePath();
+	std::string getCacheFile();
+
+	SystemData* mSystem;
+
+	std::mutex mLock;
+	std::unordered_map<std::string, Directory> mLoaded;  // From the previous scan
+	std::unordered_map<std::string, Directory> mVisited; // Folders listed during this scan
+	bool mChanged;
+
+	size_t mHits;
+	size_t mMisses;
+};
+
+#endif // ES_APP_ROM_DIRECTORY_INDEX_H
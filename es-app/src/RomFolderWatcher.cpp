@@ -0,0 +1,230 @@
+#include "RomFolderWatcher.h"
+
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "views/gamelist/IGameListView.h"
+#include "views/ViewController.h"
+#include "CollectionSystemManager.h"
+#include "FileData.h"
+#include "Log.h"
+#include "Settings.h"
+#include "SystemData.h"
+#include "Window.h"
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#define WATCH_MASK (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR)
+
+RomFolderWatcher* RomFolderWatcher::sInstance = nullptr;
+
+void RomFolderWatcher::start(Window* window)
+{
+	stop();
+
+	if (!Settings::getInstance()->getBool("WatchRomFolders"))
+		return;
+
+	sInstance = new RomFolderWatcher(window);
+}
+
+void RomFolderWatcher::stop()
+{
+	if (sInstance == nullptr)
+		return;
+
+	delete sInstance;
+	sInstance = nullptr;
+}
+
+RomFolderWatcher::RomFolderWatcher(Window* window) : mWindow(window), mRunning(false), mThread(nullptr)
+{
+	mFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (mFd < 0)
+	{
+		LOG(LogError) << "RomFolderWatcher - Unable to initialize inotify";
+		return;
+	}
+
+	for (auto system : SystemData::sSystemVector)
+	{
+		if (system->isCollection() || system->isGroupSystem() || system->getRootFolder() == nullptr)
+			continue;
+
+		addWatches(system->getName(), system->getRootFolder());
+	}
+
+	LOG(LogInfo) << "RomFolderWatcher - Watching " << mWatches.size() << " folders";
+
+	mRunning = true;
+	mThread = new std::thread(&RomFolderWatcher::run, this);
+}
+
+RomFolderWatcher::~RomFolderWatcher()
+{
+	mRunning = false;
+
+	if (mThread != nullptr)
+	{
+		mThread->join();
+		delete mThread;
+	}
+
+	if (mFd >= 0)
+		close(mFd); // Also removes the watches
+}
+
+void RomFolderWatcher::addWatches(const std::string& system, FolderData* folder)
+{
+	std::string path = folder->getPath();
+
+	int wd = inotify_add_watch(mFd, path.c_str(), WATCH_MASK);
+	if (wd < 0)
+	{
+		LOG(LogWarning) << "RomFolderWatcher - Unable to watch \"" << path << "\"";
+		return;
+	}
+
+	Watch watch;
+	watch.system = system;
+	watch.path = path;
+	mWatches[wd] = watch;
+
+	for (auto child : folder->getChildren())
+		if (child->getType() == FOLDER)
+			addWatches(system, (FolderData*)child);
+}
+
+void RomFolderWatcher::run()
+{
+	char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+	while (mRunning)
+	{
+		struct pollfd pfd;
+		pfd.fd = mFd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+
+		// Wake up regularly to check if we must stop
+		if (poll(&pfd, 1, 250) <= 0)
+			continue;
+
+		ssize_t length = read(mFd, buffer, sizeof(buffer));
+		if (length <= 0)
+			continue;
+
+		for (char* ptr = buffer; ptr < buffer + length; ptr += sizeof(struct inotify_event) + ((struct inotify_event*)ptr)->len)
+		{
+			struct inotify_event* event = (struct inotify_event*)ptr;
+
+			if (event->mask & IN_Q_OVERFLOW)
+			{
+				LOG(LogWarning) << "RomFolderWatcher - Event queue overflow, some changes will only show up at the next reload";
+				continue;
+			}
+
+			if (event->len == 0 || (event->mask & IN_ISDIR))
+				continue;
+
+			auto it = mWatches.find(event->wd);
+			if (it == mWatches.cend())
+				continue;
+
+			std::string systemName = it->second.system;
+			std::string path = it->second.path + "/" + std::string(event->name);
+
+			// The tree belongs to the UI thread
+			if (event->mask & (IN_CREATE | IN_MOVED_TO))
+				mWindow->postToUiThread([systemName, path] { onFileAdded(systemName, path); });
+			else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+				mWindow->postToUiThread([systemName, path] { onFileRemoved(systemName, path); });
+		}
+	}
+}
+
+void RomFolderWatcher::onFileAdded(const std::string& systemName, const std::string& path)
+{
+	SystemData* system = SystemData::getSystem(systemName);
+	if (system == nullptr || !Utils::FileSystem::exists(path))
+		return;
+
+	FolderData* root = system->getRootFolder();
+	if (root->FindByPath(path) != nullptr)
+		return;
+
+	if (!Settings::getInstance()->getBool("ShowHiddenFiles") && Utils::FileSystem::isHidden(path))
+		return;
+
+	std::string extension = Utils::String::toLower(Utils::FileSystem::getExtension(path));
+	if (!system->getSystemEnvData()->isValidExtension(extension))
+		return;
+
+	FolderData* folder = root;
+
+	std::string parentPath = Utils::FileSystem::getParent(path);
+	if (parentPath != root->getPath())
+	{
+		FileData* parent = root->FindByPath(parentPath);
+		if (parent == nullptr || parent->getType() != FOLDER)
+			return;
+
+		folder = (FolderData*)parent;
+	}
+
+	FileData* game = new FileData(GAME, path, system);
+
+	// preventing new arcade assets to be added
+	if (extension == ".zip" && game->isArcadeAsset())
+	{
+		delete game;
+		return;
+	}
+
+	LOG(LogInfo) << "RomFolderWatcher - Adding \"" << path << "\"";
+
+	folder->addChild(game);
+	system->addToIndex(game);
+	system->updateDisplayedGameCount();
+
+	CollectionSystemManager::get()->refreshCollectionSystems(game);
+
+	if (system->isGroupChildSystem())
+	{
+		// Grouped systems are displayed by their parent's view
+		auto view = ViewController::get()->getGameListView(system->getParentGroupSystem(), false);
+		if (view != nullptr)
+			view.get()->onFileChanged(game, FILE_ADDED);
+	}
+	else
+		ViewController::get()->onFileChanged(game, FILE_ADDED);
+}
+
+void RomFolderWatcher::onFileRemoved(const std::string& systemName, const std::string& path)
+{
+	SystemData* system = SystemData::getSystem(systemName);
+	if (system == nullptr)
+		return;
+
+	FileData* game = system->getRootFolder()->FindByPath(path);
+	if (game == nullptr || game->getType() != GAME)
+		return;
+
+	LOG(LogInfo) << "RomFolderWatcher - Removing \"" << path << "\"";
+
+	CollectionSystemManager::get()->deleteCollectionFiles(game);
+
+	SystemData* viewSystem = system;
+	if (viewSystem->isGroupChildSystem())
+		viewSystem = viewSystem->getParentGroupSystem();
+
+	auto view = ViewController::get()->getGameListView(viewSystem, false);
+	if (view != nullptr)
+		view.get()->remove(game);
+	else
+		delete game;
+
+	// The game must be out of the tree to be uncounted
+	system->updateDisplayedGameCount();
+}
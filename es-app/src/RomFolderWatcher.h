@@ -0,0 +1,48 @@
+#pragma once
+#ifndef ES_APP_ROM_FOLDER_WATCHER_H
+#define ES_APP_ROM_FOLDER_WATCHER_H
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+
+class Window;
+class FolderData;
+
+// Watches the rom folders with inotify, and adds/removes games from the loaded systems
+// when files are copied or deleted, without reloading the whole gamelists.
+// New subfolders are not tracked : they show up at the next reload.
+class RomFolderWatcher
+{
+public:
+	static void start(Window* window);
+	static void stop();
+
+private:
+	struct Watch
+	{
+		std::string system;
+		std::string path;
+	};
+
+	RomFolderWatcher(Window* window);
+	~RomFolderWatcher();
+
+	void addWatches(const std::string& system, FolderData* folder);
+	void run();
+
+	static void onFileAdded(const std::string& systemName, const std::string& path);
+	static void onFileRemoved(const std::string& systemName, const std::string& path);
+
+	static RomFolderWatcher* sInstance;
+
+	Window* mWindow;
+	int mFd;
+	std::map<int, Watch> mWatches;
+
+	std::atomic<bool> mRunning;
+	std::thread* mThread;
+};
+
+#endif // ES_APP_ROM_FOLDER_WATCHER_H
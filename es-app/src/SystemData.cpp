@@ -6,6 +6,8 @@
 #include "FileFilterIndex.h"
 #include "FileSorts.h"
 #include "Gamelist.h"
+#include "RomDirectoryIndex.h"
+#include "RomFolderWatcher.h"
 #include "Log.h"
 #include "platform.h"
 #include "Settings.h"
@@ -15,6 +17,10 @@
 #include "utils/StringUtil.h"
 #include "utils/ThreadPool.h"
 #include "utils/AsyncUtil.h"
+#include "utils/ProfilingUtil.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include "GuiComponent.h"
 #include "Window.h"
 #include "views/ViewController.h"
@@ -26,13 +32,14 @@ using namespace Utils;
 
 std::vector<SystemData*> SystemData::sSystemVector;
 
-SystemData::SystemData(const SystemMetadata& meta, SystemEnvironmentData* envData, bool CollectionSystem, bool groupedSystem, bool withTheme, bool loadThemeOnlyIfElements) :
+SystemData::SystemData(const SystemMetadata& meta, SystemEnvironmentData* envData, bool CollectionSystem, bool groupedSystem, bool withTheme, bool loadThemeOnlyIfElements, Utils::ThreadPool* scanPool) :
 	mMetadata(meta), mEnvData(envData), mIsCollectionSystem(CollectionSystem), mIsGameSystem(true), mHasTheme(withTheme)
 {
 	mIsGroupSystem = groupedSystem;
 	mGameListHash = 0;
 	mSortId = Settings::getInstance()->getInt(getName() + ".sort"),
 	mGameCountInfo = nullptr;
+	mLocalMedias = nullptr;
 	mGridSizeOverride = Vector2f(0, 0);
 	mViewModeChanged = false;
 	mFilterIndex = nullptr;// new FileFilterIndex();
@@ -50,7 +57,7 @@ SystemData::SystemData(const SystemMetadata& meta, SystemEnvironmentData* envDat
 		
 		if (!Settings::getInstance()->getBool("ParseGamelistOnly"))
 		{
-			populateFolder(mRootFolder, fileMap);
+			populateFolder(mRootFolder, fileMap, scanPool);
 			if (mRootFolder->getChildren().size() == 0)
 				return;
 
@@ -123,6 +130,9 @@ SystemData::~SystemData()
 
 	if (mFilterIndex != nullptr)
 		delete mFilterIndex;
+
+	if (mLocalMedias != nullptr)
+		delete mLocalMedias;
 }
 
 void SystemData::setIsGameSystemStatus()
@@ -133,9 +143,94 @@ void SystemData::setIsGameSystemStatus()
 	mIsGameSystem = (mMetadata.name != "retropie");
 }
 
-void SystemData::populateFolder(FolderData* folder, std::unordered_map<std::string, FileData*>& fileMap)
+// State shared by the scan tasks of one populateFolder call
+struct SystemData::ScanContext
+{
+	ScanContext() : index(nullptr), pool(nullptr), pending(0) { }
+
+	bool showHidden;
+	bool preloadMedias;
+	RomDirectoryIndex* index;
+	Utils::ThreadPool* pool; // Subfolders are scanned inline without one
+
+	std::mutex lock;
+	std::condition_variable done;
+	int pending; // Queued subfolder scans not finished yet
+};
+
+// Result of the enumeration of one folder, in directory order
+struct SystemData::FolderScan
 {
-	const std::string& folderPath = folder->getPath();
+	struct Entry
+	{
+		std::string path;
+		FileData* game;
+		FolderScan* folder;
+	};
+
+	FolderScan(const std::string& _path) : path(_path) { }
+
+	~FolderScan()
+	{
+		for (auto& entry : entries)
+		{
+			if (entry.game != nullptr)
+				delete entry.game;
+
+			if (entry.folder != nullptr)
+				delete entry.folder;
+		}
+	}
+
+	std::string path;
+	std::vector<Entry> entries;
+};
+
+void SystemData::populateFolder(FolderData* folder, std::unordered_map<std::string, FileData*>& fileMap, Utils::ThreadPool* pool)
+{
+	ScanContext context;
+	context.pool = pool;
+	context.showHidden = Settings::getInstance()->getBool("ShowHiddenFiles");
+	context.preloadMedias = Settings::getInstance()->getBool("PreloadMedias");
+
+	RomDirectoryIndex index(this);
+	if (Settings::getInstance()->getBool("RomDirectoryIndex"))
+	{
+		index.load();
+		context.index = &index;
+	}
+
+	// The root folder is scanned by the calling thread, each subfolder is a task of its own
+	FolderScan scan(folder->getPath());
+	scanFolder(&context, &scan);
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(context.lock);
+			if (context.pending == 0)
+				break;
+		}
+
+		// This runs on a worker of the pool : scan queued folders instead of blocking it.
+		// Scans are high priority, the next systems stay queued until the running ones are done
+		if (pool->runPendingWork(Utils::ThreadPool::PRIORITY_HIGH))
+			continue;
+
+		std::unique_lock<std::mutex> lock(context.lock);
+		context.done.wait_for(lock, std::chrono::milliseconds(10), [&context] { return context.pending == 0; });
+	}
+
+	// Build the tree in directory order, so the result does not depend on which task finished first
+	mergeFolder(folder, &scan, fileMap);
+
+	if (context.index != nullptr)
+		index.save();
+}
+
+void SystemData::scanFolder(ScanContext* context, FolderScan* scan)
+{
+	const std::string& folderPath = scan->path;
 	if(!Utils::FileSystem::isDirectory(folderPath))
 	{
 		LOG(LogWarning) << "SystemData::populateFolder() - ERROR: folder with path \"" << folderPath << "\" is not a directory!";
@@ -153,22 +248,18 @@ void SystemData::populateFolder(FolderData* folder, std::unordered_map<std::stri
 		}
 	}
 	
-//	std::string filePath;
 	std::string extension;
 	bool isGame;
-	bool showHidden = Settings::getInstance()->getBool("ShowHiddenFiles");
-	bool preloadMedias = Settings::getInstance()->getBool("PreloadMedias");
 	
-	Utils::FileSystem::fileList dirContent = Utils::FileSystem::getDirInfo(folderPath);
+	Utils::FileSystem::fileList dirContent = (context->index != nullptr ? context->index->getDirInfo(folderPath) : Utils::FileSystem::getDirInfo(folderPath));
 
 	for(Utils::FileSystem::fileList::const_iterator it = dirContent.cbegin(); it != dirContent.cend(); ++it)
 	{
 		auto fileInfo = *it;
-		//filePath = *it;
 		std::string filePath = fileInfo.path;
 
 		// skip hidden files and folders
-		if(!showHidden && fileInfo.hidden)
+		if(!context->showHidden && fileInfo.hidden)
 			continue;
 
 		//this is a little complicated because we allow a list of extensions to be defined (delimited with a space)
@@ -179,20 +270,22 @@ void SystemData::populateFolder(FolderData* folder, std::unordered_map<std::stri
 		//see issue #75: https://github.com/Aloshi/EmulationStation/issues/75
 		
 		isGame = false;
-		if (mEnvData->isValidExtension(extension)) //std::find(mEnvData->mSearchExtensions.cbegin(), mEnvData->mSearchExtensions.cend(), extension) != mEnvData->mSearchExtensions.cend())
+		if (mEnvData->isValidExtension(extension))
 		{
-			if (fileMap.find(filePath) == fileMap.end())
-			{
-				FileData* newGame = new FileData(GAME, filePath, this);
+			FileData* newGame = new FileData(GAME, filePath, this);
 
-				// preventing new arcade assets to be added
-				if (extension != ".zip" || !newGame->isArcadeAsset())
-				{
-					folder->addChild(newGame);
-					fileMap[filePath] = newGame;
-					isGame = true;
-				}
+			// preventing new arcade assets to be added
+			if (extension != ".zip" || !newGame->isArcadeAsset())
+			{
+				FolderScan::Entry entry;
+				entry.path = filePath;
+				entry.game = newGame;
+				entry.folder = nullptr;
+				scan->entries.push_back(entry);
+				isGame = true;
 			}
+			else
+				delete newGame;
 		}
 		
 		//add directories that also do not match an extension as folders
@@ -200,7 +293,7 @@ void SystemData::populateFolder(FolderData* folder, std::unordered_map<std::stri
 		{
 			std::string fn = Utils::String::toLower(Utils::FileSystem::getFileName(filePath));
 
-			if (preloadMedias && !mHidden)// (!mHidden || Settings::HiddenSystemsShowGames()))
+			if (context->preloadMedias && !mHidden)// (!mHidden || Settings::HiddenSystemsShowGames()))
 			{
 				// Recurse list files in medias folder, just to let OS build filesystem cache
 				if (fn == "media" || fn == "medias")
@@ -225,19 +318,67 @@ void SystemData::populateFolder(FolderData* folder, std::unordered_map<std::stri
 			if (mMetadata.name == "wiiu" && (fn == "content" || fn == "meta"))
 				continue;
 
-			FolderData* newFolder = new FolderData(filePath, this);
-			populateFolder(newFolder, fileMap);
+			FolderScan* subFolder = new FolderScan(filePath);
+
+			FolderScan::Entry entry;
+			entry.path = filePath;
+			entry.game = nullptr;
+			entry.folder = subFolder;
+			scan->entries.push_back(entry);
 
-			if (newFolder->getChildren().size() == 0)
-				delete newFolder;
+			if (context->pool == nullptr)
+			{
+				scanFolder(context, subFolder);
+				continue;
+			}
+
+			{
+				std::unique_lock<std::mutex> lock(context->lock);
+				context->pending++;
+			}
+
+			context->pool->queueWorkItem([this, context, subFolder]
+			{
+				scanFolder(context, subFolder);
+
+				std::unique_lock<std::mutex> lock(context->lock);
+				if (--context->pending == 0)
+					context->done.notify_all();
+			}, Utils::ThreadPool::PRIORITY_HIGH);
+		}
+	}
+}
+
+void SystemData::mergeFolder(FolderData* folder, FolderScan* scan, std::unordered_map<std::string, FileData*>& fileMap)
+{
+	for (auto& entry : scan->entries)
+	{
+		if (entry.game != nullptr)
+		{
+			if (fileMap.find(entry.path) == fileMap.end())
+			{
+				folder->addChild(entry.game);
+				fileMap[entry.path] = entry.game;
+			}
 			else
+				delete entry.game;
+
+			entry.game = nullptr;
+			continue;
+		}
+
+		FolderData* newFolder = new FolderData(entry.path, this);
+		mergeFolder(newFolder, entry.folder, fileMap);
+
+		if (newFolder->getChildren().size() == 0)
+			delete newFolder;
+		else
+		{
+			const std::string& key = newFolder->getPath();
+			if (fileMap.find(key) == fileMap.end())
 			{
-				const std::string& key = newFolder->getPath();
-				if (fileMap.find(key) == fileMap.end())
-				{
-					folder->addChild(newFolder);
-					fileMap[key] = newFolder;
-				}
+				folder->addChild(newFolder);
+				fileMap[key] = newFolder;
 			}
 		}
 	}
@@ -295,7 +436,7 @@ std::vector<std::string> readList(const std::string& str, const char* delims = "
 	return ret;
 }
 
-SystemData* SystemData::loadSystem(pugi::xml_node system)
+SystemData* SystemData::loadSystem(pugi::xml_node system, Utils::ThreadPool* pool)
 {
 	std::vector<EmulatorData> emulatorList;
 
@@ -406,7 +547,7 @@ SystemData* SystemData::loadSystem(pugi::xml_node system)
 	envData->mEmulators = emulatorList;
 	envData->mGroup = system.child("group").text().get();
 
-	SystemData* newSys = new SystemData(md, envData, false, false, !md.themeFolder.empty(), true);
+	SystemData* newSys = new SystemData(md, envData, false, false, !md.themeFolder.empty(), true, pool);
 	if (newSys->getRootFolder()->getChildren().size() == 0)
 	{
 		LOG(LogWarning) << "SystemData::loadSystem() - System \"" << md.name << "\" has no games! Ignoring it.";
@@ -499,6 +640,8 @@ void SystemData::createGroupedSystems()
 //creates systems from information located in a config file
 bool SystemData::loadConfig(Window* window)
 {
+	ProfileScope("SystemData::loadConfig");
+
 	deleteSystems();
 	ThemeData::setDefaultTheme(nullptr);
 
@@ -546,34 +689,30 @@ bool SystemData::loadConfig(Window* window)
 
 	int currentSystem = 0;
 
-	typedef SystemData* SystemDataPtr;
-
 	ThreadPool* pThreadPool = NULL;
-	SystemDataPtr* systems = NULL;
+	std::vector<std::future<SystemData*>> loadingSystems;
 	
 	if (Utils::Async::isCanRunAsync())
 	{
 		LOG(LogInfo) << "SystemData::loadConfig() - Thread Loading Collection Systems!";
 		pThreadPool = new ThreadPool();
-
-		systems = new SystemDataPtr[systemCount];
-		for (int i = 0; i < systemCount; i++)
-			systems[i] = nullptr;
+		loadingSystems.reserve(systemCount);
 
 		pThreadPool->queueWorkItem([] { CollectionSystemManager::get()->loadCollectionSystems(true); });
 	}
 
-	int processedSystem = 0;
+	std::atomic<int> processedSystem(0);
 	
 	for (pugi::xml_node system = systemList.child("system"); system; system = system.next_sibling("system"))
 	{		
 		if (pThreadPool != NULL)
 		{
-			pThreadPool->queueWorkItem([system, currentSystem, systems, &processedSystem]
+			loadingSystems.push_back(pThreadPool->enqueue([system, &processedSystem, pThreadPool]
 			{
-				systems[currentSystem] = loadSystem(system);
+				SystemData* pSystem = loadSystem(system, pThreadPool);
 				processedSystem++;
-			});
+				return pSystem;
+			}));
 		}
 		else
 		{
@@ -607,14 +746,13 @@ bool SystemData::loadConfig(Window* window)
 		else
 			pThreadPool->wait();
 
-		for (int i = 0; i < systemCount; i++)
+		for (auto& loadingSystem : loadingSystems)
 		{
-			SystemData* pSystem = systems[i];
+			SystemData* pSystem = loadingSystem.get();
 			if (pSystem != nullptr)
 				sSystemVector.push_back(pSystem);
 		}
 		
-		delete[] systems;
 		delete pThreadPool;
 
 		if (window != NULL)
@@ -646,8 +784,13 @@ bool SystemData::loadConfig(Window* window)
 				break;
 			}
 		}
+
+		if (window != NULL)
+			RomFolderWatcher::start(window);
 	}
 
+	ThemeData::clearDocumentCache();
+
 	return true;
 }
 
@@ -735,6 +878,8 @@ bool SystemData::hasDirtySystems()
 
 void SystemData::deleteSystems()
 {
+	RomFolderWatcher::stop();
+
 	bool saveOnExit = !Settings::getInstance()->getBool("IgnoreGamelist") && Settings::getInstance()->getBool("SaveGamelistsOnExit");
 
 	for(unsigned int i = 0; i < sSystemVector.size(); i++)
@@ -748,6 +893,8 @@ void SystemData::deleteSystems()
 	}
 
 	sSystemVector.clear();
+
+	MetaDataList::releaseStringPool();
 }
 
 std::string SystemData::getConfigPath(bool forWrite)
@@ -969,6 +1116,36 @@ void SystemData::updateDisplayedGameCount()
 	mGameCountInfo = nullptr;
 }
 
+bool SystemData::hasLocalMedia(const std::string& path)
+{
+	std::string folder = getStartPath() + "/images/";
+	if (path.size() <= folder.size() || path.compare(0, folder.size(), folder) != 0 || path.find('/', folder.size()) != std::string::npos)
+		return Utils::FileSystem::exists(path);
+
+	std::unique_lock<std::mutex> lock(mLocalMediaLock);
+
+	if (mLocalMedias == nullptr)
+	{
+		mLocalMedias = new std::unordered_set<std::string>();
+
+		for (auto file : Utils::FileSystem::getDirectoryFiles(folder))
+			if (!file.directory)
+				mLocalMedias->insert(Utils::FileSystem::getFileName(file.path));
+	}
+
+	return mLocalMedias->find(path.substr(folder.size())) != mLocalMedias->cend();
+}
+
+void SystemData::resetLocalMediaIndex()
+{
+	std::unique_lock<std::mutex> lock(mLocalMediaLock);
+
+	if (mLocalMedias != nullptr)
+		delete mLocalMedias;
+
+	mLocalMedias = nullptr;
+}
+
 void SystemData::loadTheme()
 {
 	//StopWatch watch("SystemData::loadTheme " + getName());
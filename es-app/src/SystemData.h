@@ -5,6 +5,7 @@
 #include "PlatformId.h"
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <set>
@@ -22,6 +23,8 @@ class FolderData;
 class ThemeData;
 class Window;
 
+namespace Utils { class ThreadPool; }
+
 struct EmulatorData
 {
 	std::string mName;
@@ -125,7 +128,8 @@ struct SystemEnvironmentData
 class SystemData
 {
 public:
-	SystemData(const SystemMetadata& type, SystemEnvironmentData* envData, bool CollectionSystem = false, bool groupedSystem = false, bool withTheme = true, bool loadThemeOnlyIfElements = false);
+	// scanPool : pool running the constructor, if any. Subfolders are scanned on it
+	SystemData(const SystemMetadata& type, SystemEnvironmentData* envData, bool CollectionSystem = false, bool groupedSystem = false, bool withTheme = true, bool loadThemeOnlyIfElements = false, Utils::ThreadPool* scanPool = nullptr);
 	~SystemData();
 
 	static SystemData* getSystem(const std::string name);
@@ -159,6 +163,10 @@ public:
 	GameCountInfo* getGameCountInfo();
 	void updateDisplayedGameCount();
 
+	// Answers LocalArt lookups in the "images" folder from a single listing of it
+	bool hasLocalMedia(const std::string& path);
+	void resetLocalMediaIndex();
+
 	static bool isManufacturerSupported();
 
 	static bool hasDirtySystems();
@@ -226,7 +234,7 @@ public:
 	bool shouldExtractHashesFromArchives();
 
 private:
-	static SystemData* loadSystem(pugi::xml_node system);
+	static SystemData* loadSystem(pugi::xml_node system, Utils::ThreadPool* pool = nullptr);
 	static void createGroupedSystems();
 
 	size_t mGameListHash;
@@ -246,7 +254,12 @@ private:
 
 	unsigned int mSortId;
 
-	void populateFolder(FolderData* folder, std::unordered_map<std::string, FileData*>& fileMap);
+	struct ScanContext;
+	struct FolderScan;
+
+	void populateFolder(FolderData* folder, std::unordered_map<std::string, FileData*>& fileMap, Utils::ThreadPool* pool);
+	void scanFolder(ScanContext* context, FolderScan* scan);
+	void mergeFolder(FolderData* folder, FolderScan* scan, std::unordered_map<std::string, FileData*>& fileMap);
 	void indexAllGameFilters(const FolderData* folder);
 	void setIsGameSystemStatus();
 
@@ -255,6 +268,9 @@ private:
 	FolderData* mRootFolder;
 	GameCountInfo* mGameCountInfo;
 
+	std::mutex mLocalMediaLock;
+	std::unordered_set<std::string>* mLocalMedias;
+
 	bool mHidden;
 };
 
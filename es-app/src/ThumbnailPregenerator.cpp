@@ -0,0 +1,194 @@
+#include "ThumbnailPregenerator.h"
+
+#include "components/AsyncNotificationComponent.h"
+#include "resources/TextureData.h"
+#include "resources/ThumbnailCache.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "utils/ThreadPool.h"
+#include "views/gamelist/IGameListView.h"
+#include "views/ViewController.h"
+#include "EsLocale.h"
+#include "ImageIO.h"
+#include "Log.h"
+#include "Settings.h"
+#include "SystemData.h"
+#include "Window.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#define ICONINDEX _U("\uF03E ")
+
+// Rest after each image (ms), leaves the CPU to the UI
+#define THROTTLE_DELAY 20
+
+// Signals the end of run() to stop()
+static std::mutex sLock;
+static std::condition_variable sEvent;
+
+std::atomic<ThumbnailPregenerator*> ThumbnailPregenerator::mInstance(nullptr);
+std::atomic<bool> ThumbnailPregenerator::mExit(false);
+std::atomic<bool> ThumbnailPregenerator::mPaused(false);
+
+void ThumbnailPregenerator::start(Window* window, bool createViews)
+{
+	if (mInstance != nullptr || !Settings::getInstance()->getBool("ThumbnailCache"))
+		return;
+
+	std::vector<Item> items;
+	std::set<std::string> keys;
+
+	for (auto system : SystemData::sSystemVector)
+	{
+		if (!system->isVisible())
+			continue;
+
+		auto view = ViewController::get()->getGameListView(system, createViews);
+		if (view == nullptr)
+			continue;
+
+		auto targets = view->getImageTargets();
+		if (targets.size() == 0)
+			continue;
+
+		for (auto file : system->getRootFolder()->getFilesRecursive(GAME))
+		{
+			for (auto& target : targets)
+			{
+				std::string path = target.path(file);
+				if (!ThumbnailCache::isCacheable(path))
+					continue;
+
+				// Collections & views sharing the same layout request the same images
+				std::string key = path + "|" + std::to_string((int)target.maxSize.x()) + "x" + std::to_string((int)target.maxSize.y()) + (target.maxSize.externalZoom() ? "z" : "");
+				if (keys.insert(key).second)
+					items.push_back(Item(path, target.maxSize));
+			}
+		}
+	}
+
+	LOG(LogInfo) << "ThumbnailPregenerator::start() - " << items.size() << " images to check";
+
+	if (items.size() == 0)
+		return;
+
+	std::unique_lock<std::mutex> lock(sLock);
+	mExit = false;
+	mInstance = new ThumbnailPregenerator(window, items);
+}
+
+void ThumbnailPregenerator::stop()
+{
+	std::unique_lock<std::mutex> lock(sLock);
+	if (mInstance == nullptr)
+		return;
+
+	mExit = true;
+
+	// The running image ends first, then run() unregisters the notification from the Window
+	sEvent.wait(lock, [] { return mInstance == nullptr; });
+}
+
+ThumbnailPregenerator::ThumbnailPregenerator(Window* window, const std::vector<Item>& items)
+	: mWindow(window), mItems(items), mProcessed(0), mGenerated(0)
+{
+	mWndNotification = new AsyncNotificationComponent(window, false);
+	mWindow->registerNotificationComponent(mWndNotification);
+	updateNotification();
+
+	std::thread(&ThumbnailPregenerator::run, this).detach();
+}
+
+ThumbnailPregenerator::~ThumbnailPregenerator()
+{
+	mWindow->unRegisterNotificationComponent(mWndNotification);
+	delete mWndNotification;
+}
+
+void ThumbnailPregenerator::updateNotification()
+{
+	int total = (int)mItems.size();
+	int processed = mProcessed;
+
+	mWndNotification->updateTitle(ICONINDEX + _("OPTIMIZING IMAGES") + " " + std::to_string(processed) + "/" + std::to_string(total));
+	mWndNotification->updateText(mPaused ? _("Paused") : _("Downscaling game images"));
+	mWndNotification->updatePercent(total == 0 ? -1 : processed * 100 / total);
+}
+
+void ThumbnailPregenerator::process(Item item)
+{
+	std::string path = Utils::FileSystem::getCanonicalPath(item.path);
+	if (path.empty() || Utils::String::toLower(Utils::FileSystem::getExtension(path)) == ".svg" || !Utils::FileSystem::exists(path))
+		return;
+
+	// Same setup as TextureResource, so the thumbnail matches the one the view will look for
+	TextureData data(false, false);
+	data.setMaxSize(item.maxSize);
+	data.initFromPath(path);
+
+	Vector2i maxSize = data.getMaxImageSize();
+	if (maxSize.x() <= 0 || maxSize.y() <= 0)
+		return;
+
+	if (ThumbnailCache::exists(path, maxSize.x(), maxSize.y(), item.maxSize.externalZoom()))
+		return;
+
+	// Images that already fit are never downscaled, there is nothing to store
+	unsigned int width, height;
+	if (ImageIO::loadImageSize(path.c_str(), &width, &height) && (int)width <= maxSize.x() && (int)height <= maxSize.y())
+		return;
+
+	// Decoding the image stores the thumbnail
+	if (data.load(true))
+		mGenerated++;
+}
+
+void ThumbnailPregenerator::run()
+{
+	LOG(LogDebug) << "ThumbnailPregenerator::run() - Started";
+
+	int threads = std::thread::hardware_concurrency() / 4;
+	if (threads < 1)
+		threads = 1;
+
+	{
+		Utils::ThreadPool pool(threads);
+
+		for (auto item : mItems)
+		{
+			pool.queueWorkItem([this, item]
+			{
+				// Don't compete with a running game
+				while (mPaused && !mExit)
+					std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+				if (mExit)
+					return;
+
+				process(item);
+				mProcessed++;
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(THROTTLE_DELAY));
+			}, Utils::ThreadPool::PRIORITY_LOW);
+		}
+
+		pool.wait([this] { updateNotification(); }, 250);
+	}
+
+	LOG(LogInfo) << "ThumbnailPregenerator::run() - " << mGenerated << " images downscaled, " << mProcessed << " checked";
+
+	if (!mExit && mGenerated > 0)
+		mWindow->displayNotificationMessage(ICONINDEX + _("GAME IMAGES OPTIMIZED"));
+
+	delete this;
+
+	{
+		std::unique_lock<std::mutex> lock(sLock);
+		ThumbnailPregenerator::mInstance = nullptr;
+	}
+
+	sEvent.notify_all();
+}
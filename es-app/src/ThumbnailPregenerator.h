@@ -0,0 +1,59 @@
+#pragma once
+#ifndef ES_APP_THUMBNAIL_PREGENERATOR_H
+#define ES_APP_THUMBNAIL_PREGENERATOR_H
+
+#include "resources/TextureResource.h"
+#include <atomic>
+#include <string>
+#include <vector>
+
+class Window;
+class AsyncNotificationComponent;
+
+// Time without input after boot (ms) before the job starts by itself
+#define THUMBNAIL_PREGENERATION_IDLE_DELAY 15000
+
+// Background job filling the ThumbnailCache with the images the gamelist views of every system display,
+// downscaled to the sizes the current theme asks for. Runs on a few low priority threads, with a rest after each image.
+class ThumbnailPregenerator
+{
+public:
+	// Collects the images from the gamelist views. Systems without a view are skipped, unless createViews is set
+	static void start(Window* window, bool createViews = false);
+	// Waits for the job to end : it must not outlive the Window
+	static void stop();
+	static bool isRunning() { return mInstance != nullptr; }
+
+	// The job waits while a game is running
+	static void pause() { mPaused = true; }
+	static void resume() { mPaused = false; }
+
+private:
+	struct Item
+	{
+		Item(const std::string& _path, const MaxSizeInfo& _maxSize) : path(_path), maxSize(_maxSize) { }
+
+		std::string path;
+		MaxSizeInfo maxSize;
+	};
+
+	ThumbnailPregenerator(Window* window, const std::vector<Item>& items);
+	~ThumbnailPregenerator();
+
+	void run();
+	void process(Item item);
+	void updateNotification();
+
+	Window*						mWindow;
+	AsyncNotificationComponent*	mWndNotification;
+
+	std::vector<Item>			mItems;
+	std::atomic<int>			mProcessed;
+	std::atomic<int>			mGenerated;
+
+	static std::atomic<bool>	mExit;
+	static std::atomic<bool>	mPaused;
+	static std::atomic<ThumbnailPregenerator*> mInstance;
+};
+
+#endif // ES_APP_THUMBNAIL_PREGENERATOR_H
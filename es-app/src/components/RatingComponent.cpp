@@ -167,6 +167,11 @@ bool RatingComponent::input(InputConfig* config, Input input)
 
 void RatingComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {
+	static const ThemeData::PropertyId idFilledPath = ThemeData::getPropertyId("filledPath");
+	static const ThemeData::PropertyId idUnfilledPath = ThemeData::getPropertyId("unfilledPath");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idUnfilledColor = ThemeData::getPropertyId("unfilledColor");
+
 	GuiComponent::applyTheme(theme, view, element, properties);
 
 	using namespace ThemeFlags;
@@ -176,25 +181,25 @@ void RatingComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const
 		return;
 
 	bool imgChanged = false;
-	if(properties & PATH && elem->has("filledPath"))
+	if(properties & PATH && elem->has(idFilledPath))
 	{
-		mFilledTexture = TextureResource::get(elem->get<std::string>("filledPath"), true);
+		mFilledTexture = TextureResource::get(elem->get<std::string>(idFilledPath), true);
 		imgChanged = true;
 	}
-	if(properties & PATH && elem->has("unfilledPath"))
+	if(properties & PATH && elem->has(idUnfilledPath))
 	{
-		mUnfilledTexture = TextureResource::get(elem->get<std::string>("unfilledPath"), true);
+		mUnfilledTexture = TextureResource::get(elem->get<std::string>(idUnfilledPath), true);
 		imgChanged = true;
 	}
 
 
 	if (properties & COLOR)
 	{
-		if (elem->has("color"))
-			setColorShift(elem->get<unsigned int>("color"));
+		if (elem->has(idColor))
+			setColorShift(elem->get<unsigned int>(idColor));
 
-		if (elem->has("unfilledColor"))
-			mUnfilledColor = elem->get<unsigned int>("unfilledColor");
+		if (elem->has(idUnfilledColor))
+			mUnfilledColor = elem->get<unsigned int>(idUnfilledColor);
 		else
 			mUnfilledColor = mColorShift;
 	}
@@ -425,6 +425,22 @@ void TextListComponent<T>::onCursorChanged(const CursorState& state)
 template <typename T>
 void TextListComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {
+	static const ThemeData::PropertyId idSelectorColor = ThemeData::getPropertyId("selectorColor");
+	static const ThemeData::PropertyId idSelectorColorEnd = ThemeData::getPropertyId("selectorColorEnd");
+	static const ThemeData::PropertyId idSelectorGradientType = ThemeData::getPropertyId("selectorGradientType");
+	static const ThemeData::PropertyId idSelectedColor = ThemeData::getPropertyId("selectedColor");
+	static const ThemeData::PropertyId idPrimaryColor = ThemeData::getPropertyId("primaryColor");
+	static const ThemeData::PropertyId idSecondaryColor = ThemeData::getPropertyId("secondaryColor");
+	static const ThemeData::PropertyId idScrollSound = ThemeData::getPropertyId("scrollSound");
+	static const ThemeData::PropertyId idAlignment = ThemeData::getPropertyId("alignment");
+	static const ThemeData::PropertyId idHorizontalMargin = ThemeData::getPropertyId("horizontalMargin");
+	static const ThemeData::PropertyId idForceUppercase = ThemeData::getPropertyId("forceUppercase");
+	static const ThemeData::PropertyId idLineSpacing = ThemeData::getPropertyId("lineSpacing");
+	static const ThemeData::PropertyId idSelectorHeight = ThemeData::getPropertyId("selectorHeight");
+	static const ThemeData::PropertyId idSelectorOffsetY = ThemeData::getPropertyId("selectorOffsetY");
+	static const ThemeData::PropertyId idSelectorImagePath = ThemeData::getPropertyId("selectorImagePath");
+	static const ThemeData::PropertyId idSelectorImageTile = ThemeData::getPropertyId("selectorImageTile");
+
 	GuiComponent::applyTheme(theme, view, element, properties);
 
 	const ThemeData::ThemeElement* elem = theme->getElement(view, element, "textlist");
@@ -434,35 +450,35 @@ void TextListComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme, c
 	using namespace ThemeFlags;
 	if(properties & COLOR)
 	{
-		if(elem->has("selectorColor"))
+		if(elem->has(idSelectorColor))
 		{
-			setSelectorColor(elem->get<unsigned int>("selectorColor"));
-			setSelectorColorEnd(elem->get<unsigned int>("selectorColor"));
+			setSelectorColor(elem->get<unsigned int>(idSelectorColor));
+			setSelectorColorEnd(elem->get<unsigned int>(idSelectorColor));
 		}
-		if (elem->has("selectorColorEnd"))
-			setSelectorColorEnd(elem->get<unsigned int>("selectorColorEnd"));
-		if (elem->has("selectorGradientType"))
-			setSelectorColorGradientHorizontal(!(elem->get<std::string>("selectorGradientType").compare("horizontal")));
-		if(elem->has("selectedColor"))
-			setSelectedColor(elem->get<unsigned int>("selectedColor"));
-		if(elem->has("primaryColor"))
-			setColor(0, elem->get<unsigned int>("primaryColor"));
-		if(elem->has("secondaryColor"))
-			setColor(1, elem->get<unsigned int>("secondaryColor"));
+		if (elem->has(idSelectorColorEnd))
+			setSelectorColorEnd(elem->get<unsigned int>(idSelectorColorEnd));
+		if (elem->has(idSelectorGradientType))
+			setSelectorColorGradientHorizontal(!(elem->get<std::string>(idSelectorGradientType).compare("horizontal")));
+		if(elem->has(idSelectedColor))
+			setSelectedColor(elem->get<unsigned int>(idSelectedColor));
+		if(elem->has(idPrimaryColor))
+			setColor(0, elem->get<unsigned int>(idPrimaryColor));
+		if(elem->has(idSecondaryColor))
+			setColor(1, elem->get<unsigned int>(idSecondaryColor));
 	}
 
 	setFont(Font::getFromTheme(elem, properties, mFont));
 	const float selectorHeight = Math::max(mFont->getHeight(1.0), (float)mFont->getSize()) * mLineSpacing;
 	setSelectorHeight(selectorHeight);
 
-	if(properties & SOUND && elem->has("scrollSound"))
-		mScrollSound = elem->get<std::string>("scrollSound");
+	if(properties & SOUND && elem->has(idScrollSound))
+		mScrollSound = elem->get<std::string>(idScrollSound);
 
 	if(properties & ALIGNMENT)
 	{
-		if(elem->has("alignment"))
+		if(elem->has(idAlignment))
 		{
-			const std::string& str = elem->get<std::string>("alignment");
+			const std::string& str = elem->get<std::string>(idAlignment);
 			if(str == "left")
 				setAlignment(ALIGN_LEFT);
 			else if(str == "center")
@@ -472,36 +488,36 @@ void TextListComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme, c
 			else
 				LOG(LogError) << "TextListComponent<T>::applyTheme() - ERROR: Unknown TextListComponent alignment \"" << str << "\"!";
 		}
-		if(elem->has("horizontalMargin"))
+		if(elem->has(idHorizontalMargin))
 		{
-			mHorizontalMargin = elem->get<float>("horizontalMargin") * (this->mParent ? this->mParent->getSize().x() : (float)Renderer::getScreenWidth());
+			mHorizontalMargin = elem->get<float>(idHorizontalMargin) * (this->mParent ? this->mParent->getSize().x() : (float)Renderer::getScreenWidth());
 		}
 	}
 
-	if(properties & FORCE_UPPERCASE && elem->has("forceUppercase"))
-		setUppercase(elem->get<bool>("forceUppercase"));
+	if(properties & FORCE_UPPERCASE && elem->has(idForceUppercase))
+		setUppercase(elem->get<bool>(idForceUppercase));
 
 	if(properties & LINE_SPACING)
 	{
-		if(elem->has("lineSpacing"))
-			setLineSpacing(elem->get<float>("lineSpacing"));
-		if(elem->has("selectorHeight"))
+		if(elem->has(idLineSpacing))
+			setLineSpacing(elem->get<float>(idLineSpacing));
+		if(elem->has(idSelectorHeight))
 		{
-			setSelectorHeight(elem->get<float>("selectorHeight") * Renderer::getScreenHeight());
+			setSelectorHeight(elem->get<float>(idSelectorHeight) * Renderer::getScreenHeight());
 		}
-		if(elem->has("selectorOffsetY"))
+		if(elem->has(idSelectorOffsetY))
 		{
 			float scale = this->mParent ? this->mParent->getSize().y() : (float)Renderer::getScreenHeight();
-			setSelectorOffsetY(elem->get<float>("selectorOffsetY") * scale);
+			setSelectorOffsetY(elem->get<float>(idSelectorOffsetY) * scale);
 		} else {
 			setSelectorOffsetY(0.0);
 		}
 	}
 
-	if (elem->has("selectorImagePath"))
+	if (elem->has(idSelectorImagePath))
 	{
-		std::string path = elem->get<std::string>("selectorImagePath");
-		bool tile = elem->has("selectorImageTile") && elem->get<bool>("selectorImageTile");
+		std::string path = elem->get<std::string>(idSelectorImagePath);
+		bool tile = elem->has(idSelectorImageTile) && elem->get<bool>(idSelectorImageTile);
 		mSelectorImage.setImage(path, tile);
 		mSelectorImage.setSize(mSize.x(), mSelectorHeight);
 		mSelectorImage.setColorShift(mSelectorColor);
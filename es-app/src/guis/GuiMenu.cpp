@@ -26,6 +26,13 @@
 #include "views/UIModeController.h"
 #include "views/ViewController.h"
 #include "CollectionSystemManager.h"
+#include "GamelistCache.h"
+#include "RomDirectoryIndex.h"
+#include "ThemeCache.h"
+#include "resources/ThumbnailCache.h"
+#include "ThumbnailPregenerator.h"
+#include "SystemMetrics.h"
+#include "RomFolderWatcher.h"
 #include "EmulationStation.h"
 #include "Scripting.h"
 #include "SystemData.h"
@@ -153,6 +160,32 @@ GuiMenu::GuiMenu(Window* window, bool animate) : GuiComponent(window), mMenu(win
 	}
 }
 
+GuiMenu::~GuiMenu()
+{
+	// The values may come after the menu is closed
+	if (mPrefetching != nullptr)
+		*mPrefetching = false;
+}
+
+// The script getters of the screen are read off the UI thread, then func builds it with their values
+void GuiMenu::openAfterPrefetch(const std::vector<ApiSystem::ScriptId>& scripts, const std::function<void()>& func)
+{
+	if (mPrefetching != nullptr)
+		return;
+
+	auto pending = std::make_shared<bool>(true);
+	mPrefetching = pending;
+
+	ApiSystem::getInstance()->prefetchScriptOutputs(scripts, mWindow, [this, pending, func]
+	{
+		if (!*pending)
+			return;
+
+		mPrefetching = nullptr;
+		func();
+	});
+}
+
 void GuiMenu::openDisplaySettings()
 {
 	auto pthis = this;
@@ -243,7 +276,8 @@ void GuiMenu::openDisplaySettings()
 
 void GuiMenu::openDisplayAutoDimSettings()
 {
-	mWindow->pushGui(new GuiDisplayAutoDimOptions(mWindow));
+	Window* window = mWindow;
+	openAfterPrefetch({ ApiSystem::DISPLAY }, [window] { window->pushGui(new GuiDisplayAutoDimOptions(window)); });
 }
 
 void GuiMenu::openControllersSettings()
@@ -1389,7 +1423,9 @@ void GuiMenu::openNetworkSettings(bool selectWifiEnable, bool selectManualWifiDn
 	auto ip = std::make_shared<UpdatableTextComponent>(mWindow, ApiSystem::getInstance()->getIpAddress(), font, color);
 	s->addWithLabel(_("IP ADDRESS"), ip);
 
-	auto status = std::make_shared<TextComponent>(mWindow, formatNetworkStatus( ApiSystem::getInstance()->getInternetStatus() ), font, color);
+	// The pings can take seconds, the status is filled when they are done
+	auto status = std::make_shared<TextComponent>(mWindow, "", font, color);
+	ApiSystem::getInstance()->getInternetStatusAsync(window, [status](bool connected) { status->setText(formatNetworkStatus(connected)); });
 	s->addWithLabel(_("INTERNET STATUS"), status);
 
 	// Network Indicator
@@ -1668,10 +1704,10 @@ void GuiMenu::openNetworkSettings(bool selectWifiEnable, bool selectManualWifiDn
 	if (selectWifiEnable || selectManualWifiDnsEnable)
 	{
 		s->clear();
-		ip->setUpdatableFunction([ip, status]
+		ip->setUpdatableFunction([window, ip, status]
 			{
 				ip->setText(ApiSystem::getInstance()->getIpAddress());
-				status->setText(formatNetworkStatus( ApiSystem::getInstance()->getInternetStatus() ));
+				ApiSystem::getInstance()->getInternetStatusAsync(window, [status](bool connected) { status->setText(formatNetworkStatus(connected)); });
 			}, 5000);
 		s->addUpdatableComponent(ip.get());
 	}
@@ -1754,6 +1790,11 @@ void GuiMenu::openUpdateSettings()
 
 
 void GuiMenu::openAdvancedSettings()
+{
+	openAfterPrefetch({ ApiSystem::OVERCLOCK, ApiSystem::SHOW_FPS, ApiSystem::LOG_SCRIPTS }, [this] { pushAdvancedSettings(); });
+}
+
+void GuiMenu::pushAdvancedSettings()
 {
 	Window* window = mWindow;
 	auto s = new GuiSettings(mWindow, _("ADVANCED SETTINGS"));
@@ -1904,6 +1945,35 @@ void GuiMenu::openAdvancedSettings()
 	s->addWithLabel(_("PARSE GAMESLISTS ONLY"), parse_gamelists);
 	s->addSaveFunc([parse_gamelists] { Settings::getInstance()->setBool("ParseGamelistOnly", parse_gamelists->getState()); });
 
+	auto gamelist_cache = std::make_shared<SwitchComponent>(mWindow, Settings::getInstance()->getBool("GamelistCache"));
+	s->addWithDescription(_("CACHE GAMELISTS"), _("Keeps a binary copy of each gamelist to speed up boot."), gamelist_cache);
+	s->addSaveFunc([gamelist_cache]
+	{
+		if (Settings::getInstance()->setBool("GamelistCache", gamelist_cache->getState()) && !gamelist_cache->getState())
+			GamelistCache::clear();
+	});
+
+	auto rom_index = std::make_shared<SwitchComponent>(mWindow, Settings::getInstance()->getBool("RomDirectoryIndex"));
+	s->addWithDescription(_("INDEX ROM FOLDERS"), _("Only lists again the folders modified since the last boot."), rom_index);
+	s->addSaveFunc([rom_index]
+	{
+		if (Settings::getInstance()->setBool("RomDirectoryIndex", rom_index->getState()) && !rom_index->getState())
+			RomDirectoryIndex::clear();
+	});
+
+	auto watch_roms = std::make_shared<SwitchComponent>(mWindow, Settings::getInstance()->getBool("WatchRomFolders"));
+	s->addWithDescription(_("WATCH ROM FOLDERS"), _("Adds or removes games when files are copied or deleted."), watch_roms);
+	s->addSaveFunc([this, watch_roms]
+	{
+		if (Settings::getInstance()->setBool("WatchRomFolders", watch_roms->getState()))
+		{
+			if (watch_roms->getState())
+				RomFolderWatcher::start(mWindow);
+			else
+				RomFolderWatcher::stop();
+		}
+	});
+
 	auto local_art = std::make_shared<SwitchComponent>(mWindow, Settings::getInstance()->getBool("LocalArt"));
 	s->addWithLabel(_("SEARCH FOR LOCAL ART"), local_art);
 	s->addSaveFunc([local_art] { Settings::getInstance()->setBool("LocalArt", local_art->getState()); });
@@ -1921,6 +1991,37 @@ void GuiMenu::openAdvancedSettings()
 	auto preloadUI = std::make_shared<SwitchComponent>(mWindow, Settings::getInstance()->getBool("PreloadUI"));
 	s->addWithLabel(_("PRELOAD UI"), preloadUI);
 	s->addSaveFunc([preloadUI] { Settings::getInstance()->setBool("PreloadUI", preloadUI->getState()); });
+
+	// theme cache
+	auto theme_cache = std::make_shared<SwitchComponent>(mWindow, Settings::getInstance()->getBool("ThemeCache"));
+	s->addWithDescription(_("CACHE THEMES"), _("Keeps the resolved theme of each system to skip the xml files at boot."), theme_cache);
+	s->addSaveFunc([theme_cache]
+	{
+		if (Settings::getInstance()->setBool("ThemeCache", theme_cache->getState()) && !theme_cache->getState())
+			ThemeCache::clear();
+	});
+
+	// thumbnail cache
+	auto thumbnail_cache = std::make_shared<SwitchComponent>(mWindow, Settings::getInstance()->getBool("ThumbnailCache"));
+	s->addWithDescription(_("CACHE SCALED IMAGES"), _("Keeps the downscaled game images on disk so they are not decoded at full size again."), thumbnail_cache);
+	s->addSaveFunc([thumbnail_cache]
+	{
+		if (Settings::getInstance()->setBool("ThumbnailCache", thumbnail_cache->getState()) && !thumbnail_cache->getState())
+			ThumbnailCache::clear();
+	});
+
+	// thumbnail pregeneration
+	auto pregenerate_thumbnails = std::make_shared<SwitchComponent>(mWindow, Settings::getInstance()->getBool("PregenerateThumbnails"));
+	s->addWithDescription(_("SCALE IMAGES WHEN IDLE"), _("Downscales the game images in the background after boot and after scraping."), pregenerate_thumbnails);
+	s->addSaveFunc([pregenerate_thumbnails] { Settings::getInstance()->setBool("PregenerateThumbnails", pregenerate_thumbnails->getState()); });
+
+	s->addEntry(_("SCALE GAME IMAGES NOW"), false, [this]
+	{
+		if (ThumbnailPregenerator::isRunning())
+			mWindow->pushGui(new GuiMsgBox(mWindow, _("GAME IMAGES ARE ALREADY BEING SCALED.")));
+		else
+			ThumbnailPregenerator::start(mWindow, true);
+	});
 	
 	// optimize VRAM
 	auto optimizeVram = std::make_shared<SwitchComponent>(mWindow, Settings::getInstance()->getBool("OptimizeVRAM"));
@@ -2120,8 +2221,6 @@ void GuiMenu::openAdvancedSettings()
 	{
 		if (Settings::getInstance()->setString("LogLevel", logLevel->getSelected() == "default" ? "" : logLevel->getSelected()))
 		{
-			Log::setupReportingLevel();
-			Log::init();
 			if (ApiSystem::getInstance()->isScriptingSupported(ApiSystem::ScriptId::LOG_SCRIPTS) && ApiSystem::getInstance()->isEsScriptsLoggingActivated())
 				ApiSystem::getInstance()->setEsScriptsLoggingLevel(logLevel->getSelected());
 		}
@@ -2134,8 +2233,6 @@ void GuiMenu::openAdvancedSettings()
 		if (old_value != logWithMilliseconds->getState())
 		{
 			Settings::getInstance()->setBool("LogWithMilliseconds", logWithMilliseconds->getState());
-			Log::setupReportingLevel();
-			Log::init();
 		}
 	});
 
@@ -2186,22 +2283,26 @@ void GuiMenu::openQuitSettings()
 
 void GuiMenu::openPowerkeySettings()
 {
-	mWindow->pushGui(new GuiPowerkeyOptions(mWindow));
+	Window* window = mWindow;
+	openAfterPrefetch({ ApiSystem::POWER_KEY }, [window] { window->pushGui(new GuiPowerkeyOptions(window)); });
 }
 
 void GuiMenu::openAutoSuspendSettings()
 {
-	mWindow->pushGui(new GuiAutoSuspendOptions(mWindow));
+	Window* window = mWindow;
+	openAfterPrefetch({ ApiSystem::AUTO_SUSPEND }, [window] { window->pushGui(new GuiAutoSuspendOptions(window)); });
 }
 
 void GuiMenu::openSystemHotkeyEventsSettings()
 {
-	mWindow->pushGui(new GuiSystemHotkeyEventsOptions(mWindow));
+	Window* window = mWindow;
+	openAfterPrefetch({ ApiSystem::SYSTEM_HOTKEY_EVENTS }, [window] { window->pushGui(new GuiSystemHotkeyEventsOptions(window)); });
 }
 
 void GuiMenu::openRetroAchievementsSettings()
 {
-	mWindow->pushGui(new GuiRetroachievementsOptions(mWindow));
+	Window* window = mWindow;
+	openAfterPrefetch({ ApiSystem::RETROACHIVEMENTS }, [window] { window->pushGui(new GuiRetroachievementsOptions(window)); });
 }
 
 void GuiMenu::openMenusSettings()
@@ -2495,7 +2596,8 @@ void GuiMenu::addVersionInfo()
 }
 
 void GuiMenu::openScreensaverOptions() {
-	mWindow->pushGui(new GuiGeneralScreensaverOptions(mWindow, _("SCREENSAVER SETTINGS")));
+	Window* window = mWindow;
+	openAfterPrefetch({ ApiSystem::DISPLAY, ApiSystem::AUTO_SUSPEND }, [window] { window->pushGui(new GuiGeneralScreensaverOptions(window, _("SCREENSAVER SETTINGS"))); });
 }
 
 void GuiMenu::openCollectionSystemSettings() 
@@ -2751,7 +2853,9 @@ void GuiMenu::addStatusBarInfo(Window* mWindow)
 	{
 		row.addElement(std::make_shared<TextComponent>(mWindow, text.append("NTW: "), font, color), false);
 	}
-	bool status = ApiSystem::getInstance()->isNetworkConnected();
+	// Shown from the last sample first, es-wifi answers later
+	auto metrics = SystemMetrics::get();
+	bool status = metrics != nullptr && metrics->network.isConnected;
 	iconPath = getIconNetwork(status);
 	text.clear();
 	if (!iconPath.empty())
@@ -2763,10 +2867,15 @@ void GuiMenu::addStatusBarInfo(Window* mWindow)
 		icon->setResize(0, theme->Text.font->getLetterHeight() * 1.50f);
 		row.addElement(icon, false, false);		
 		row.addElement(spacer, false);
+
+		ApiSystem::getInstance()->isNetworkConnectedAsync(mWindow, [icon](bool connected) { icon->setImage(getIconNetwork(connected)); });
 	}
 	else
 	{
-		row.addElement(std::make_shared<TextComponent>(mWindow, text.append(formatNetworkStatus(status)), font, color), false);
+		auto networkStatus = std::make_shared<TextComponent>(mWindow, text.append(formatNetworkStatus(status)), font, color);
+		row.addElement(networkStatus, false);
+
+		ApiSystem::getInstance()->isNetworkConnectedAsync(mWindow, [networkStatus](bool connected) { networkStatus->setText(formatNetworkStatus(connected)); });
 	}
 	
 	mMenu.addRow(row);
@@ -5,6 +5,7 @@
 #include "components/MenuComponent.h"
 #include "components/OptionListComponent.h"
 #include "GuiComponent.h"
+#include "ApiSystem.h"
 
 class GuiSettings;
 class SystemData;
@@ -13,6 +14,7 @@ class GuiMenu : public GuiComponent
 {
 public:
 	GuiMenu(Window* window, bool animate = true);
+	~GuiMenu();
 
 	bool input(InputConfig* config, Input input) override;
 	void onSizeChanged() override;
@@ -30,7 +32,9 @@ private:
 	void addVersionInfo();
 	void openCollectionSystemSettings();
 	void openConfigInput();
+	void openAfterPrefetch(const std::vector<ApiSystem::ScriptId>& scripts, const std::function<void()>& func);
 	void openAdvancedSettings();
+	void pushAdvancedSettings();
 	void openQuitMenu();
 	void openControllersSettings();
 	void openScraperSettings();
@@ -68,6 +72,8 @@ private:
 	MenuComponent mMenu;
 	TextComponent mVersion;
 
+	std::shared_ptr<bool> mPrefetching; // Set while a screen waits for its values, false once the menu is deleted
+
 };
 
 #endif // ES_APP_GUIS_GUI_MENU_H
@@ -12,6 +12,7 @@
 #include "components/UpdatableTextComponent.h"
 #include "ApiSystem.h"
 #include "renderers/Renderer.h"
+#include "SystemMetrics.h"
 
 
 GuiSystemInformation::GuiSystemInformation(Window* window) : UpdatableGuiSettings(window, _("SYSTEM INFORMATION").c_str())
@@ -41,6 +42,7 @@ void GuiSystemInformation::showSummarySystemInfo()
 	unsigned int color = theme->Text.color;
 
 	UpdatableGuiSettings *pthis = this;
+	Window* window = mWindow;
 
 	CpuAndSocketInformation csi = ApiSystem::getInstance()->getCpuAndChipsetInformation();
 	DisplayAndGpuInformation di = ApiSystem::getInstance()->getDisplayAndGpuInformation();
@@ -131,19 +133,20 @@ void GuiSystemInformation::showSummarySystemInfo()
 	// connected to network
 	auto networkStatus = std::make_shared<UpdatableTextComponent>(mWindow, formatNetworkStatus( ni.isConnected ), font, color);
 
-	// acces to internet
-	auto internetStatus = std::make_shared<TextComponent>(mWindow, formatNetworkStatus( ApiSystem::getInstance()->getInternetStatus() ), font, color);
+	// acces to internet, the pings can take seconds
+	auto internetStatus = std::make_shared<TextComponent>(mWindow, "", font, color);
+	ApiSystem::getInstance()->getInternetStatusAsync(window, [internetStatus](bool connected) { internetStatus->setText(formatNetworkStatus(connected)); });
 
 	// Wifi ssid
 	auto wifiSsid = std::make_shared<TextComponent>(mWindow, ni.ssid, font, color);
 	// IP address
 	auto ipAddress = std::make_shared<TextComponent>(mWindow, ni.ip_address, font, color);
-	networkStatus->setUpdatableFunction([networkStatus, internetStatus, wifiSsid, ipAddress, color]
+	networkStatus->setUpdatableFunction([window, networkStatus, internetStatus, wifiSsid, ipAddress, color]
 		{
 			LOG(LogDebug) << "GuiSystemInformation::showSummarySystemInfo() - update network status";
 			NetworkInformation ni = ApiSystem::getInstance()->getNetworkInformation();
 			networkStatus->setText(formatNetworkStatus( ni.isConnected ));
-			internetStatus->setText(formatNetworkStatus( ApiSystem::getInstance()->getInternetStatus() ));
+			ApiSystem::getInstance()->getInternetStatusAsync(window, [internetStatus](bool connected) { internetStatus->setText(formatNetworkStatus(connected)); });
 			if (ni.isConnected)
 			{
 				wifiSsid->setText(ni.ssid);
@@ -484,11 +487,20 @@ void GuiSystemInformation::openNetwork()
 
 	auto s = new UpdatableGuiSettings(window, _("NETWORK"));
 
-	NetworkInformation ni = ApiSystem::getInstance()->getNetworkInformation(false);
+	// nmcli runs on the SystemMetrics thread while the page is open. Until the first detailed sample, only the summary is shown
+	std::shared_ptr<void> networkDetails = SystemMetrics::requestNetworkDetails();
+	NetworkInformation ni = ApiSystem::getInstance()->getNetworkInformation();
 
 // connected to network
 	auto status = std::make_shared<UpdatableTextComponent>(window, formatNetworkStatus( ni.isConnected ), font, color);
-	auto internetStatus = std::make_shared<TextComponent>(mWindow, formatNetworkStatus( ApiSystem::getInstance()->getInternetStatus() ), font, color);
+	auto internetStatus = std::make_shared<UpdatableTextComponent>(window, "", font, color);
+	ApiSystem::getInstance()->getInternetStatusAsync(window, [internetStatus](bool connected) { internetStatus->setText(formatNetworkStatus(connected)); });
+	internetStatus->setUpdatableFunction([window, internetStatus]
+		{
+			ApiSystem::getInstance()->getInternetStatusAsync(window, [internetStatus](bool connected) { internetStatus->setText( formatNetworkStatus( connected ) ); });
+		}, 10000);
+	s->addUpdatableComponent(internetStatus.get());
+
 	auto isWifi = std::make_shared<TextComponent>(window, _( Utils::String::boolToString(ni.isWifi, true) ), font, color);
 	auto address = std::make_shared<TextComponent>(window, ni.ip_address, font, color);
 	auto netmask = std::make_shared<TextComponent>(window, ni.netmask, font, color);
@@ -502,12 +514,15 @@ void GuiSystemInformation::openNetwork()
 	auto channel = std::make_shared<TextComponent>(window, std::to_string(ni.channel), font, color);
 	auto security = std::make_shared<TextComponent>(window, ni.security, font, color);
 
-	status->setUpdatableFunction([status, internetStatus, isWifi, ssid, address, netmask, gateway, mac, dns1, dns2, signal, channel, security, rate]
+	// Reads the last sample : setText ignores unchanged values
+	status->setUpdatableFunction([networkDetails, status, isWifi, ssid, address, netmask, gateway, mac, dns1, dns2, signal, channel, security, rate]
 		{
-			LOG(LogDebug) << "GuiSystemInformation::showSummarySystemInfo() - update network";
-			NetworkInformation ni = ApiSystem::getInstance()->getNetworkInformation(false);
+			auto metrics = SystemMetrics::get();
+			if (metrics == nullptr || !metrics->networkDetailed)
+				return;
+
+			const NetworkInformation& ni = metrics->network;
 			status->setText( formatNetworkStatus( ni.isConnected ) );
-			internetStatus->setText( formatNetworkStatus( ApiSystem::getInstance()->getInternetStatus() ) );
 			isWifi->setText( "" );
 			address->setText( "" );
 			netmask->setText( "" );
@@ -538,7 +553,7 @@ void GuiSystemInformation::openNetwork()
 					security->setText( ni.security );
 				}
 			}
-		}, 10000);
+		}, 1000);
 	s->addUpdatableComponent(status.get());
 
 	s->addWithLabel(_("STATUS"), status);
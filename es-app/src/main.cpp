@@ -5,13 +5,12 @@
 #include "guis/GuiMsgBox.h"
 #include "utils/FileSystemUtil.h"
 
-#if defined(USE_PROFILING)
 #include "utils/ProfilingUtil.h"
-#endif // USE_PROFILING
 
 #include "views/ViewController.h"
 #include "CollectionSystemManager.h"
 #include "EmulationStation.h"
+#include "FileSorts.h"
 #include "InputManager.h"
 #include "Log.h"
 #include "MameNames.h"
@@ -34,8 +33,11 @@
 #include "AudioManager.h"
 #include "NetworkThread.h"
 #include "scrapers/ThreadedScraper.h"
+#include "ThumbnailPregenerator.h"
 #include "ImageIO.h"
 #include "ApiSystem.h"
+#include "SystemMetrics.h"
+#include "CommandExecutor.h"
 
 #include <future>
 #include "utils/AsyncUtil.h"
@@ -430,6 +432,9 @@ int main(int argc, char* argv[])
 	//start the logger
 	Log::setupReportingLevel();
 	Log::init();
+	Settings::getInstance()->addChangeListener("LogLevel", [] { Log::setupReportingLevel(); Log::init(); });
+	Settings::getInstance()->addChangeListener("Language", [] { FileSorts::invalidateSortKeys(); });
+	Settings::getInstance()->addChangeListener("IgnoreLeadingArticles", [] { FileSorts::invalidateSortKeys(); });
 	LOG(LogInfo) << "MAIN::main() - EmulationStation - v" << PROGRAM_VERSION_STRING << ", built " << PROGRAM_BUILT_STRING;
 
 	if (!async_log.empty())
@@ -478,6 +483,7 @@ int main(int argc, char* argv[])
 	Window window;
 	SystemScreenSaver screensaver(&window);
 	PowerSaver::init();
+	SystemMetrics::start();
 	ViewController::init(&window);
 	CollectionSystemManager::init(&window);
 	MameNames::init();
@@ -590,10 +596,16 @@ int main(int argc, char* argv[])
 							 ps_time = lastTime;
 	int exitMode = 0;
 
+	// Downscale the game images in the background once the user leaves ES alone for a while after boot
+	bool pregenerateThumbnails = Settings::getInstance()->getBool("PregenerateThumbnails");
+
 	bool running = true;
 
+	ProfileThreadName("Main");
+
 	while(running)
 	{
+		ProfileFrame();
 
 		SDL_Event event;
 		bool ps_standby = PowerSaver::getState() && (int) SDL_GetTicks() - ps_time > PowerSaver::getMode();
@@ -641,6 +653,12 @@ int main(int argc, char* argv[])
 
 		processAudioTitles(&window);
 
+		if (pregenerateThumbnails && curTime - ps_time > THUMBNAIL_PREGENERATION_IDLE_DELAY)
+		{
+			pregenerateThumbnails = false;
+			ThumbnailPregenerator::start(&window);
+		}
+
 		window.update(deltaTime);
 		window.render();
 
@@ -656,6 +674,9 @@ int main(int argc, char* argv[])
 	}
 
 	ThreadedScraper::stop();
+	ThumbnailPregenerator::stop();
+	SystemMetrics::stop();
+	CommandExecutor::stop();
 
 	ApiSystem::getInstance()->deinit();
 
@@ -190,7 +190,7 @@ std::unique_ptr<MDResolveHandle> resolveMetaDataAssets(const ScraperSearchResult
 	return std::unique_ptr<MDResolveHandle>(new MDResolveHandle(result, search));
 }
 
-MDResolveHandle::MDResolveHandle(const ScraperSearchResult& result, const ScraperSearchParams& search) : mResult(result)
+MDResolveHandle::MDResolveHandle(const ScraperSearchResult& result, const ScraperSearchParams& search) : mResult(result), mSystem(search.system)
 {
 	mPercent = -1;
 
@@ -365,6 +365,10 @@ void MDResolveHandle::update()
 		mFuncs.erase(it);
 		delete pPair;
 
+		// A new media may have been saved in the images folder
+		if (mSystem != nullptr)
+			mSystem->resetLocalMediaIndex();
+
 		auto next = mFuncs.cbegin();
 		if (next != mFuncs.cend())
 		{
@@ -186,6 +186,7 @@ private:
 	};
 
 	std::vector<ResolvePair*> mFuncs;
+	SystemData* mSystem;
 	std::string mCurrentItem;
 	std::string mSource;
 	int mPercent;
@@ -6,6 +6,8 @@
 #include "guis/GuiMsgBox.h"
 #include "Gamelist.h"
 #include "Log.h"
+#include "Settings.h"
+#include "ThumbnailPregenerator.h"
 
 #define GUIICON _U("\uF03E ")
 
@@ -163,8 +165,17 @@ void ThreadedScraper::run()
 	}
 	
 	if (!mExit)
+	{
 		mWindow->displayNotificationMessage(GUIICON + _("SCRAPING FINISHED. REFRESH UPDATE GAMES LISTS TO APPLY CHANGES."));
 
+		// New medias : downscale them now rather than when the grids first display them
+		if (Settings::getInstance()->getBool("PregenerateThumbnails"))
+		{
+			Window* window = mWindow;
+			mWindow->postToUiThread([window]() { ThumbnailPregenerator::start(window); });
+		}
+	}
+
 	delete this;
 	ThreadedScraper::mInstance = nullptr;
 }
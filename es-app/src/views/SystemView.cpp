@@ -171,6 +171,10 @@ private:
 
 void SystemView::populate()
 {
+	static const ThemeData::PropertyId idPath = ThemeData::getPropertyId("path");
+	static const ThemeData::PropertyId idDefault = ThemeData::getPropertyId("default");
+	static const ThemeData::PropertyId idTile = ThemeData::getPropertyId("tile");
+
 	clearEntries();
 
 	for(auto it = SystemData::sSystemVector.cbegin(); it != SystemData::sSystemVector.cend(); it++)
@@ -192,10 +196,10 @@ void SystemView::populate()
 
 		// make logo
 		const ThemeData::ThemeElement* logoElem = theme->getElement("system", "logo", "image");
-		if (logoElem && logoElem->has("path"))
+		if (logoElem && logoElem->has(idPath))
 		{
-			std::string path = logoElem->get<std::string>("path");
-			std::string defaultPath = logoElem->has("default") ? logoElem->get<std::string>("default") : "";
+			std::string path = logoElem->get<std::string>(idPath);
+			std::string defaultPath = logoElem->has(idDefault) ? logoElem->get<std::string>(idDefault) : "";
 			
 			if ((!path.empty() && ResourceManager::getInstance()->fileExists(path))
 				|| (!defaultPath.empty() && ResourceManager::getInstance()->fileExists(defaultPath)))
@@ -207,11 +211,11 @@ void SystemView::populate()
 
 				// Process here to be enable to set max picture size
 				auto elem = theme->getElement("system", "logo", "image");
-				if (elem && elem->has("path"))
+				if (elem && elem->has(idPath))
 				{
-					auto path = elem->get<std::string>("path");
+					auto path = elem->get<std::string>(idPath);
 					if (Utils::FileSystem::exists(path))
-						logo->setImage(path, (elem->has("tile") && elem->get<bool>("tile")), MaxSizeInfo(mCarousel.logoSize * mCarousel.logoScale));
+						logo->setImage(path, (elem->has(idTile) && elem->get<bool>(idTile)), MaxSizeInfo(mCarousel.logoSize * mCarousel.logoScale));
 				}
 
 				if (mCarousel.size.x() != mCarousel.logoSize.x() & mCarousel.size.y() != mCarousel.logoSize.y())
@@ -279,15 +283,15 @@ void SystemView::populate()
 			if (extra->isKindOf<VideoComponent>())
 			{
 				auto elem = (*it)->getTheme()->getElement("system", extra->getTag(), "video");
-				if (elem != nullptr && elem->has("path") && Utils::String::startsWith(elem->get<std::string>("path"), "{random"))
+				if (elem != nullptr && elem->has(idPath) && Utils::String::startsWith(elem->get<std::string>(idPath), "{random"))
 					((VideoComponent*)extra)->setPlaylist(std::make_shared<SystemRandomPlaylist>(*it, SystemRandomPlaylist::VIDEO));
 			}
 			else if (extra->isKindOf<ImageComponent>())
 			{
 				auto elem = (*it)->getTheme()->getElement("system", extra->getTag(), "image");
-				if (elem != nullptr && elem->has("path") && Utils::String::startsWith(elem->get<std::string>("path"), "{random"))
+				if (elem != nullptr && elem->has(idPath) && Utils::String::startsWith(elem->get<std::string>(idPath), "{random"))
 				{
-					std::string src = elem->get<std::string>("path");
+					std::string src = elem->get<std::string>(idPath);
 
 					SystemRandomPlaylist::PlaylistType type = SystemRandomPlaylist::IMAGE;
 
@@ -1059,6 +1063,8 @@ void  SystemView::onThemeChanged(const std::shared_ptr<ThemeData>& /*theme*/)
 //  Get the ThemeElements that make up the SystemView.
 void  SystemView::getViewElements(const std::shared_ptr<ThemeData>& theme)
 {
+	static const ThemeData::PropertyId idVisible = ThemeData::getPropertyId("visible");
+
 	//LOG(LogDebug) << "SystemView::getViewElements()";
 
 	getDefaultElements();
@@ -1092,7 +1098,7 @@ void  SystemView::getViewElements(const std::shared_ptr<ThemeData>& theme)
 	}
 
 	const ThemeData::ThemeElement* fixedVideoBackgroundElem = theme->getElement("system", "staticBackgroundVideo", "video");
-	if (fixedVideoBackgroundElem && (!fixedVideoBackgroundElem->has("visible") || fixedVideoBackgroundElem->get<bool>("visible")))
+	if (fixedVideoBackgroundElem && (!fixedVideoBackgroundElem->has(idVisible) || fixedVideoBackgroundElem->get<bool>(idVisible)))
 	{		
 		if (mStaticVideoBackground == nullptr)
 			mStaticVideoBackground = new VideoVlcComponent(mWindow);
@@ -1501,71 +1507,91 @@ void  SystemView::getDefaultElements(void)
 
 void SystemView::getCarouselFromTheme(const ThemeData::ThemeElement* elem)
 {
-	if (elem->has("type"))
+	static const ThemeData::PropertyId idType = ThemeData::getPropertyId("type");
+	static const ThemeData::PropertyId idSize = ThemeData::getPropertyId("size");
+	static const ThemeData::PropertyId idPos = ThemeData::getPropertyId("pos");
+	static const ThemeData::PropertyId idOrigin = ThemeData::getPropertyId("origin");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idColorEnd = ThemeData::getPropertyId("colorEnd");
+	static const ThemeData::PropertyId idGradientType = ThemeData::getPropertyId("gradientType");
+	static const ThemeData::PropertyId idLogoScale = ThemeData::getPropertyId("logoScale");
+	static const ThemeData::PropertyId idLogoSize = ThemeData::getPropertyId("logoSize");
+	static const ThemeData::PropertyId idLogoPos = ThemeData::getPropertyId("logoPos");
+	static const ThemeData::PropertyId idMaxLogoCount = ThemeData::getPropertyId("maxLogoCount");
+	static const ThemeData::PropertyId idZIndex = ThemeData::getPropertyId("zIndex");
+	static const ThemeData::PropertyId idLogoRotation = ThemeData::getPropertyId("logoRotation");
+	static const ThemeData::PropertyId idLogoRotationOrigin = ThemeData::getPropertyId("logoRotationOrigin");
+	static const ThemeData::PropertyId idLogoAlignment = ThemeData::getPropertyId("logoAlignment");
+	static const ThemeData::PropertyId idSystemInfoDelay = ThemeData::getPropertyId("systemInfoDelay");
+	static const ThemeData::PropertyId idSystemInfoCountOnly = ThemeData::getPropertyId("systemInfoCountOnly");
+	static const ThemeData::PropertyId idScrollSound = ThemeData::getPropertyId("scrollSound");
+	static const ThemeData::PropertyId idDefaultTransition = ThemeData::getPropertyId("defaultTransition");
+
+	if (elem->has(idType))
 	{
-		if (!(elem->get<std::string>("type").compare("vertical")))
+		if (!(elem->get<std::string>(idType).compare("vertical")))
 			mCarousel.type = VERTICAL;
-		else if (!(elem->get<std::string>("type").compare("vertical_wheel")))
+		else if (!(elem->get<std::string>(idType).compare("vertical_wheel")))
 			mCarousel.type = VERTICAL_WHEEL;
-		else if (!(elem->get<std::string>("type").compare("horizontal_wheel")))
+		else if (!(elem->get<std::string>(idType).compare("horizontal_wheel")))
 			mCarousel.type = HORIZONTAL_WHEEL;
 		else
 			mCarousel.type = HORIZONTAL;
 	}
-	if (elem->has("size"))
-		mCarousel.size = elem->get<Vector2f>("size") * mSize;
-	if (elem->has("pos"))
-		mCarousel.pos = elem->get<Vector2f>("pos") * mSize;
-	if (elem->has("origin"))
-		mCarousel.origin = elem->get<Vector2f>("origin");
-	if (elem->has("color"))
+	if (elem->has(idSize))
+		mCarousel.size = elem->get<Vector2f>(idSize) * mSize;
+	if (elem->has(idPos))
+		mCarousel.pos = elem->get<Vector2f>(idPos) * mSize;
+	if (elem->has(idOrigin))
+		mCarousel.origin = elem->get<Vector2f>(idOrigin);
+	if (elem->has(idColor))
 	{
-		mCarousel.color = elem->get<unsigned int>("color");
+		mCarousel.color = elem->get<unsigned int>(idColor);
 		mCarousel.colorEnd = mCarousel.color;
 	}
-	if (elem->has("colorEnd"))
-		mCarousel.colorEnd = elem->get<unsigned int>("colorEnd");
-	if (elem->has("gradientType"))
-		mCarousel.colorGradientHorizontal = elem->get<std::string>("gradientType").compare("horizontal");
-	if (elem->has("logoScale"))
-		mCarousel.logoScale = elem->get<float>("logoScale");
-	if (elem->has("logoSize"))
-		mCarousel.logoSize = elem->get<Vector2f>("logoSize") * mSize;
-	if (elem->has("logoPos"))
-		mCarousel.logoPos = elem->get<Vector2f>("logoPos") * mSize;
-	if (elem->has("maxLogoCount"))
-		mCarousel.maxLogoCount = (int)Math::round(elem->get<float>("maxLogoCount"));
-	if (elem->has("zIndex"))
-		mCarousel.zIndex = elem->get<float>("zIndex");
-	if (elem->has("logoRotation"))
-		mCarousel.logoRotation = elem->get<float>("logoRotation");
-	if (elem->has("logoRotationOrigin"))
-		mCarousel.logoRotationOrigin = elem->get<Vector2f>("logoRotationOrigin");
-	if (elem->has("logoAlignment"))
+	if (elem->has(idColorEnd))
+		mCarousel.colorEnd = elem->get<unsigned int>(idColorEnd);
+	if (elem->has(idGradientType))
+		mCarousel.colorGradientHorizontal = elem->get<std::string>(idGradientType).compare("horizontal");
+	if (elem->has(idLogoScale))
+		mCarousel.logoScale = elem->get<float>(idLogoScale);
+	if (elem->has(idLogoSize))
+		mCarousel.logoSize = elem->get<Vector2f>(idLogoSize) * mSize;
+	if (elem->has(idLogoPos))
+		mCarousel.logoPos = elem->get<Vector2f>(idLogoPos) * mSize;
+	if (elem->has(idMaxLogoCount))
+		mCarousel.maxLogoCount = (int)Math::round(elem->get<float>(idMaxLogoCount));
+	if (elem->has(idZIndex))
+		mCarousel.zIndex = elem->get<float>(idZIndex);
+	if (elem->has(idLogoRotation))
+		mCarousel.logoRotation = elem->get<float>(idLogoRotation);
+	if (elem->has(idLogoRotationOrigin))
+		mCarousel.logoRotationOrigin = elem->get<Vector2f>(idLogoRotationOrigin);
+	if (elem->has(idLogoAlignment))
 	{
-		if (!(elem->get<std::string>("logoAlignment").compare("left")))
+		if (!(elem->get<std::string>(idLogoAlignment).compare("left")))
 			mCarousel.logoAlignment = ALIGN_LEFT;
-		else if (!(elem->get<std::string>("logoAlignment").compare("right")))
+		else if (!(elem->get<std::string>(idLogoAlignment).compare("right")))
 			mCarousel.logoAlignment = ALIGN_RIGHT;
-		else if (!(elem->get<std::string>("logoAlignment").compare("top")))
+		else if (!(elem->get<std::string>(idLogoAlignment).compare("top")))
 			mCarousel.logoAlignment = ALIGN_TOP;
-		else if (!(elem->get<std::string>("logoAlignment").compare("bottom")))
+		else if (!(elem->get<std::string>(idLogoAlignment).compare("bottom")))
 			mCarousel.logoAlignment = ALIGN_BOTTOM;
 		else
 			mCarousel.logoAlignment = ALIGN_CENTER;
 	}
 
-	if (elem->has("systemInfoDelay"))
-		mCarousel.systemInfoDelay = elem->get<float>("systemInfoDelay");
+	if (elem->has(idSystemInfoDelay))
+		mCarousel.systemInfoDelay = elem->get<float>(idSystemInfoDelay);
 
-	if (elem->has("systemInfoCountOnly"))
-		mCarousel.systemInfoCountOnly = elem->get<bool>("systemInfoCountOnly");
+	if (elem->has(idSystemInfoCountOnly))
+		mCarousel.systemInfoCountOnly = elem->get<bool>(idSystemInfoCountOnly);
 
-	if (elem->has("scrollSound"))
-		mCarousel.scrollSound = elem->get<std::string>("scrollSound");
+	if (elem->has(idScrollSound))
+		mCarousel.scrollSound = elem->get<std::string>(idScrollSound);
 
-	if (elem->has("defaultTransition"))
-		mCarousel.defaultTransition = elem->get<std::string>("defaultTransition");
+	if (elem->has(idDefaultTransition))
+		mCarousel.defaultTransition = elem->get<std::string>(idDefaultTransition);
 }
 
 void SystemView::onShow()
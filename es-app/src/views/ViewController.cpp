@@ -20,6 +20,7 @@
 #include "Window.h"
 #include "AudioManager.h"
 #include "utils/ThreadPool.h"
+#include "utils/ProfilingUtil.h"
 #include <mutex>
 #include <SDL_timer.h>
 
@@ -373,6 +374,8 @@ std::shared_ptr<IGameListView> ViewController::getGameListView(SystemData* syste
 	if (!loadIfnull)
 		return nullptr;
 
+	ProfileScope("ViewController::getGameListView");
+
 	system->setUIModeFilters();
 	system->updateDisplayedGameCount();
 
@@ -789,6 +792,8 @@ void ViewController::reloadAll(Window* window, bool reloadTheme)
 		}
 		else
 			pool.wait();
+
+		ThemeData::clearDocumentCache();
 	}
 
 	bool preloadUI = Settings::getInstance()->getBool("PreloadUI");
@@ -1,6 +1,7 @@
 #include "views/gamelist/BasicGameListView.h"
 
 #include "utils/FileSystemUtil.h"
+#include "utils/ProfilingUtil.h"
 #include "views/UIModeController.h"
 #include "views/ViewController.h"
 #include "CollectionSystemManager.h"
@@ -67,6 +68,8 @@ void BasicGameListView::onFileChanged(FileData* file, FileChangeType change)
 
 void BasicGameListView::populateList(const std::vector<FileData*>& files)
 {
+	ProfileScope("BasicGameListView::populateList");
+
 	mList.clear();
 
 	std::string systemName = mRoot->getSystem()->getFullName();
@@ -503,3 +503,20 @@ void DetailedGameListView::onFocusLost() {
 	mDescContainer.reset();
 	mList.stopScrolling(true);
 }
+
+std::vector<IGameListView::ImageTarget> DetailedGameListView::getImageTargets()
+{
+	std::vector<ImageTarget> targets;
+
+	// Same images & sizes as updateInfoPanel
+	if (mThumbnail != nullptr)
+		targets.push_back(ImageTarget([](FileData* file) { return file->getThumbnailPath(); }, MaxSizeInfo()));
+
+	if (mImage != nullptr)
+		targets.push_back(ImageTarget([](FileData* file) { return file->getImagePath().empty() ? file->getThumbnailPath() : file->getImagePath(); }, MaxSizeInfo()));
+
+	if (mMarquee != nullptr)
+		targets.push_back(ImageTarget([](FileData* file) { return file->getMarqueePath(); }, mMarquee->getMaxSizeInfo()));
+
+	return targets;
+}
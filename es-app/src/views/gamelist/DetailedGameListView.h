@@ -28,6 +28,7 @@ public:
 	}
 
 	virtual void launch(FileData* game) override;
+	virtual std::vector<ImageTarget> getImageTargets() override;
 
 private:
 	void updateInfoPanel();
@@ -1,6 +1,7 @@
 #include "views/gamelist/GridGameListView.h"
 
 #include "animations/LambdaAnimation.h"
+#include "utils/ProfilingUtil.h"
 #include "views/UIModeController.h"
 #include "views/ViewController.h"
 #include "CollectionSystemManager.h"
@@ -235,14 +236,18 @@ const bool GridGameListView::isVirtualFolder(FileData* file)
 
 void GridGameListView::populateList(const std::vector<FileData*>& files)
 {
+	static const ThemeData::PropertyId idPath = ThemeData::getPropertyId("path");
+
+	ProfileScope("GridGameListView::populateList");
+
 	SystemData* system = mCursorStack.size() && mRoot->getSystem()->isGroupSystem() ? mCursorStack.top()->getSystem() : mRoot->getSystem();
 
 	auto groupTheme = system->getTheme();
 	if (groupTheme)
 	{
 		const ThemeData::ThemeElement* logoElem = groupTheme->getElement("system", "logo", "image");
-		if (logoElem && logoElem->has("path") && Utils::FileSystem::exists(logoElem->get<std::string>("path")))
-			mHeaderImage.setImage(logoElem->get<std::string>("path"));
+		if (logoElem && logoElem->has(idPath) && Utils::FileSystem::exists(logoElem->get<std::string>(idPath)))
+			mHeaderImage.setImage(logoElem->get<std::string>(idPath));
 	}
 
 	mHeaderText.setText(system->getFullName());
@@ -271,8 +276,8 @@ void GridGameListView::populateList(const std::vector<FileData*>& files)
 				if (theme)
 				{
 					const ThemeData::ThemeElement* logoElem = theme->getElement("system", "logo", "image");
-					if (logoElem && logoElem->has("path"))
-						imagePath = logoElem->get<std::string>("path");
+					if (logoElem && logoElem->has(idPath))
+						imagePath = logoElem->get<std::string>(idPath);
 				}
 
 				if (imagePath.empty())
@@ -803,3 +808,40 @@ std::vector<FileData*> GridGameListView::getFileDataEntries()
 void GridGameListView::onFocusLost() {
 	mDescContainer.reset();
 }
+
+std::vector<IGameListView::ImageTarget> GridGameListView::getImageTargets()
+{
+	std::vector<ImageTarget> targets;
+
+	// Grid tiles
+	auto tile = mGrid.getFirstTile();
+	if (tile != nullptr)
+	{
+		ImageSource src = mGrid.getImageSource();
+
+		targets.push_back(ImageTarget([src](FileData* file) -> std::string
+		{
+			if (src == ImageSource::IMAGE)
+				return file->getImagePath();
+			else if (src == ImageSource::MARQUEE)
+				return file->getMarqueePath();
+
+			return file->getThumbnailPath();
+		}, tile->getImageMaxSizeInfo()));
+
+		if (tile->hasMarquee())
+			targets.push_back(ImageTarget([](FileData* file) { return file->getMarqueePath(); }, tile->getMarqueeMaxSizeInfo()));
+	}
+
+	// Same images & sizes as updateInfoPanel
+	if (mImage != nullptr)
+		targets.push_back(ImageTarget([](FileData* file) { return file->getImagePath().empty() ? file->getThumbnailPath() : file->getImagePath(); }, MaxSizeInfo()));
+
+	if (mThumbnail != nullptr)
+		targets.push_back(ImageTarget([](FileData* file) { return file->getThumbnailPath(); }, MaxSizeInfo()));
+
+	if (mMarquee != nullptr)
+		targets.push_back(ImageTarget([](FileData* file) { return file->getMarqueePath(); }, mMarquee->getMaxSizeInfo()));
+
+	return targets;
+}
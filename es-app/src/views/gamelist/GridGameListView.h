@@ -34,6 +34,7 @@ public:
 
 	virtual std::vector<HelpPrompt> getHelpPrompts() override;
 	virtual void launch(FileData* game) override;
+	virtual std::vector<ImageTarget> getImageTargets() override;
 	virtual void onFileChanged(FileData* file, FileChangeType change);
 
 	virtual void setThemeName(std::string name);	
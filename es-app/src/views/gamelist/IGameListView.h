@@ -3,6 +3,7 @@
 #define ES_APP_VIEWS_GAME_LIST_IGAME_LIST_VIEW_H
 
 #include "renderers/Renderer.h"
+#include "resources/TextureResource.h"
 #include "MetaData.h"
 #include "FileData.h"
 #include "GuiComponent.h"
@@ -47,6 +48,18 @@ public:
 
 	virtual std::vector<std::string> getEntriesLetters() = 0;
 
+	// An image the view displays for every game, and the size it is downscaled to
+	struct ImageTarget
+	{
+		ImageTarget(const std::function<std::string(FileData*)>& _path, const MaxSizeInfo& _maxSize) : path(_path), maxSize(_maxSize) { }
+
+		std::function<std::string(FileData*)> path;
+		MaxSizeInfo maxSize;
+	};
+
+	// Used by the ThumbnailPregenerator to know which images to downscale ahead
+	virtual std::vector<ImageTarget> getImageTargets() { return std::vector<ImageTarget>(); }
+
 protected:
 	virtual std::string getMetadata(FileData* file, MetaDataId metaDataId);
 
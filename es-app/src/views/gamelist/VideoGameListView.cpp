@@ -489,3 +489,23 @@ void VideoGameListView::onFocusLost() {
 	mDescContainer.reset();
 	mList.stopScrolling(true);
 }
+
+std::vector<IGameListView::ImageTarget> VideoGameListView::getImageTargets()
+{
+	std::vector<ImageTarget> targets;
+
+	// Same images & sizes as updateInfoPanel
+	targets.push_back(ImageTarget([](FileData* file) { return file->getMarqueePath(); }, MaxSizeInfo()));
+
+	if (mThumbnail != nullptr)
+	{
+		if (mImage != nullptr)
+			targets.push_back(ImageTarget([](FileData* file) { return file->getImagePath(); }, mImage->getMaxSizeInfo()));
+
+		targets.push_back(ImageTarget([](FileData* file) { return file->getThumbnailPath(); }, mThumbnail->getMaxSizeInfo()));
+	}
+	else if (mImage != nullptr)
+		targets.push_back(ImageTarget([](FileData* file) { return file->getThumbnailPath(); }, MaxSizeInfo()));
+
+	return targets;
+}
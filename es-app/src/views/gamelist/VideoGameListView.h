@@ -29,6 +29,7 @@ public:
 	}
 
 	virtual void launch(FileData* game) override;
+	virtual std::vector<ImageTarget> getImageTargets() override;
 
 protected:
 	virtual void update(int deltaTime) override;
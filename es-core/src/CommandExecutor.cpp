@@ -0,0 +1,383 @@
+#include "CommandExecutor.h"
+
+#include "Log.h"
+#include "Window.h"
+
+#include <SDL_timer.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+// Scripts mostly wait on the system, two workers are enough to keep a slow one from delaying the others
+#define COMMAND_EXECUTOR_THREADS 2
+
+// Delay between two checks of the timeout & cancellation while a command runs (ms)
+#define COMMAND_POLL_DELAY 50
+
+struct CommandJob
+{
+	CommandJob(const std::string& _command, int _timeout, const std::string& _serial, bool _readOnly) : command(_command), timeout(_timeout), serial(_serial), readOnly(_readOnly), started(false), cancelled(false)
+	{
+		future = promise.get_future().share();
+	}
+
+	std::string command;
+	int timeout;
+	std::string serial; // Jobs sharing a serial run one after the other, in the order they were queued
+	bool readOnly; // Read-only jobs of a serial may run together, but never with the other jobs of the serial
+	bool started; // Guarded by sLock
+	std::function<bool()> task; // Run instead of the command if set
+
+	std::promise<CommandResult> promise;
+	std::shared_future<CommandResult> future;
+	std::atomic<bool> cancelled;
+
+	std::vector<std::function<void(const CommandResult&)>> callbacks; // Guarded by sLock
+};
+
+static std::mutex sLock;
+static std::condition_variable sEvent;
+static std::deque<std::shared_ptr<CommandJob>> sQueue;
+static std::map<std::string, std::shared_ptr<CommandJob>> sJobs; // Queued or running
+static std::multiset<std::string> sRunningSerials;
+static std::multiset<std::string> sRunningWriters; // Serials of the running jobs which aren't read-only
+static std::vector<std::thread> sThreads;
+static bool sExit = false;
+
+static CommandResult execute(CommandJob* job)
+{
+	CommandResult result;
+
+	if (job->cancelled)
+	{
+		result.cancelled = true;
+		return result;
+	}
+
+	if (job->task != nullptr)
+	{
+		LOG(LogDebug) << "CommandExecutor::execute() - Running task -> " << job->command;
+
+		result.exitCode = job->task() ? 0 : 1;
+		return result;
+	}
+
+	LOG(LogInfo) << "CommandExecutor::execute() - Running -> " << job->command;
+
+	int fds[2];
+	if (pipe2(fds, O_CLOEXEC) != 0)
+	{
+		LOG(LogError) << "CommandExecutor::execute() - Error creating pipe for " << job->command;
+		return result;
+	}
+
+	// posix_spawn doesn't copy the address space of the process, unlike fork.
+	// The command gets its own process group, so that a timeout also kills what the script started
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+	posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+
+	posix_spawnattr_t attr;
+	posix_spawnattr_init(&attr);
+	posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP);
+	posix_spawnattr_setpgroup(&attr, 0);
+
+	const char* argv[] = { "sh", "-c", job->command.c_str(), nullptr };
+
+	pid_t pid;
+	int error = posix_spawn(&pid, "/bin/sh", &actions, &attr, (char* const*)argv, environ);
+
+	posix_spawnattr_destroy(&attr);
+	posix_spawn_file_actions_destroy(&actions);
+	close(fds[1]);
+
+	if (error != 0)
+	{
+		LOG(LogError) << "CommandExecutor::execute() - Error executing " << job->command;
+		close(fds[0]);
+		return result;
+	}
+
+	fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+	int start = SDL_GetTicks();
+	bool endOfOutput = false;
+	int status = 0;
+
+	char buffer[1024];
+
+	while (true)
+	{
+		// Commands ending with '&' leave children holding the pipe : the end is the exit of the shell, not the end of the output
+		pollfd pfd;
+		pfd.fd = endOfOutput ? -1 : fds[0];
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		poll(&pfd, 1, COMMAND_POLL_DELAY);
+
+		while (!endOfOutput)
+		{
+			ssize_t count = read(fds[0], buffer, sizeof(buffer));
+			if (count > 0)
+				result.output.append(buffer, count);
+			else
+			{
+				endOfOutput = (count == 0);
+				break;
+			}
+		}
+
+		if (waitpid(pid, &status, WNOHANG) == pid)
+		{
+			ssize_t count;
+			while (!endOfOutput && (count = read(fds[0], buffer, sizeof(buffer))) > 0)
+				result.output.append(buffer, count);
+
+			result.exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+			break;
+		}
+
+		bool timedOut = job->timeout > 0 && (int)SDL_GetTicks() - start > job->timeout;
+		if (timedOut || job->cancelled)
+		{
+			LOG(LogWarning) << "CommandExecutor::execute() - " << (timedOut ? "Timeout, killing " : "Cancelled, killing ") << job->command;
+
+			killpg(pid, SIGKILL);
+			waitpid(pid, &status, 0);
+
+			result.timedOut = timedOut;
+			result.cancelled = !timedOut;
+			break;
+		}
+	}
+
+	close(fds[0]);
+
+	if (!result.output.empty() && result.output.back() == '\n')
+		result.output.pop_back();
+
+	return result;
+}
+
+// Two jobs of a serial must keep their order, unless both are read-only
+static bool isOrdered(const std::shared_ptr<CommandJob>& a, const std::shared_ptr<CommandJob>& b)
+{
+	return a->serial == b->serial && !(a->readOnly && b->readOnly);
+}
+
+// First queued job which no queued or running job of its serial has to precede. Must be called with sLock held
+static std::deque<std::shared_ptr<CommandJob>>::iterator findRunnableJob()
+{
+	for (auto it = sQueue.begin(); it != sQueue.end(); ++it)
+	{
+		auto& job = *it;
+		if (job->serial.empty())
+			return it;
+
+		auto& running = job->readOnly ? sRunningWriters : sRunningSerials;
+		if (running.find(job->serial) != running.cend())
+			continue;
+
+		if (std::find_if(sQueue.begin(), it, [&job](const std::shared_ptr<CommandJob>& previous) { return isOrdered(previous, job); }) == it)
+			return it;
+	}
+
+	return sQueue.end();
+}
+
+static void workerProc()
+{
+	std::unique_lock<std::mutex> lock(sLock);
+
+	while (true)
+	{
+		sEvent.wait(lock, [] { return sExit || findRunnableJob() != sQueue.end(); });
+		if (sExit)
+			break;
+
+		auto next = findRunnableJob();
+		std::shared_ptr<CommandJob> job = *next;
+		sQueue.erase(next);
+
+		job->started = true;
+		if (!job->serial.empty())
+		{
+			sRunningSerials.insert(job->serial);
+			if (!job->readOnly)
+				sRunningWriters.insert(job->serial);
+		}
+
+		lock.unlock();
+		CommandResult result = execute(job.get());
+		lock.lock();
+
+		// The next job of the same serial may be waiting for this one
+		if (!job->serial.empty())
+		{
+			sRunningSerials.erase(sRunningSerials.find(job->serial));
+			if (!job->readOnly)
+				sRunningWriters.erase(sRunningWriters.find(job->serial));
+
+			sEvent.notify_all();
+		}
+
+		// Once removed from sJobs, nobody can attach a callback anymore
+		auto it = sJobs.find(job->command);
+		if (it != sJobs.cend() && it->second == job)
+			sJobs.erase(it);
+
+		std::vector<std::function<void(const CommandResult&)>> callbacks;
+		callbacks.swap(job->callbacks);
+
+		bool exiting = sExit;
+		lock.unlock();
+
+		job->promise.set_value(result);
+
+		if (!exiting)
+			for (auto& callback : callbacks)
+				callback(result);
+
+		lock.lock();
+	}
+}
+
+// A started job may miss what changed since it started : the caller gets a new run instead.
+// With a serial, a job queued after it must not have to run before the caller's one
+static bool canShare(const std::shared_ptr<CommandJob>& job)
+{
+	if (job->cancelled || job->started)
+		return false;
+
+	for (auto it = sQueue.rbegin(); it != sQueue.rend() && *it != job; ++it)
+		if (isOrdered(*it, job))
+			return false;
+
+	return true;
+}
+
+static std::shared_ptr<CommandJob> queue(const std::string& command, int timeout, const std::string& serial, bool readOnly, const std::function<void(const CommandResult&)>& func, const std::function<bool()>& task = nullptr)
+{
+	std::unique_lock<std::mutex> lock(sLock);
+
+	auto it = sJobs.find(command);
+	if (it != sJobs.cend() && it->second->serial == serial && it->second->readOnly == readOnly && canShare(it->second))
+	{
+		LOG(LogDebug) << "CommandExecutor::run() - Already queued -> " << command;
+
+		if (func != nullptr)
+			it->second->callbacks.push_back(func);
+
+		return it->second;
+	}
+
+	auto job = std::make_shared<CommandJob>(command, timeout, serial, readOnly);
+	job->task = task;
+
+	if (func != nullptr)
+		job->callbacks.push_back(func);
+
+	if (sExit)
+	{
+		CommandResult result;
+		result.cancelled = true;
+		job->promise.set_value(result);
+		return job;
+	}
+
+	sJobs[command] = job;
+	sQueue.push_back(job);
+
+	if (sThreads.size() == 0)
+		for (int i = 0; i < COMMAND_EXECUTOR_THREADS; i++)
+			sThreads.push_back(std::thread(workerProc));
+
+	lock.unlock();
+	sEvent.notify_one();
+
+	return job;
+}
+
+std::shared_future<CommandResult> CommandExecutor::run(const std::string& command, int timeout, const std::string& serial, bool readOnly)
+{
+	return queue(command, timeout, serial, readOnly, nullptr)->future;
+}
+
+void CommandExecutor::run(const std::string& command, Window* window, const std::function<void(const CommandResult&)>& func, int timeout, void* data, const std::string& serial, bool readOnly)
+{
+	queue(command, timeout, serial, readOnly, [window, func, data](const CommandResult& result)
+	{
+		window->postToUiThread([func, result] { func(result); }, data);
+	});
+}
+
+std::shared_future<CommandResult> CommandExecutor::runTask(const std::string& name, const std::function<bool()>& task, const std::string& serial)
+{
+	return queue(name, 0, serial, false, nullptr, task)->future;
+}
+
+void CommandExecutor::runTask(const std::string& name, const std::function<bool()>& task, Window* window, const std::function<void(const CommandResult&)>& func, void* data, const std::string& serial)
+{
+	queue(name, 0, serial, false, [window, func, data](const CommandResult& result)
+	{
+		window->postToUiThread([func, result] { func(result); }, data);
+	}, task);
+}
+
+void CommandExecutor::cancel(const std::string& command)
+{
+	std::unique_lock<std::mutex> lock(sLock);
+
+	auto it = sJobs.find(command);
+	if (it != sJobs.cend())
+		it->second->cancelled = true;
+}
+
+void CommandExecutor::stop()
+{
+	std::vector<std::thread> threads;
+	std::deque<std::shared_ptr<CommandJob>> queued;
+
+	{
+		std::unique_lock<std::mutex> lock(sLock);
+		sExit = true;
+
+		for (auto& job : sJobs)
+			job.second->cancelled = true;
+
+		queued.swap(sQueue);
+		threads.swap(sThreads);
+		sJobs.clear();
+		sRunningSerials.clear();
+		sRunningWriters.clear();
+	}
+
+	sEvent.notify_all();
+
+	// Commands which never started
+	for (auto& job : queued)
+	{
+		CommandResult result;
+		result.cancelled = true;
+		job->promise.set_value(result);
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+}
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef ES_CORE_COMMAND_EXECUTOR_H
+#define ES_CORE_COMMAND_EXECUTOR_H
+
+#include <functional>
+#include <future>
+#include <string>
+
+class Window;
+
+// Time a command may run before being killed (ms). 0 means no limit
+#define COMMAND_DEFAULT_TIMEOUT 30000
+
+struct CommandResult
+{
+	CommandResult()
+	{
+		exitCode = -1;
+		timedOut = false;
+		cancelled = false;
+	}
+
+	bool succeeded() const { return exitCode == 0 && !timedOut && !cancelled; }
+
+	std::string output; // standard output, without the last line feed
+	int exitCode;
+	bool timedOut;
+	bool cancelled;
+};
+
+// Runs shell commands on a few worker threads, so scripts never block the UI thread.
+// A command is killed with its whole process group when it times out or is cancelled.
+// Requesting a command which is queued and not started yet doesn't queue it again : the callers share its result.
+// Commands given the same serial run one at a time, in the order they were requested (e.g. the setters of a script).
+// Read-only commands of a serial may run together : they only wait for the other commands requested before them.
+class CommandExecutor
+{
+public:
+	static std::shared_future<CommandResult> run(const std::string& command, int timeout = COMMAND_DEFAULT_TIMEOUT, const std::string& serial = "", bool readOnly = false);
+
+	// func is called on the UI thread. data is the container given to Window::postToUiThread
+	static void run(const std::string& command, Window* window, const std::function<void(const CommandResult&)>& func, int timeout = COMMAND_DEFAULT_TIMEOUT, void* data = nullptr, const std::string& serial = "", bool readOnly = false);
+
+	// Runs a function on the workers instead of a shell command. name identifies it like a command line, to share the runs.
+	// The function can't be killed : the timeout & cancel only apply until it starts. It returns its success
+	static std::shared_future<CommandResult> runTask(const std::string& name, const std::function<bool()>& task, const std::string& serial = "");
+	static void runTask(const std::string& name, const std::function<bool()>& task, Window* window, const std::function<void(const CommandResult&)>& func, void* data = nullptr, const std::string& serial = "");
+
+	static void cancel(const std::string& command);
+
+	// Cancels every command and waits for the workers. Pending callbacks are not called
+	static void stop();
+};
+
+#endif // ES_CORE_COMMAND_EXECUTOR_H
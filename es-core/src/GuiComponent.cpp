@@ -428,34 +428,43 @@ void GuiComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std
 	if(!elem)
 		return;
 
+	// Resolved once for all the components
+	static const ThemeData::PropertyId idPos = ThemeData::getPropertyId("pos");
+	static const ThemeData::PropertyId idSize = ThemeData::getPropertyId("size");
+	static const ThemeData::PropertyId idOrigin = ThemeData::getPropertyId("origin");
+	static const ThemeData::PropertyId idRotation = ThemeData::getPropertyId("rotation");
+	static const ThemeData::PropertyId idRotationOrigin = ThemeData::getPropertyId("rotationOrigin");
+	static const ThemeData::PropertyId idZIndex = ThemeData::getPropertyId("zIndex");
+	static const ThemeData::PropertyId idVisible = ThemeData::getPropertyId("visible");
+
 	using namespace ThemeFlags;
-	if(properties & POSITION && elem->has("pos"))
+	if(properties & POSITION && elem->has(idPos))
 	{
-		Vector2f denormalized = elem->get<Vector2f>("pos") * scale;
+		Vector2f denormalized = elem->get<Vector2f>(idPos) * scale;
 		setPosition(Vector3f(denormalized.x(), denormalized.y(), 0));
 	}
 
-	if(properties & ThemeFlags::SIZE && elem->has("size"))
-		setSize(elem->get<Vector2f>("size") * scale);
+	if(properties & ThemeFlags::SIZE && elem->has(idSize))
+		setSize(elem->get<Vector2f>(idSize) * scale);
 
 	// position + size also implies origin
-	if((properties & ORIGIN || (properties & POSITION && properties & ThemeFlags::SIZE)) && elem->has("origin"))
-		setOrigin(elem->get<Vector2f>("origin"));
+	if((properties & ORIGIN || (properties & POSITION && properties & ThemeFlags::SIZE)) && elem->has(idOrigin))
+		setOrigin(elem->get<Vector2f>(idOrigin));
 
 	if(properties & ThemeFlags::ROTATION) {
-		if(elem->has("rotation"))
-			setRotationDegrees(elem->get<float>("rotation"));
-		if(elem->has("rotationOrigin"))
-			setRotationOrigin(elem->get<Vector2f>("rotationOrigin"));
+		if(elem->has(idRotation))
+			setRotationDegrees(elem->get<float>(idRotation));
+		if(elem->has(idRotationOrigin))
+			setRotationOrigin(elem->get<Vector2f>(idRotationOrigin));
 	}
 
-	if(properties & ThemeFlags::Z_INDEX && elem->has("zIndex"))
-		setZIndex(elem->get<float>("zIndex"));
+	if(properties & ThemeFlags::Z_INDEX && elem->has(idZIndex))
+		setZIndex(elem->get<float>(idZIndex));
 	else
 		setZIndex(getDefaultZIndex());
 
-	if(properties & ThemeFlags::VISIBLE && elem->has("visible"))
-		setVisible(elem->get<bool>("visible"));
+	if(properties & ThemeFlags::VISIBLE && elem->has(idVisible))
+		setVisible(elem->get<bool>(idVisible));
 	else
 		setVisible(true);
 }
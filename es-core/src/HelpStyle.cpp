@@ -16,6 +16,24 @@ HelpStyle::HelpStyle()
 
 void HelpStyle::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view)
 {
+	static const ThemeData::PropertyId idPos = ThemeData::getPropertyId("pos");
+	static const ThemeData::PropertyId idOrigin = ThemeData::getPropertyId("origin");
+	static const ThemeData::PropertyId idTextColor = ThemeData::getPropertyId("textColor");
+	static const ThemeData::PropertyId idIconColor = ThemeData::getPropertyId("iconColor");
+	static const ThemeData::PropertyId idFontPath = ThemeData::getPropertyId("fontPath");
+	static const ThemeData::PropertyId idFontSize = ThemeData::getPropertyId("fontSize");
+	static const ThemeData::PropertyId idIconUpDown = ThemeData::getPropertyId("iconUpDown");
+	static const ThemeData::PropertyId idIconLeftRight = ThemeData::getPropertyId("iconLeftRight");
+	static const ThemeData::PropertyId idIconUpDownLeftRight = ThemeData::getPropertyId("iconUpDownLeftRight");
+	static const ThemeData::PropertyId idIconA = ThemeData::getPropertyId("iconA");
+	static const ThemeData::PropertyId idIconB = ThemeData::getPropertyId("iconB");
+	static const ThemeData::PropertyId idIconX = ThemeData::getPropertyId("iconX");
+	static const ThemeData::PropertyId idIconY = ThemeData::getPropertyId("iconY");
+	static const ThemeData::PropertyId idIconL = ThemeData::getPropertyId("iconL");
+	static const ThemeData::PropertyId idIconR = ThemeData::getPropertyId("iconR");
+	static const ThemeData::PropertyId idIconStart = ThemeData::getPropertyId("iconStart");
+	static const ThemeData::PropertyId idIconSelect = ThemeData::getPropertyId("iconSelect");
+
 	if (theme == nullptr)
 		return;
 
@@ -23,51 +41,51 @@ void HelpStyle::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::s
 	if(!elem)
 		return;
 
-	if(elem->has("pos"))
-		position = elem->get<Vector2f>("pos") * Vector2f((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight());
+	if(elem->has(idPos))
+		position = elem->get<Vector2f>(idPos) * Vector2f((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight());
 
-	if(elem->has("origin"))
-		origin = elem->get<Vector2f>("origin");
+	if(elem->has(idOrigin))
+		origin = elem->get<Vector2f>(idOrigin);
 
-	if(elem->has("textColor"))
-		textColor = elem->get<unsigned int>("textColor");
+	if(elem->has(idTextColor))
+		textColor = elem->get<unsigned int>(idTextColor);
 
-	if(elem->has("iconColor"))
-		iconColor = elem->get<unsigned int>("iconColor");
+	if(elem->has(idIconColor))
+		iconColor = elem->get<unsigned int>(idIconColor);
 
-	if(elem->has("fontPath") || elem->has("fontSize"))
+	if(elem->has(idFontPath) || elem->has(idFontSize))
 		font = Font::getFromTheme(elem, ThemeFlags::ALL, font);
 
-	if (elem->has("iconUpDown"))
-		iconMap["up/down"] = elem->get<std::string>("iconUpDown");
+	if (elem->has(idIconUpDown))
+		iconMap["up/down"] = elem->get<std::string>(idIconUpDown);
 
-	if (elem->has("iconLeftRight"))
-		iconMap["left/right"] = elem->get<std::string>("iconLeftRight");
+	if (elem->has(idIconLeftRight))
+		iconMap["left/right"] = elem->get<std::string>(idIconLeftRight);
 
-	if (elem->has("iconUpDownLeftRight"))
-		iconMap["up/down/left/right"] = elem->get<std::string>("iconUpDownLeftRight");
+	if (elem->has(idIconUpDownLeftRight))
+		iconMap["up/down/left/right"] = elem->get<std::string>(idIconUpDownLeftRight);
 
-	if (elem->has("iconA"))
-		iconMap["a"] = elem->get<std::string>("iconA");
+	if (elem->has(idIconA))
+		iconMap["a"] = elem->get<std::string>(idIconA);
 
-	if (elem->has("iconB"))
-		iconMap["b"] = elem->get<std::string>("iconB");
+	if (elem->has(idIconB))
+		iconMap["b"] = elem->get<std::string>(idIconB);
 
-	if (elem->has("iconX"))
-		iconMap["x"] = elem->get<std::string>("iconX");
+	if (elem->has(idIconX))
+		iconMap["x"] = elem->get<std::string>(idIconX);
 
-	if (elem->has("iconY"))
-		iconMap["y"] = elem->get<std::string>("iconY");
+	if (elem->has(idIconY))
+		iconMap["y"] = elem->get<std::string>(idIconY);
 
-	if (elem->has("iconL"))
-		iconMap["l"] = elem->get<std::string>("iconL");
+	if (elem->has(idIconL))
+		iconMap["l"] = elem->get<std::string>(idIconL);
 
-	if (elem->has("iconR"))
-		iconMap["r"] = elem->get<std::string>("iconR");
+	if (elem->has(idIconR))
+		iconMap["r"] = elem->get<std::string>(idIconR);
 
-	if (elem->has("iconStart"))
-		iconMap["start"] = elem->get<std::string>("iconStart");
+	if (elem->has(idIconStart))
+		iconMap["start"] = elem->get<std::string>(idIconStart);
 
-	if (elem->has("iconSelect"))
-		iconMap["select"] = elem->get<std::string>("iconSelect");
+	if (elem->has(idIconSelect))
+		iconMap["select"] = elem->get<std::string>(idIconSelect);
 }
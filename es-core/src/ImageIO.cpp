@@ -8,6 +8,7 @@
 #include <iostream>
 #include "math/Vector2i.h"
 #include "utils/FileSystemUtil.h"
+#include "utils/PixelUtil.h"
 #include "utils/StringUtil.h"
 #include "resources/ResourceManager.h"
 
@@ -324,33 +325,14 @@ std::vector<unsigned char> ImageIO::loadFromMemoryRGBA32(const unsigned char * d
 
 					//loop through scanlines and add all pixel data to the return vector
 					//this is necessary, because width*height*bpp might not be == pitch
+					//convert from BGRA to RGBA on the way
+					rawData.resize(width * height * 4);
 
-					unsigned char * tempData = new unsigned char[width * height * 4];
-					unsigned char * bytes = FreeImage_GetBits(fiBitmap);
-
-				//	memcpy(tempData, bytes, width * height * 4);
-/*
 					for (size_t i = 0; i < height; i++)
-					{
-						const BYTE * scanLine = FreeImage_GetScanLine(fiBitmap, (int)i);
-						memcpy(tempData + (i * width * 4), scanLine, width * 4);
-					}*/
-					//convert from BGRA to RGBA
-					for(size_t i = 0; i < width*height; i++)
-					{
-						RGBQUAD bgra = ((RGBQUAD *)bytes)[i];
-						RGBQUAD rgba;
-						rgba.rgbBlue = bgra.rgbRed;
-						rgba.rgbGreen = bgra.rgbGreen;
-						rgba.rgbRed = bgra.rgbBlue;
-						rgba.rgbReserved = bgra.rgbReserved;
-						((RGBQUAD *)tempData)[i] = rgba;
-					}
-					
-					rawData = std::vector<unsigned char>(tempData, tempData + width * height * 4);
+						Utils::Pixel::swapRedBlue(FreeImage_GetScanLine(fiBitmap, (int)i), rawData.data() + (i * width * 4), width);
+
 					//free bitmap data
 					FreeImage_Unload(fiBitmap);
-					delete[] tempData;
 				}
 			}
 			else
@@ -460,14 +442,32 @@ unsigned char* ImageIO::loadFromMemoryRGBA32Ex(const unsigned char * data, const
 					{
 						Vector2i sz = adjustPictureSize(Vector2i(width, height), Vector2i(maxWidth, maxHeight), externZoom);
 						if (sz.x() != width || sz.y() != height)
-						{							
-							FIBITMAP* imageRescaled = FreeImage_Rescale(fiBitmap, sz.x(), sz.y(), FILTER_BOX);
-							FreeImage_Unload(fiBitmap);
-							fiBitmap = imageRescaled;
-
-							width = FreeImage_GetWidth(fiBitmap);
-							height = FreeImage_GetHeight(fiBitmap);
-							
+						{
+							// Exact halvings are much cheaper than the generic filter, which only does what remains
+							while (width / 2 >= sz.x() && height / 2 >= sz.y())
+							{
+								FIBITMAP* imageHalved = FreeImage_Allocate((int)width / 2, (int)height / 2, 32);
+								if (imageHalved == nullptr)
+									break;
+
+								Utils::Pixel::halve(FreeImage_GetBits(fiBitmap), FreeImage_GetPitch(fiBitmap), FreeImage_GetBits(imageHalved), FreeImage_GetPitch(imageHalved), width, height);
+								FreeImage_Unload(fiBitmap);
+								fiBitmap = imageHalved;
+
+								width = FreeImage_GetWidth(fiBitmap);
+								height = FreeImage_GetHeight(fiBitmap);
+							}
+
+							if (sz.x() != width || sz.y() != height)
+							{
+								FIBITMAP* imageRescaled = FreeImage_Rescale(fiBitmap, sz.x(), sz.y(), FILTER_BOX);
+								FreeImage_Unload(fiBitmap);
+								fiBitmap = imageRescaled;
+
+								width = FreeImage_GetWidth(fiBitmap);
+								height = FreeImage_GetHeight(fiBitmap);
+							}
+
 							packedSize = Vector2i(width, height);
 						}
 					}
@@ -477,18 +477,8 @@ unsigned char* ImageIO::loadFromMemoryRGBA32Ex(const unsigned char * data, const
 
 					unsigned char* tempData = new unsigned char[width * height * 4];
 
-					int w = (int)width;
-
-					for (int y = (int)height; --y >= 0; )
-					{
-						unsigned int* argb = (unsigned int*)FreeImage_GetScanLine(fiBitmap, y);
-						unsigned int* abgr = (unsigned int*)(tempData + (y * width * 4));
-						for (int x = w; --x >= 0;)
-						{
-							unsigned int c = argb[x];
-							abgr[x] = (c & 0xFF00FF00) | ((c & 0xFF) << 16) | ((c >> 16) & 0xFF);
-						}
-					}
+					for (size_t y = 0; y < height; y++)
+						Utils::Pixel::swapRedBlue(FreeImage_GetScanLine(fiBitmap, (int)y), tempData + (y * width * 4), width);
 				
 					FreeImage_Unload(fiBitmap);
 					FreeImage_CloseMemory(fiMemory);
@@ -514,15 +504,5 @@ unsigned char* ImageIO::loadFromMemoryRGBA32Ex(const unsigned char * data, const
 
 void ImageIO::flipPixelsVert(unsigned char* imagePx, const size_t& width, const size_t& height)
 {
-	unsigned int temp;
-	unsigned int* arr = (unsigned int*)imagePx;
-	for(size_t y = 0; y < height / 2; y++)
-	{
-		for(size_t x = 0; x < width; x++)
-		{
-			temp = arr[x + (y * width)];
-			arr[x + (y * width)] = arr[x + (height * width) - ((y + 1) * width)];
-			arr[x + (height * width) - ((y + 1) * width)] = temp;
-		}
-	}
+	Utils::Pixel::flipVertical(imagePx, width, height);
 }
@@ -7,8 +7,27 @@
 #include "Settings.h"
 #include <iomanip> 
 #include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <thread>
 
-static std::mutex mLogLock;
+static std::recursive_mutex mLogLock;
+
+// Lines are formatted by the calling thread and queued, a background thread writes them to the file.
+// Past this size, callers wait for the writer to catch up
+#define LOG_QUEUE_MAX_SIZE (1024 * 1024)
+
+static std::mutex sQueueLock;
+static std::condition_variable sQueueEvent;
+static std::condition_variable sQueueDrained;
+static std::string sQueue;
+static bool sWriting = false;
+static bool sFlushRequested = false;
+static bool sWriterExit = false;
+static std::thread* sWriter = nullptr;
+
+// Read by every log line, from any thread
+static BoolSetting sLogWithMilliseconds("LogWithMilliseconds");
 
 LogLevel Log::reportingLevel = LogInfo;
 bool Log::dirty = false;
@@ -31,7 +50,7 @@ void Log::setReportingLevel(LogLevel level)
 
 void Log::init()
 {
-	std::unique_lock<std::mutex> lock(mLogLock);
+	std::unique_lock<std::recursive_mutex> lock(mLogLock);
 
 	if (file != NULL)
 		close();
@@ -47,8 +66,84 @@ void Log::init()
 	// rename previous log file
 	rename(getLogPath().c_str(), (getLogPath() + ".bak").c_str());
 
-	file = fopen(getLogPath().c_str(), "w");
+	FILE* newFile = fopen(getLogPath().c_str(), "w");
+	if (newFile == NULL)
+		return;
+
+	// ~Log & onCrash may run on other threads meanwhile
+	std::unique_lock<std::mutex> queueLock(sQueueLock);
+
+	file = newFile;
 	dirty = false;
+	sFlushRequested = false;
+	sWriterExit = false;
+	sWriter = new std::thread(&Log::run);
+
+	queueLock.unlock();
+
+	static bool crashHandlers = false;
+	if (!crashHandlers)
+	{
+		crashHandlers = true;
+
+		int signals[] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };
+		for (auto sig : signals)
+			signal(sig, &Log::onCrash);
+	}
+}
+
+void Log::run()
+{
+	std::string buffer;
+
+	std::unique_lock<std::mutex> lock(sQueueLock);
+
+	// The file stays open until close() has joined this thread
+	FILE* output = file;
+
+	while (true)
+	{
+		sQueueEvent.wait(lock, [] { return sWriterExit || sFlushRequested || !sQueue.empty(); });
+		if (sWriterExit && sQueue.empty())
+			break;
+
+		buffer.swap(sQueue);
+		bool flushFile = sFlushRequested;
+		sFlushRequested = false;
+		sWriting = true;
+		lock.unlock();
+
+		if (!buffer.empty())
+			fwrite(buffer.c_str(), 1, buffer.size(), output);
+
+		if (flushFile)
+			fflush(output);
+
+		buffer.clear();
+
+		lock.lock();
+		sWriting = false;
+		sQueueDrained.notify_all();
+	}
+}
+
+// Best effort to keep the last lines : the crashing thread may be the one holding the lock
+void Log::onCrash(int sig)
+{
+	if (sQueueLock.try_lock())
+	{
+		if (file != NULL)
+		{
+			fwrite(sQueue.c_str(), 1, sQueue.size(), file);
+			fflush(file);
+		}
+
+		sQueue.clear();
+		sQueueLock.unlock();
+	}
+
+	signal(sig, SIG_DFL);
+	raise(sig);
 }
 
 std::ostringstream& Log::get(LogLevel level)
@@ -60,12 +155,21 @@ std::ostringstream& Log::get(LogLevel level)
 
 	time_t raw_time = std::chrono::system_clock::to_time_t(tp);
 
-		// Tm* does not need to be deleted after use, because tm* is created by localtime, and there will be one in each thread
-	struct tm  *timeinfo = std::localtime(&raw_time);
+	// The date part only changes once per second
+	thread_local time_t lastTime = 0;
+	thread_local char lastTimeString[32] = { 0 };
+
+	if (raw_time != lastTime)
+	{
+		struct tm timeinfo;
+		localtime_r(&raw_time, &timeinfo);
+		strftime(lastTimeString, sizeof(lastTimeString), "%F %T", &timeinfo);
+		lastTime = raw_time;
+	}
 
-	os << std::put_time(timeinfo, "%F %T");
+	os << lastTimeString;
 
-	if (Settings::getInstance()->getBool("LogWithMilliseconds"))
+	if (sLogWithMilliseconds)
 	{
 			// tm can only go to seconds, milliseconds need to be obtained separately
 		std::chrono::milliseconds ms = std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch());
@@ -101,46 +205,103 @@ std::ostringstream& Log::get(LogLevel level)
 	return os;
 }
 
+// Asks the writer to write the queued lines & flush the file, without waiting for it.
+// Called every frame : the UI thread must never wait for the disk here
 void Log::flush()
 {
-	if (!dirty)
-		return;
+	{
+		std::unique_lock<std::mutex> lock(sQueueLock);
 
-	if (file != nullptr)
-		fflush(file);
+		if (!dirty || sWriter == nullptr)
+			return;
+
+		dirty = false;
+		sFlushRequested = true;
+	}
+
+	sQueueEvent.notify_one();
+}
+
+// Waits for the queued lines to be on disk. For the paths where the process may end right after
+void Log::drain()
+{
+	std::unique_lock<std::mutex> lock(sQueueLock);
+
+	if (sWriter == nullptr)
+		return;
 
 	dirty = false;
+	sFlushRequested = true;
+	sQueueEvent.notify_one();
+
+	sQueueDrained.wait(lock, [] { return sWriter == nullptr || (sQueue.empty() && !sWriting && !sFlushRequested); });
 }
 
 void Log::close()
 {
+	std::unique_lock<std::recursive_mutex> initLock(mLogLock);
+
+	if (sWriter != nullptr)
+	{
+		{
+			std::unique_lock<std::mutex> lock(sQueueLock);
+			sWriterExit = true;
+		}
+
+		sQueueEvent.notify_one();
+		sWriter->join();
+	}
+
+	std::unique_lock<std::mutex> lock(sQueueLock);
+
+	if (sWriter != nullptr)
+	{
+		delete sWriter;
+		sWriter = nullptr;
+		sQueueDrained.notify_all();
+	}
+
 	if (file != NULL)
 	{
+		// Lines queued while the writer was exiting
+		if (!sQueue.empty())
+			fwrite(sQueue.c_str(), 1, sQueue.size(), file);
+
 		fflush(file);
 		fclose(file);
 	}
 
+	sQueue.clear();
+	sFlushRequested = false;
 	dirty = false;
 	file = NULL;
 }
 
 Log::~Log()
 {
-	std::unique_lock<std::mutex> lock(mLogLock);
-
-	if (file != NULL)
-	{
-		os << std::endl;
-		fprintf(file, "%s", os.str().c_str());
-		dirty = true;
-	}
+	os << '\n';
+	std::string line = os.str();
 
 	// If it's an error, also print to console
 	// print all messages if using --debug
 	if (messageLevel == LogError || reportingLevel >= LogDebug)
 	{
-		fprintf(stderr, "%s", os.str().c_str());
+		fprintf(stderr, "%s", line.c_str());
 	}
+
+	std::unique_lock<std::mutex> lock(sQueueLock);
+
+	if (file == NULL || sWriter == nullptr)
+		return;
+
+	sQueueDrained.wait(lock, [] { return sWriter == nullptr || sQueue.size() < LOG_QUEUE_MAX_SIZE; });
+	if (sWriter == nullptr)
+		return;
+
+	sQueue += line;
+	dirty = true;
+
+	sQueueEvent.notify_one();
 }
 
 void Log::setupReportingLevel()
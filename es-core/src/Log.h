@@ -8,8 +8,8 @@
 #define LOG(level) if(!Log::Enabled() || level > Log::getReportingLevel()) ; else Log().get(level)
 
 #define TRYCATCH(m, x) try { x; } \
-catch (const std::exception& e) { LOG(LogError) << m << " Exception " << e.what(); Log::flush(); throw e; } \
-catch (...) { LOG(LogError) << m << " Unknown Exception occured"; Log::flush(); throw; }
+catch (const std::exception& e) { LOG(LogError) << m << " Exception " << e.what(); Log::drain(); throw e; } \
+catch (...) { LOG(LogError) << m << " Unknown Exception occured"; Log::drain(); throw; }
 
 enum LogLevel { LogError, LogWarning, LogInfo, LogDebug };
 
@@ -27,6 +27,7 @@ public:
 	static std::string getLogPath();
 
 	static void flush();
+	static void drain();
 	static void init();
 	static void close();
 
@@ -40,6 +41,10 @@ private:
 	static LogLevel reportingLevel;
 	static bool dirty;
 
+	// Writes the queued lines to the file, see ~Log
+	static void run();
+	static void onCrash(int signal);
+
 	LogLevel messageLevel;
 };
 
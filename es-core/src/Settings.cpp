@@ -42,7 +42,7 @@ std::vector<const char*> settings_dont_save {
 	{ "wait.process.loading" }
 };
 
-Settings::Settings()
+Settings::Settings() : mNextListenerId(0)
 {
 	setDefaults();
 	loadFile();
@@ -68,6 +68,12 @@ void Settings::setDefaults()
 	mBoolMap["InvertButtonsPU"] = false;
 	mBoolMap["InvertButtonsPD"] = false;
 	mBoolMap["ParseGamelistOnly"] = false;
+	mBoolMap["GamelistCache"] = true;
+	mBoolMap["RomDirectoryIndex"] = true;
+	mBoolMap["ThemeCache"] = true;
+	mBoolMap["ThumbnailCache"] = true;
+	mBoolMap["PregenerateThumbnails"] = true;
+	mBoolMap["WatchRomFolders"] = false;
 	mBoolMap["ShowHiddenFiles"] = false;
 	mBoolMap["IgnoreLeadingArticles"] = false;
 	mBoolMap["DrawFramerate"] = false;
@@ -127,6 +133,10 @@ void Settings::setDefaults()
 
 	mIntMap["MaxVRAM"] = 150;
 
+	mIntMap["SystemMetricsInterval"] = 2000; // ms
+	mIntMap["SystemMetricsNetworkInterval"] = 10000; // ms
+	mIntMap["ThumbnailCacheMaxSize"] = 256; // MB, 0 for no limit
+
 	mBoolMap["HideWindow"] = true;
 
 	mStringMap["GameTransitionStyle"] = "fade";
@@ -347,7 +357,7 @@ void Settings::loadFile()
 }
 
 //Print a warning message if the setting we're trying to get doesn't already exist in the map, then return the value in the map.
-#define SETTINGS_GETSET(type, mapName, getMethodName, setMethodName, defaultValue) \
+#define SETTINGS_GETSET(type, mapName, valuesName, getMethodName, setMethodName, defaultValue) \
 type Settings::getMethodName(const std::string& name) \
 { \
 	if(mapName.find(name) == mapName.cend()) \
@@ -365,14 +375,34 @@ bool Settings::setMethodName(const std::string& name, type value) \
 		if (std::find(settings_dont_save.cbegin(), settings_dont_save.cend(), name) == settings_dont_save.cend()) \
 			mWasChanged = true; \
 \
+		{ \
+			std::unique_lock<std::mutex> lock(mValuesLock); \
+			auto it = valuesName.find(name); \
+			if (it != valuesName.cend()) \
+				it->second->store(value); \
+		} \
+\
+		notifyChange(name); \
 		return true; \
 	} \
 	return false; \
+} \
+template<> std::atomic<type>* Settings::getValue<type>(const std::string& name) \
+{ \
+	std::unique_lock<std::mutex> lock(mValuesLock); \
+	auto it = valuesName.find(name); \
+	if (it != valuesName.cend()) \
+		return it->second.get(); \
+\
+	auto def = mapName.find(name); \
+	std::atomic<type>* value = new std::atomic<type>(def == mapName.cend() ? defaultValue : def->second); \
+	valuesName[name] = std::unique_ptr<std::atomic<type>>(value); \
+	return value; \
 }
 
-SETTINGS_GETSET(bool, mBoolMap, getBool, setBool, false);
-SETTINGS_GETSET(int, mIntMap, getInt, setInt, 0);
-SETTINGS_GETSET(float, mFloatMap, getFloat, setFloat, 0.0f);
+SETTINGS_GETSET(bool, mBoolMap, mBoolValues, getBool, setBool, false);
+SETTINGS_GETSET(int, mIntMap, mIntValues, getInt, setInt, 0);
+SETTINGS_GETSET(float, mFloatMap, mFloatValues, getFloat, setFloat, 0.0f);
 //SETTINGS_GETSET(const std::string&, mStringMap, getString, setString, mEmptyString);
 
 std::string Settings::getString(const std::string& name)
@@ -395,8 +425,40 @@ bool Settings::setString(const std::string& name, const std::string& value)
 		if (std::find(settings_dont_save.cbegin(), settings_dont_save.cend(), name) == settings_dont_save.cend())
 			mWasChanged = true;
 
+		notifyChange(name);
 		return true;
 	}
 
 	return false;
 }
+
+int Settings::addChangeListener(const std::string& name, const std::function<void()>& func)
+{
+	std::unique_lock<std::mutex> lock(mListenersLock);
+
+	int id = ++mNextListenerId;
+	mListeners[id] = std::make_pair(name, func);
+	return id;
+}
+
+void Settings::removeChangeListener(int id)
+{
+	std::unique_lock<std::mutex> lock(mListenersLock);
+	mListeners.erase(id);
+}
+
+void Settings::notifyChange(const std::string& name)
+{
+	// Copied first : listeners are called without the lock, they may add or remove listeners
+	std::vector<std::function<void()>> funcs;
+
+	{
+		std::unique_lock<std::mutex> lock(mListenersLock);
+		for (auto it = mListeners.cbegin(); it != mListeners.cend(); it++)
+			if (it->second.first == name)
+				funcs.push_back(it->second.second);
+	}
+
+	for (auto& func : funcs)
+		func();
+}
@@ -2,7 +2,11 @@
 #ifndef ES_CORE_SETTINGS_H
 #define ES_CORE_SETTINGS_H
 
+#include <atomic>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -33,6 +37,12 @@ public:
 
 	std::map<std::string, std::string>& getStringMap() { return mStringMap; }
 
+	// func is called synchronously on the thread changing the setting, once the new value is stored.
+	// The setters are only called from the UI thread (the value maps aren't locked), so that's where listeners run.
+	// Listeners can be added and removed from any thread. Returns an id for removeChangeListener
+	int addChangeListener(const std::string& name, const std::function<void()>& func);
+	void removeChangeListener(int id);
+
 	DEFINE_BOOL_SETTING(PreloadMedias)
 	DEFINE_BOOL_SETTING(ShowHiddenFiles)
 	DEFINE_BOOL_SETTING(HiddenSystemsShowGames)
@@ -48,6 +58,12 @@ private:
 
 	Settings();
 
+	template<typename T> friend class SettingHandle;
+
+	// Values behind the SettingHandles, created on first use and never freed
+	template<typename T> std::atomic<T>* getValue(const std::string& name);
+	void notifyChange(const std::string& name);
+
 	//Clear everything and load default values.
 	void setDefaults();
 
@@ -63,6 +79,59 @@ private:
 	std::map<std::string, int> mDefaultIntMap;
 	std::map<std::string, float> mDefaultFloatMap;
 	std::map<std::string, std::string> mDefaultStringMap;
+
+	std::mutex mValuesLock;
+	std::map<std::string, std::unique_ptr<std::atomic<bool>>> mBoolValues;
+	std::map<std::string, std::unique_ptr<std::atomic<int>>> mIntValues;
+	std::map<std::string, std::unique_ptr<std::atomic<float>>> mFloatValues;
+
+	std::mutex mListenersLock;
+	int mNextListenerId;
+	std::map<int, std::pair<std::string, std::function<void()>>> mListeners;
 };
 
+template<> std::atomic<bool>* Settings::getValue<bool>(const std::string& name);
+template<> std::atomic<int>* Settings::getValue<int>(const std::string& name);
+template<> std::atomic<float>* Settings::getValue<float>(const std::string& name);
+
+// Typed access to a bool, int or float setting. The name is resolved on first use, then reading is a
+// relaxed atomic load : no map lookup nor temporary string, and safe from the loader threads.
+// Writes still go through Settings, which keeps the value of the handles up to date.
+template<typename T>
+class SettingHandle
+{
+public:
+	SettingHandle(const char* name) : mName(name), mValue(nullptr) { }
+
+	T get() const
+	{
+		std::atomic<T>* value = mValue.load(std::memory_order_acquire);
+		if (value == nullptr)
+		{
+			value = Settings::getInstance()->getValue<T>(mName);
+			mValue.store(value, std::memory_order_release);
+		}
+
+		return value->load(std::memory_order_relaxed);
+	}
+
+	operator T() const { return get(); }
+
+	bool set(T value);
+
+	const std::string& getName() const { return mName; }
+
+private:
+	std::string mName;
+	mutable std::atomic<std::atomic<T>*> mValue;
+};
+
+typedef SettingHandle<bool> BoolSetting;
+typedef SettingHandle<int> IntSetting;
+typedef SettingHandle<float> FloatSetting;
+
+template<> inline bool SettingHandle<bool>::set(bool value) { return Settings::getInstance()->setBool(mName, value); }
+template<> inline bool SettingHandle<int>::set(int value) { return Settings::getInstance()->setInt(mName, value); }
+template<> inline bool SettingHandle<float>::set(float value) { return Settings::getInstance()->setFloat(mName, value); }
+
 #endif // ES_CORE_SETTINGS_H
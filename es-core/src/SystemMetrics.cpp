@@ -0,0 +1,359 @@
+#include "SystemMetrics.h"
+
+#include "utils/StringUtil.h"
+#include "Log.h"
+#include "Settings.h"
+
+#include <SDL_timer.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static IntSetting sSystemMetricsInterval("SystemMetricsInterval");
+static IntSetting sSystemMetricsNetworkInterval("SystemMetricsNetworkInterval");
+
+// Sysfs & procfs file opened once and read again from the start at each sample
+class SysfsFile
+{
+public:
+	SysfsFile() : mFd(-1) { }
+	~SysfsFile() { close(); }
+
+	bool open(const std::string& path)
+	{
+		close();
+		mFd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		return mFd >= 0;
+	}
+
+	void close()
+	{
+		if (mFd >= 0)
+			::close(mFd);
+
+		mFd = -1;
+	}
+
+	bool isOpen() const { return mFd >= 0; }
+
+	// Reads the whole file into buffer, returns the size read or -1
+	int read(char* buffer, int size)
+	{
+		if (mFd < 0)
+			return -1;
+
+		ssize_t count = pread(mFd, buffer, size - 1, 0);
+		if (count < 0)
+			return -1;
+
+		buffer[count] = 0;
+		return (int)count;
+	}
+
+	std::string readString()
+	{
+		char buffer[64];
+		if (read(buffer, sizeof(buffer)) <= 0)
+			return "";
+
+		return Utils::String::replace(buffer, "\n", "");
+	}
+
+	long long readInt(long long defaultValue = 0)
+	{
+		char buffer[32];
+		if (read(buffer, sizeof(buffer)) <= 0)
+			return defaultValue;
+
+		return atoll(buffer);
+	}
+
+private:
+	int mFd;
+};
+
+class SystemMetricsSampler
+{
+public:
+	SystemMetricsSampler() : mIdle(0), mTotal(0), mLastNetworkSample(0)
+	{
+		std::string batteryRootPath = queryBatteryRootPath();
+		if (!batteryRootPath.empty())
+		{
+			mBatteryCapacity.open(batteryRootPath + "/capacity");
+			mBatteryStatus.open(batteryRootPath + "/status");
+			mBatteryVoltage.open(batteryRootPath + "/voltage_now");
+			mBatteryHealth.open(batteryRootPath + "/health");
+			mBatteryChargeFull.open(batteryRootPath + "/charge_full");
+		}
+
+		mCpuTemperature.open("/sys/devices/virtual/thermal/thermal_zone0/temp");
+		mGpuTemperature.open("/sys/devices/virtual/thermal/thermal_zone1/temp");
+
+		if (!mCpuFrequency.open("/sys/devices/system/cpu/cpufreq/policy0/scaling_cur_freq"))
+			mCpuFrequency.open("/sys/devices/system/cpu/cpufreq/policy0/cpuinfo_cur_freq");
+
+		mGpuFrequency.open("/sys/devices/platform/ff400000.gpu/devfreq/ff400000.gpu/cur_freq");
+		mCpuGovernor.open("/sys/devices/system/cpu/cpufreq/policy0/scaling_governor");
+		mStat.open("/proc/stat");
+		mMemInfo.open("/proc/meminfo");
+		mWifiState.open("/sys/class/net/wlan0/operstate");
+
+		// Runs lscpu & co : never on the UI thread
+		mChipset = queryCpuAndChipsetInformation(false);
+	}
+
+	std::shared_ptr<SystemMetricsSnapshot> sample(const std::shared_ptr<const SystemMetricsSnapshot>& previous, bool networkDetails)
+	{
+		auto ret = std::make_shared<SystemMetricsSnapshot>();
+
+		int now = SDL_GetTicks();
+		bool slow = previous == nullptr || now - mLastNetworkSample >= sSystemMetricsNetworkInterval || networkDetails != previous->networkDetailed;
+
+		if (mBatteryCapacity.isOpen())
+		{
+			ret->battery.hasBattery = true;
+			ret->battery.level = (int)mBatteryCapacity.readInt();
+			ret->battery.isCharging = Utils::String::compareIgnoreCase(mBatteryStatus.readString(), "discharging") != 0;
+			ret->battery.voltage = mBatteryVoltage.readInt() / 1000000.0f; // volts
+
+			if (slow)
+			{
+				ret->battery.health = Utils::String::toLower(mBatteryHealth.readString());
+				ret->battery.max_capacity = (int)(mBatteryChargeFull.readInt() / 1000); // milli amperes
+			}
+			else
+			{
+				ret->battery.health = previous->battery.health;
+				ret->battery.max_capacity = previous->battery.max_capacity;
+			}
+		}
+
+		ret->cpuLoad = readCpuLoad();
+		ret->cpuTemperature = mCpuTemperature.readInt() / 1000.0f;
+		ret->cpuFrequency = (int)(mCpuFrequency.readInt() / 1000); // MHZ
+		ret->gpuTemperature = mGpuTemperature.readInt() / 1000.0f;
+		ret->gpuFrequency = (int)(mGpuFrequency.readInt() / 1000000); // MHZ
+		ret->memory = readMemory();
+
+		std::string state = mWifiState.readString();
+		ret->wifiConnected = state.find("up") != std::string::npos;
+
+		if (slow)
+		{
+			// getifaddrs & one nmcli call when connected on wifi, hence the longer interval
+			ret->network = queryNetworkInformation(!networkDetails);
+			ret->networkDetailed = networkDetails;
+			mLastNetworkSample = now;
+		}
+		else
+		{
+			ret->network = previous->network;
+			ret->networkDetailed = previous->networkDetailed;
+		}
+
+		if (slow && mCpuGovernor.isOpen())
+			mChipset.governor = Utils::String::replace(mCpuGovernor.readString(), "_", " ");
+
+		ret->chipset = mChipset;
+		ret->chipset.cpu_load = ret->cpuLoad;
+		ret->chipset.temperature = ret->cpuTemperature;
+		ret->chipset.frequency = ret->cpuFrequency;
+
+		return ret;
+	}
+
+private:
+	// Usage since the previous sample, from the counters of the first line of /proc/stat
+	float readCpuLoad()
+	{
+		char buffer[256];
+		if (mStat.read(buffer, sizeof(buffer)) <= 0 || strncmp(buffer, "cpu ", 4) != 0)
+			return 0.f;
+
+		unsigned long long values[8] = { 0 };
+		char* p = buffer + 4;
+
+		for (int i = 0; i < 8; i++)
+			values[i] = strtoull(p, &p, 10);
+
+		unsigned long long idle = values[3] + values[4]; // idle + iowait
+		unsigned long long total = 0;
+		for (int i = 0; i < 8; i++)
+			total += values[i];
+
+		float load = 0.f;
+		if (mTotal != 0 && total > mTotal)
+			load = 100.0f * (1.0f - (float)(idle - mIdle) / (float)(total - mTotal));
+
+		mIdle = idle;
+		mTotal = total;
+		return load;
+	}
+
+	// In MiB, like top
+	RamMemoryInformation readMemory()
+	{
+		RamMemoryInformation memory;
+
+		char buffer[2048];
+		if (mMemInfo.read(buffer, sizeof(buffer)) <= 0)
+			return memory;
+
+		float total = 0, free = 0, buffers = 0, cached = 0, reclaimable = 0;
+
+		for (char* line = buffer; line != nullptr && *line != 0; )
+		{
+			char* value = strchr(line, ':');
+			if (value == nullptr)
+				break;
+
+			float kb = (float)strtoull(value + 1, nullptr, 10);
+
+			if (strncmp(line, "MemTotal:", 9) == 0) total = kb;
+			else if (strncmp(line, "MemFree:", 8) == 0) free = kb;
+			else if (strncmp(line, "Buffers:", 8) == 0) buffers = kb;
+			else if (strncmp(line, "Cached:", 7) == 0) cached = kb;
+			else if (strncmp(line, "SReclaimable:", 13) == 0) reclaimable = kb;
+
+			line = strchr(value, '\n');
+			if (line != nullptr)
+				line++;
+		}
+
+		memory.total = total / 1024.0f;
+		memory.free = free / 1024.0f;
+		memory.cached = (buffers + cached + reclaimable) / 1024.0f;
+		memory.used = memory.total - memory.free - memory.cached;
+		return memory;
+	}
+
+	SysfsFile mBatteryCapacity;
+	SysfsFile mBatteryStatus;
+	SysfsFile mBatteryVoltage;
+	SysfsFile mBatteryHealth;
+	SysfsFile mBatteryChargeFull;
+	SysfsFile mCpuTemperature;
+	SysfsFile mCpuFrequency;
+	SysfsFile mGpuTemperature;
+	SysfsFile mGpuFrequency;
+	SysfsFile mStat;
+	SysfsFile mMemInfo;
+	SysfsFile mWifiState;
+	SysfsFile mCpuGovernor;
+
+	CpuAndSocketInformation mChipset;
+
+	unsigned long long mIdle;
+	unsigned long long mTotal;
+	int mLastNetworkSample;
+};
+
+static std::shared_ptr<const SystemMetricsSnapshot> sSnapshot;
+
+static std::mutex sLock;
+static std::condition_variable sEvent;
+static std::thread* sThread = nullptr;
+static bool sExit = false;
+static bool sWake = false;
+static std::atomic<bool> sPaused(false);
+static std::atomic<int> sNetworkDetails(0); // Alive handles of requestNetworkDetails
+
+static void run()
+{
+	LOG(LogDebug) << "SystemMetrics::run() - Started";
+
+	SystemMetricsSampler sampler;
+
+	std::unique_lock<std::mutex> lock(sLock);
+
+	while (!sExit)
+	{
+		if (!sPaused)
+		{
+			lock.unlock();
+			std::atomic_store(&sSnapshot, std::shared_ptr<const SystemMetricsSnapshot>(sampler.sample(std::atomic_load(&sSnapshot), sNetworkDetails > 0)));
+			lock.lock();
+		}
+
+		int interval = sSystemMetricsInterval;
+		if (interval < 250)
+			interval = 250;
+
+		sEvent.wait_for(lock, std::chrono::milliseconds(interval), [] { return sExit || sWake; });
+		sWake = false;
+	}
+
+	LOG(LogDebug) << "SystemMetrics::run() - Stopped";
+}
+
+static void wake()
+{
+	{
+		std::unique_lock<std::mutex> lock(sLock);
+		sWake = true;
+	}
+
+	sEvent.notify_all();
+}
+
+void SystemMetrics::start()
+{
+	std::unique_lock<std::mutex> lock(sLock);
+	if (sThread != nullptr)
+		return;
+
+	sExit = false;
+	sThread = new std::thread(run);
+}
+
+void SystemMetrics::stop()
+{
+	std::thread* thread = nullptr;
+
+	{
+		std::unique_lock<std::mutex> lock(sLock);
+		sExit = true;
+		thread = sThread;
+		sThread = nullptr;
+	}
+
+	sEvent.notify_all();
+
+	if (thread != nullptr)
+	{
+		thread->join();
+		delete thread;
+	}
+}
+
+void SystemMetrics::pause()
+{
+	sPaused = true;
+}
+
+void SystemMetrics::resume()
+{
+	sPaused = false;
+
+	// Values are outdated after a game, take a sample now
+	wake();
+}
+
+std::shared_ptr<const SystemMetricsSnapshot> SystemMetrics::get()
+{
+	return std::atomic_load(&sSnapshot);
+}
+
+std::shared_ptr<void> SystemMetrics::requestNetworkDetails()
+{
+	if (sNetworkDetails++ == 0)
+		wake();
+
+	return std::shared_ptr<void>(nullptr, [](void*) { sNetworkDetails--; });
+}
@@ -0,0 +1,56 @@
+#pragma once
+#ifndef ES_CORE_SYSTEM_METRICS_H
+#define ES_CORE_SYSTEM_METRICS_H
+
+#include "platform.h"
+#include <memory>
+
+// Values read by the SystemMetrics thread. A snapshot is never modified once published
+struct SystemMetricsSnapshot
+{
+	SystemMetricsSnapshot()
+	{
+		cpuLoad = 0.f;
+		cpuTemperature = 0.f;
+		cpuFrequency = 0;
+		gpuTemperature = 0.f;
+		gpuFrequency = 0;
+		wifiConnected = false;
+		networkDetailed = false;
+	}
+
+	BatteryInformation battery;
+	float cpuLoad;
+	float cpuTemperature;
+	int cpuFrequency;
+	float gpuTemperature;
+	int gpuFrequency;
+	RamMemoryInformation memory;
+	bool wifiConnected; // same as queryNetworkConnectedFast()
+	NetworkInformation network; // refreshed at the network interval. Summary, unless networkDetailed
+	bool networkDetailed; // network has every field (dns, wifi...) : details are requested
+	CpuAndSocketInformation chipset; // queried once (lscpu...), with the load, temperature & frequency of this sample. The governor is refreshed at the network interval
+};
+
+// Background thread sampling battery, CPU, GPU, memory and network, so the UI never reads sysfs nor runs
+// a shell command to refresh them. Sysfs files are kept open and read again with pread.
+// Intervals come from the SystemMetricsInterval & SystemMetricsNetworkInterval settings (ms).
+class SystemMetrics
+{
+public:
+	static void start();
+	static void stop();
+
+	// No sampling while a game is running
+	static void pause();
+	static void resume();
+
+	// Never blocks. nullptr until the first sample is done
+	static std::shared_ptr<const SystemMetricsSnapshot> get();
+
+	// The full network information (about 7 nmcli calls) is sampled while one of the returned handles is alive.
+	// The first detailed sample is taken right away
+	static std::shared_ptr<void> requestNetworkDetails();
+};
+
+#endif // ES_CORE_SYSTEM_METRICS_H
@@ -0,0 +1,353 @@
+#include "ThemeCache.h"
+
+#include "renderers/Renderer.h"
+#include "resources/ResourceManager.h"
+#include "utils/BinaryFileUtil.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "Log.h"
+#include "Settings.h"
+#include "ThemeData.h"
+
+#include <algorithm>
+#include <sys/stat.h>
+
+#define THEME_CACHE_MAGIC   0x48545345 // "ESTH"
+#define THEME_CACHE_VERSION 2
+
+namespace
+{
+	void getFileKey(const std::string& path, int64_t& mtime, int64_t& size)
+	{
+		struct stat64 info;
+		if (stat64(path.c_str(), &info) != 0)
+		{
+			mtime = 0;
+			size = -1;
+			return;
+		}
+
+		mtime = (int64_t)info.st_mtime;
+		size = (int64_t)info.st_size;
+	}
+
+	void writeFileKey(Utils::BinaryWriter& writer, const std::string& path)
+	{
+		int64_t mtime, size;
+		getFileKey(ResourceManager::getInstance()->getResourcePath(path), mtime, size);
+
+		writer.writeString(path);
+		writer.write<int64_t>(mtime);
+		writer.write<int64_t>(size);
+	}
+
+	// Reads a file written by writeFileKey. Returns false if the file changed since
+	bool readFileKey(Utils::BinaryReader& reader, std::string& path)
+	{
+		path = reader.readString();
+		int64_t mtime = reader.read<int64_t>();
+		int64_t size = reader.read<int64_t>();
+
+		// ":/" paths are resolved again : a file added to the user resources overrides the bundled one
+		int64_t fileMtime, fileSize;
+		getFileKey(ResourceManager::getInstance()->getResourcePath(path), fileMtime, fileSize);
+
+		return reader.isValid() && mtime == fileMtime && size == fileSize;
+	}
+
+	void writeStrings(Utils::BinaryWriter& writer, const std::vector<std::string>& values)
+	{
+		writer.write<uint32_t>((uint32_t)values.size());
+		for (auto& value : values)
+			writer.writeString(value);
+	}
+
+	std::vector<std::string> readStrings(Utils::BinaryReader& reader)
+	{
+		std::vector<std::string> values;
+
+		uint32_t count = reader.read<uint32_t>();
+		for (uint32_t i = 0; i < count && reader.isValid(); i++)
+			values.push_back(reader.readString());
+
+		return values;
+	}
+}
+
+std::string ThemeCache::getCachePath()
+{
+	return Utils::FileSystem::getEsConfigPath() + "/cache/themes";
+}
+
+std::string ThemeCache::getCacheFile(const std::string& name)
+{
+	return getCachePath() + "/" + (name.empty() ? "default" : name) + ".bin";
+}
+
+std::string ThemeCache::getSignature(ThemeData* theme, const std::string& path)
+{
+	std::stringstream ss;
+	ss << path << "\n" << theme->mSystemThemeFolder << "\n";
+
+	// System variables
+	for (auto& variable : theme->mVariables)
+		ss << variable.first << "=" << variable.second << "\n";
+
+	// Subsets, filters
+	ss << theme->mColorset << "\n" << theme->mIconset << "\n" << theme->mMenu << "\n" << theme->mSystemview << "\n" << theme->mGamelistview << "\n";
+	ss << theme->mLanguage << "\n" << theme->mRegion << "\n";
+	ss << Renderer::isSmallScreen() << Settings::getInstance()->getBool("ShowHelpPrompts") << "\n";
+
+	for (auto& setting : Settings::getInstance()->getStringMap())
+		if (Utils::String::startsWith(setting.first, "subset."))
+			ss << setting.first << "=" << setting.second << "\n";
+
+	return ss.str();
+}
+
+bool ThemeCache::load(ThemeData* theme, const std::string& name, const std::string& path, const std::string& signature)
+{
+	if (!Settings::getInstance()->getBool("ThemeCache"))
+		return false;
+
+	std::string cacheFile = getCacheFile(name);
+
+	Utils::MappedFile mapped(cacheFile);
+	if (mapped.data() == nullptr)
+		return false;
+
+	Utils::BinaryReader reader(mapped.data(), mapped.size());
+
+	if (reader.read<uint32_t>() != THEME_CACHE_MAGIC || reader.read<uint32_t>() != THEME_CACHE_VERSION)
+		return false;
+
+	if (reader.readString() != signature)
+	{
+		LOG(LogDebug) << "ThemeCache::load() - Settings changed for \"" << name << "\"";
+		return false;
+	}
+
+	// Theme files
+	std::vector<std::string> includes;
+
+	uint32_t files = reader.read<uint32_t>();
+	for (uint32_t i = 0; i < files && reader.isValid(); i++)
+	{
+		std::string file;
+		if (!readFileKey(reader, file))
+		{
+			LOG(LogDebug) << "ThemeCache::load() - Snapshot is stale for \"" << name << "\"";
+			return false;
+		}
+
+		if (i > 0)
+			includes.push_back(file);
+	}
+
+	// Images & other files of the PATH properties, missing ones included
+	std::set<std::string> resources;
+
+	files = reader.read<uint32_t>();
+	for (uint32_t i = 0; i < files && reader.isValid(); i++)
+	{
+		std::string file;
+		if (!readFileKey(reader, file))
+		{
+			LOG(LogDebug) << "ThemeCache::load() - Theme resources changed for \"" << name << "\"";
+			return false;
+		}
+
+		resources.insert(file);
+	}
+
+	float version = reader.read<float>();
+	std::string defaultView = reader.readString();
+
+	std::map<std::string, std::string> variables;
+
+	uint32_t count = reader.read<uint32_t>();
+	for (uint32_t i = 0; i < count && reader.isValid(); i++)
+	{
+		std::string key = reader.readString();
+		variables[key] = reader.readString();
+	}
+
+	std::vector<Subset> subsets;
+
+	count = reader.read<uint32_t>();
+	for (uint32_t i = 0; i < count && reader.isValid(); i++)
+	{
+		std::string subset = reader.readString();
+		std::string subsetName = reader.readString();
+		std::string displayName = reader.readString();
+		std::string subSetDisplayName = reader.readString();
+
+		Subset item(subset, subsetName, displayName, subSetDisplayName);
+		item.appliesTo = readStrings(reader);
+		subsets.push_back(item);
+	}
+
+	ThemeData::UnsortedViewMap views;
+
+	count = reader.read<uint32_t>();
+	for (uint32_t i = 0; i < count && reader.isValid(); i++)
+	{
+		std::string viewName = reader.readString();
+
+		ThemeData::ThemeView view;
+		view.baseType = reader.readString();
+		view.displayName = reader.readString();
+		view.isCustomView = reader.read<uint8_t>() != 0;
+		view.baseTypes = readStrings(reader);
+		view.orderedKeys = readStrings(reader);
+
+		uint32_t elements = reader.read<uint32_t>();
+		for (uint32_t e = 0; e < elements && reader.isValid(); e++)
+		{
+			std::string key = reader.readString();
+
+			ThemeData::ThemeElement& element = view.elements[key];
+			element.type = reader.readString();
+			element.extra = reader.read<int32_t>();
+
+			uint16_t properties = reader.read<uint16_t>();
+			for (uint16_t p = 0; p < properties && reader.isValid(); p++)
+			{
+				ThemeData::ThemeElement::Property prop;
+				memset(&prop, 0, sizeof(prop));
+
+				// Ids are only valid for this process, the names are stored
+				prop.id = ThemeData::getPropertyId(reader.readString());
+				prop.isString = reader.read<uint8_t>() != 0;
+
+				if (prop.isString)
+				{
+					prop.i = (unsigned int)element.strings.size();
+					element.strings.push_back(reader.readString());
+				}
+				else
+				{
+					uint32_t words[4];
+					for (int w = 0; w < 4; w++)
+						words[w] = reader.read<uint32_t>();
+
+					memcpy(prop.r, words, sizeof(words));
+				}
+
+				element.properties.push_back(prop);
+			}
+
+			std::sort(element.properties.begin(), element.properties.end(), [](const ThemeData::ThemeElement::Property& a, const ThemeData::ThemeElement::Property& b) { return a.id < b.id; });
+		}
+
+		views.push_back(std::pair<std::string, ThemeData::ThemeView>(viewName, view));
+	}
+
+	if (!reader.isValid())
+	{
+		LOG(LogError) << "ThemeCache::load() - Snapshot \"" << cacheFile << "\" is truncated";
+		return false;
+	}
+
+	theme->mVersion = version;
+	theme->mDefaultView = defaultView;
+	theme->mVariables = variables;
+	theme->mSubsets = subsets;
+	theme->mViews = views;
+	theme->mIncludedFiles = includes;
+	theme->mResourceFiles = resources;
+
+	LOG(LogDebug) << "ThemeCache::load() - Loaded \"" << cacheFile << "\"";
+	return true;
+}
+
+bool ThemeCache::save(ThemeData* theme, const std::string& name, const std::string& path, const std::string& signature)
+{
+	if (!Settings::getInstance()->getBool("ThemeCache"))
+		return false;
+
+	Utils::BinaryWriter writer;
+	writer.write<uint32_t>(THEME_CACHE_MAGIC);
+	writer.write<uint32_t>(THEME_CACHE_VERSION);
+	writer.writeString(signature);
+
+	// Theme files
+	writer.write<uint32_t>((uint32_t)theme->mIncludedFiles.size() + 1);
+
+	writeFileKey(writer, path);
+	for (auto& file : theme->mIncludedFiles)
+		writeFileKey(writer, file);
+
+	writer.write<uint32_t>((uint32_t)theme->mResourceFiles.size());
+	for (auto& file : theme->mResourceFiles)
+		writeFileKey(writer, file);
+
+	writer.write<float>(theme->mVersion);
+	writer.writeString(theme->mDefaultView);
+
+	writer.write<uint32_t>((uint32_t)theme->mVariables.size());
+	for (auto& variable : theme->mVariables)
+	{
+		writer.writeString(variable.first);
+		writer.writeString(variable.second);
+	}
+
+	writer.write<uint32_t>((uint32_t)theme->mSubsets.size());
+	for (auto& subset : theme->mSubsets)
+	{
+		writer.writeString(subset.subset);
+		writer.writeString(subset.name);
+		writer.writeString(subset.displayName);
+		writer.writeString(subset.subSetDisplayName);
+		writeStrings(writer, subset.appliesTo);
+	}
+
+	writer.write<uint32_t>((uint32_t)theme->mViews.size());
+	for (auto& view : theme->mViews)
+	{
+		writer.writeString(view.first);
+		writer.writeString(view.second.baseType);
+		writer.writeString(view.second.displayName);
+		writer.write<uint8_t>(view.second.isCustomView ? 1 : 0);
+		writeStrings(writer, view.second.baseTypes);
+		writeStrings(writer, view.second.orderedKeys);
+
+		writer.write<uint32_t>((uint32_t)view.second.elements.size());
+		for (auto& element : view.second.elements)
+		{
+			writer.writeString(element.first);
+			writer.writeString(element.second.type);
+			writer.write<int32_t>(element.second.extra);
+
+			writer.write<uint16_t>((uint16_t)element.second.properties.size());
+			for (auto& prop : element.second.properties)
+			{
+				writer.writeString(ThemeData::getPropertyName(prop.id));
+				writer.write<uint8_t>(prop.isString ? 1 : 0);
+
+				if (prop.isString)
+					writer.writeString(element.second.strings[prop.i]);
+				else
+				{
+					uint32_t words[4];
+					memcpy(words, prop.r, sizeof(words));
+
+					for (int w = 0; w < 4; w++)
+						writer.write<uint32_t>(words[w]);
+				}
+			}
+		}
+	}
+
+	std::string cacheFile = getCacheFile(name);
+	if (!writer.save(cacheFile))
+		return false;
+
+	LOG(LogDebug) << "ThemeCache::save() - Saved " << theme->mViews.size() << " views to \"" << cacheFile << "\"";
+	return true;
+}
+
+void ThemeCache::clear()
+{
+	Utils::FileSystem::deleteDirectoryFiles(getCachePath());
+}
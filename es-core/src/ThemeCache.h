@@ -0,0 +1,33 @@
+#pragma once
+#ifndef ES_CORE_THEME_CACHE_H
+#define ES_CORE_THEME_CACHE_H
+
+#include <string>
+
+class ThemeData;
+
+// Binary copy of the views of a system theme once fully resolved (includes, variables, subsets, languages & regions),
+// stored per system in the ES config folder.
+// It is keyed by the size & modification time of every theme file read or probed (PATH properties included, missing files too),
+// and by the settings the resolution depends on :
+// as soon as one of them changes, the snapshot is ignored and the xml files are parsed again.
+class ThemeCache
+{
+public:
+	// Everything, except the theme files, the resolved theme depends on. Must be computed before the theme is parsed.
+	static std::string getSignature(ThemeData* theme, const std::string& path);
+
+	// Restores the views of the theme. Returns false if there is no valid snapshot.
+	static bool load(ThemeData* theme, const std::string& name, const std::string& path, const std::string& signature);
+
+	// Writes a snapshot of a theme that has just been parsed from path.
+	static bool save(ThemeData* theme, const std::string& name, const std::string& path, const std::string& signature);
+
+	static void clear();
+
+private:
+	static std::string getCachePath();
+	static std::string getCacheFile(const std::string& name);
+};
+
+#endif // ES_CORE_THEME_CACHE_H
@@ -1,4 +1,5 @@
 #include "ThemeData.h"
+#include "ThemeCache.h"
 
 #include "components/ImageComponent.h"
 #include "components/TextComponent.h"
@@ -11,6 +12,8 @@
 #include "platform.h"
 #include "Settings.h"
 #include <algorithm>
+#include <mutex>
+#include <sys/stat.h>
 #include "EsLocale.h"
 
 std::vector<std::string> ThemeData::sSupportedViews { { "system" }, { "basic" }, { "detailed" }, { "grid" }, { "video" }, { "menu" }, { "screen" } };
@@ -312,6 +315,133 @@ ThemeData* ThemeData::mDefaultTheme = nullptr;
 #define MINIMUM_THEME_FORMAT_VERSION 3
 #define CURRENT_THEME_FORMAT_VERSION 6
 
+// Parsed theme files, shared by all the systems : the common includes of a theme are read once whatever the number of systems.
+// Cached documents are never modified, so they can be walked by several loading threads at once.
+struct ThemeDocument
+{
+	std::shared_ptr<pugi::xml_document> doc;
+	time_t mtime;
+	off_t  size;
+};
+
+static std::mutex sDocumentCacheLock;
+static std::map<std::string, ThemeDocument> sDocumentCache;
+static size_t sDocumentCacheHits = 0;
+static size_t sDocumentCacheMisses = 0;
+
+// Interned property names
+struct PropertyTable
+{
+	std::unordered_map<std::string, ThemeData::PropertyId> ids;
+	std::vector<std::string> names;
+};
+
+// The properties of sElementMap get the first ids. This table is never modified once built, so it is read without lock
+static const PropertyTable& getKnownProperties(const std::map<std::string, std::map<std::string, ThemeData::ElementPropertyType>>& elementMap)
+{
+	static const PropertyTable table = [&elementMap]
+	{
+		PropertyTable ret;
+
+		for (auto& element : elementMap)
+		{
+			for (auto& prop : element.second)
+			{
+				if (ret.ids.find(prop.first) != ret.ids.cend())
+					continue;
+
+				ret.ids[prop.first] = (ThemeData::PropertyId)ret.names.size();
+				ret.names.push_back(prop.first);
+			}
+		}
+
+		return ret;
+	}();
+
+	return table;
+}
+
+// Names out of sElementMap (menuIcons can be extended by themes) are added after
+static std::mutex sPropertyIdsLock;
+static PropertyTable sExtraProperties;
+
+bool ThemeData::findPropertyId(const std::string& name, PropertyId& id)
+{
+	const PropertyTable& known = getKnownProperties(sElementMap);
+
+	auto it = known.ids.find(name);
+	if (it == known.ids.cend())
+		return false;
+
+	id = it->second;
+	return true;
+}
+
+ThemeData::PropertyId ThemeData::getPropertyId(const std::string& name)
+{
+	PropertyId id;
+	if (findPropertyId(name, id))
+		return id;
+
+	const size_t knownCount = getKnownProperties(sElementMap).names.size();
+
+	std::unique_lock<std::mutex> lock(sPropertyIdsLock);
+
+	auto it = sExtraProperties.ids.find(name);
+	if (it != sExtraProperties.ids.cend())
+		return it->second;
+
+	id = (PropertyId)(knownCount + sExtraProperties.names.size());
+	sExtraProperties.names.push_back(name);
+	sExtraProperties.ids[name] = id;
+	return id;
+}
+
+std::string ThemeData::getPropertyName(PropertyId id)
+{
+	const PropertyTable& known = getKnownProperties(sElementMap);
+	if (id < known.names.size())
+		return known.names[id];
+
+	std::unique_lock<std::mutex> lock(sPropertyIdsLock);
+
+	size_t index = id - known.names.size();
+	if (index < sExtraProperties.names.size())
+		return sExtraProperties.names[index];
+
+	return "";
+}
+
+const ThemeData::ThemeElement::Property* ThemeData::ThemeElement::find(PropertyId id) const
+{
+	auto it = std::lower_bound(properties.cbegin(), properties.cend(), id, [](const Property& prop, PropertyId value) { return prop.id < value; });
+	if (it != properties.cend() && it->id == id)
+		return &(*it);
+
+	return nullptr;
+}
+
+ThemeData::ThemeElement::Property* ThemeData::ThemeElement::getOrAdd(PropertyId id, bool isString)
+{
+	auto it = std::lower_bound(properties.begin(), properties.end(), id, [](const Property& prop, PropertyId value) { return prop.id < value; });
+	if (it == properties.end() || it->id != id)
+	{
+		Property prop;
+		memset(&prop, 0, sizeof(Property));
+		prop.id = id;
+		it = properties.insert(it, prop);
+	}
+
+	if (isString && !it->isString)
+	{
+		it->i = (unsigned int)strings.size();
+		strings.push_back(std::string());
+	}
+
+	it->isString = isString;
+	return &(*it);
+}
+
 // helper
 unsigned int getHexColor(const char* str)
 {
@@ -391,6 +521,60 @@ ThemeData::ThemeData()
 	mVersion = 0;
 }
 
+std::shared_ptr<pugi::xml_document> ThemeData::loadDocument(const std::string& path, std::string& error)
+{
+	struct stat info;
+	if (stat(path.c_str(), &info) != 0)
+	{
+		error = "File does not exist!";
+		return nullptr;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(sDocumentCacheLock);
+
+		auto it = sDocumentCache.find(path);
+		if (it != sDocumentCache.cend() && it->second.mtime == info.st_mtime && it->second.size == info.st_size)
+		{
+			sDocumentCacheHits++;
+			return it->second.doc;
+		}
+
+		sDocumentCacheMisses++;
+	}
+
+	// Parse outside of the lock : other threads can use the files already parsed meanwhile
+	std::shared_ptr<pugi::xml_document> doc = std::make_shared<pugi::xml_document>();
+
+	pugi::xml_parse_result res = doc->load_file(path.c_str());
+	if (!res)
+	{
+		error = res.description();
+		return nullptr;
+	}
+
+	std::unique_lock<std::mutex> lock(sDocumentCacheLock);
+
+	ThemeDocument& entry = sDocumentCache[path];
+	entry.doc = doc;
+	entry.mtime = info.st_mtime;
+	entry.size = info.st_size;
+
+	return doc;
+}
+
+void ThemeData::clearDocumentCache()
+{
+	std::unique_lock<std::mutex> lock(sDocumentCacheLock);
+
+	if (sDocumentCacheHits + sDocumentCacheMisses > 0)
+		LOG(LogDebug) << "ThemeData::clearDocumentCache() - " << sDocumentCache.size() << " files, " << sDocumentCacheHits << " hits, " << sDocumentCacheMisses << " misses";
+
+	sDocumentCache.clear();
+	sDocumentCacheHits = 0;
+	sDocumentCacheMisses = 0;
+}
+
 void ThemeData::loadFile(const std::string system, std::map<std::string, std::string> sysDataMap, const std::string& path)
 {
 	mPaths.push_back(path);
@@ -410,12 +594,26 @@ void ThemeData::loadFile(const std::string system, std::map<std::string, std::st
 	mVariables.insert(sysDataMap.cbegin(), sysDataMap.cend());
 	mVariables["lang"] = mLanguage;
 
-	pugi::xml_document doc;
-	pugi::xml_parse_result res = doc.load_file(path.c_str());
-	if(!res)
-		throw error << "XML parsing error: \n    " << res.description();
+	mIncludedFiles.clear();
+	mResourceFiles.clear();
 
-	pugi::xml_node root = doc.child("theme");
+	// Nothing changed since the last time : the resolved views are read back from the cache
+	std::string cacheName = sysDataMap.find("system.name") != sysDataMap.cend() ? sysDataMap["system.name"] : system;
+	std::string cacheSignature = ThemeCache::getSignature(this, path);
+
+	if (ThemeCache::load(this, cacheName, path, cacheSignature))
+	{
+		mMenuTheme = nullptr;
+		mDefaultTheme = this;
+		return;
+	}
+
+	std::string parseError;
+	std::shared_ptr<pugi::xml_document> doc = loadDocument(path, parseError);
+	if (doc == nullptr)
+		throw error << "XML parsing error: \n    " << parseError;
+
+	pugi::xml_node root = doc->child("theme");
 	if(!root)
 		throw error << "Missing <theme> tag!";
 
@@ -429,6 +627,8 @@ void ThemeData::loadFile(const std::string system, std::map<std::string, std::st
 
 	parseVariables(root);
 	parseTheme(root);
+
+	ThemeCache::save(this, cacheName, path, cacheSignature);
 	
 	mMenuTheme = nullptr;
 	mDefaultTheme = this;
@@ -595,6 +795,9 @@ void ThemeData::parseInclude(const pugi::xml_node& node)
 	std::string path = Utils::FileSystem::resolveRelativePath(relPath, Utils::FileSystem::getParent(mPaths.back()), true);
 	path = resolveSystemVariable(mSystemThemeFolder, path);
 
+	if (std::find(mIncludedFiles.cbegin(), mIncludedFiles.cend(), path) == mIncludedFiles.cend())
+		mIncludedFiles.push_back(path);
+
 	if (!ResourceManager::getInstance()->fileExists(path))
 	{
 		LOG(LogWarning) << "ThemeData::parseInclude() - Included file \"" << relPath << "\" not found! (resolved to \"" << path << "\")";
@@ -603,18 +806,20 @@ void ThemeData::parseInclude(const pugi::xml_node& node)
 
 	mPaths.push_back(path);
 
-	pugi::xml_document includeDoc;
-	pugi::xml_parse_result result = includeDoc.load_file(path.c_str());
-	if (!result)
+	std::string parseError;
+	std::shared_ptr<pugi::xml_document> includeDoc = loadDocument(path, parseError);
+	if (includeDoc == nullptr)
 	{
-		LOG(LogWarning) << "ThemeData::parseInclude() - Error parsing file: \n    " << result.description() << "    from included file \"" << relPath << "\":\n    ";
+		LOG(LogWarning) << "ThemeData::parseInclude() - Error parsing file: \n    " << parseError << "    from included file \"" << relPath << "\":\n    ";
+		mPaths.pop_back();
 		return;
 	}
 
-	pugi::xml_node theme = includeDoc.child("theme");
+	pugi::xml_node theme = includeDoc->child("theme");
 	if (!theme)
 	{
 		LOG(LogWarning) << "ThemeData::parseInclude() - Missing <theme> tag!" << "    from included file \"" << relPath << "\":\n    ";
+		mPaths.pop_back();
 		return;
 	}
 
@@ -799,8 +1004,12 @@ void ThemeData::parseSubsetElement(const pugi::xml_node& root)
 	const std::string displayName = resolvePlaceholders(root.attribute("displayName").as_string());
 	const std::string appliesTo = root.attribute("appliesTo").as_string();
 
-	for (pugi::xml_node node = root.child("include"); node; node = node.next_sibling("include"))
+	for (pugi::xml_node include = root.child("include"); include; include = include.next_sibling("include"))
 	{
+		// The document is shared with the other systems : the subset attributes are set on a copy of the node
+		pugi::xml_document includeCopy;
+		pugi::xml_node node = includeCopy.append_copy(include);
+
 		node.remove_attribute("subset");
 		node.append_attribute("subset") = name.c_str();
 
@@ -1077,8 +1286,10 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 		}
 		else
 			type = typeIt->second;
+
+		const PropertyId id = getPropertyId(node.name());
 		
-		if (!overwrite && element.properties.find(node.name()) != element.properties.cend())
+		if (!overwrite && element.has(id))
 			continue;
 
 		std::string str = resolveSystemVariable(mSystemThemeFolder, resolvePlaceholders(node.text().as_string()));
@@ -1101,7 +1312,7 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 					(float)atof(splits.at(2).c_str()), (float)atof(splits.at(3).c_str()));
 			}
 
-			element.properties[node.name()] = val;
+			element.set(id, val);
 			break;
 		}
 		case NORMALIZED_PAIR:
@@ -1116,17 +1327,17 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 				}
 
 				Vector2f val((float)atof(str.c_str()), (float)atof(str.c_str()));
-				element.properties[node.name()] = val;
+				element.set(id, val);
 				break;
 			}			
 
 			float first = atof(str.substr(0, divider).c_str());
 			float second = atof(str.substr(divider, std::string::npos).c_str());
-			element.properties[node.name()] = Vector2f(first, second);
+			element.set(id, Vector2f(first, second));
 			break;
 		}
 		case STRING:
-			element.properties[node.name()] = str;
+			element.set(id, str);
 			break;
 		case PATH:
 		{
@@ -1147,7 +1358,7 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 				else if (element.type == "image" && path != "{random}" && path != "{random:thumbnail}" && path != "{random:marquee}" && path != "{random:image}")
 					LOG(LogWarning) << "ThemeData::parseElement() - unknow random element " << path;
 				else
-					element.properties[node.name()] = path;
+					element.set(id, path);
 
 				break;
 			}
@@ -1159,9 +1370,14 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 					Utils::FileSystem::getUserDataPath() + "/themes");
 			}
 
+			// Adding or removing one of the probed files changes the result : the cache keys on them too
+			mResourceFiles.insert(path);
+
 			if(!ResourceManager::getInstance()->fileExists(path))
 			{
 				std::string rootPath = Utils::FileSystem::resolveRelativePath(str, Utils::FileSystem::getParent(mPaths.front()), true);
+				mResourceFiles.insert(rootPath);
+
 				if (rootPath != path && ResourceManager::getInstance()->fileExists(rootPath))
 					path = rootPath;
 			}
@@ -1175,17 +1391,17 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 				LOG(LogWarning) << ss.str();
 			}
 			else
-				element.properties[node.name()] = path;
+				element.set(id, path);
 
 			break;
 		}
 		case COLOR:
-			element.properties[node.name()] = getHexColor(str.c_str());
+			element.set(id, getHexColor(str.c_str()));
 			break;
 		case FLOAT:
 		{
 			//float floatVal = atof(str.c_str());  static_cast<float>(strtod(str.c_str(), 0));
-			element.properties[node.name()] = (float) atof(str.c_str()); //floatVal;
+			element.set(id, (float) atof(str.c_str())); //floatVal;
 			break;
 		}
 
@@ -1196,7 +1412,7 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 			// 1*, t* (true), T* (True), y* (yes), Y* (YES)
 			bool boolVal = (first == '1' || first == 't' || first == 'T' || first == 'y' || first == 'Y');
 
-			element.properties[node.name()] = boolVal;
+			element.set(id, boolVal);
 			break;
 		}
 		default:
@@ -1546,9 +1762,12 @@ ThemeData::ThemeMenu::ThemeMenu(ThemeData* theme)
 	{
 		for (auto prop : elem->properties)
 		{
-			std::string path = prop.second.s;
+			if (!prop.isString)
+				continue;
+
+			std::string path = elem->strings[prop.i];
 			if (!path.empty() && ResourceManager::getInstance()->fileExists(path))
-				mMenuIcons[prop.first] = path;
+				mMenuIcons[getPropertyName(prop.id)] = path;
 		}
 	}
 }
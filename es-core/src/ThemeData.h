@@ -9,6 +9,7 @@
 #include <map>
 #include <unordered_map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <vector>
 #include <pugixml/src/pugixml.hpp>
@@ -143,6 +144,8 @@ struct IconElement
 
 class ThemeData
 {
+	friend class ThemeCache;
+
 public:
 	class ThemeMenu
 	{
@@ -169,6 +172,16 @@ public:
 		std::map<std::string, std::string>		mMenuIcons;
 	};
 
+	// Property names are interned to small ids when the theme is parsed.
+	// Components can resolve the ids of the properties they use once, instead of passing names on each call.
+	typedef unsigned short PropertyId;
+
+	static PropertyId getPropertyId(const std::string& name);
+	static std::string getPropertyName(PropertyId id);
+
+	// Read only lookup of a property declared in sElementMap, without lock. Other names are never set by the parser
+	static bool findPropertyId(const std::string& name, PropertyId& id);
+
 	class ThemeElement
 	{
 	public:
@@ -180,36 +193,61 @@ public:
 
 		struct Property
 		{
-			void operator= (const Vector2f& value)     { v = value; }
-			void operator= (const std::string& value)  { s = value; }
-			void operator= (const unsigned int& value) { i = value; }
-			void operator= (const float& value)        { f = value; }
-			void operator= (const bool& value)         { b = value; }
-			void operator= (const Vector4f& value)     { r = value; v = Vector2f(value.x(), value.y()); }
-
-			Vector2f     v;
-			std::string  s;
-			unsigned int i;
-			float        f;
-			bool         b;
-			Vector4f     r;
+			PropertyId id;
+			bool       isString;
+
+			union
+			{
+				float        r[4]; // Vector2f & Vector4f
+				unsigned int i;    // Color, or index in strings for string & path properties
+				float        f;
+				bool         b;
+			};
 		};
 
-		std::map< std::string, Property > properties;
+		// Sorted by id
+		std::vector<Property>    properties;
+		std::vector<std::string> strings;
+
+		void set(PropertyId id, const Vector2f& value)    { Property* prop = getOrAdd(id, false); prop->r[0] = value.x(); prop->r[1] = value.y(); prop->r[2] = 0; prop->r[3] = 0; }
+		void set(PropertyId id, const Vector4f& value)    { Property* prop = getOrAdd(id, false); prop->r[0] = value.x(); prop->r[1] = value.y(); prop->r[2] = value.z(); prop->r[3] = value.w(); }
+		void set(PropertyId id, const unsigned int value) { getOrAdd(id, false)->i = value; }
+		void set(PropertyId id, const float value)        { getOrAdd(id, false)->f = value; }
+		void set(PropertyId id, const bool value)         { getOrAdd(id, false)->b = value; }
+		void set(PropertyId id, const std::string& value) { strings[getOrAdd(id, true)->i] = value; }
+
+		template<typename T>
+		const T get(PropertyId id) const
+		{
+			T value;
+			read(find(id), value);
+			return value;
+		}
 
+		// Prefer the PropertyId overloads in code running often
 		template<typename T>
 		const T get(const std::string& prop) const
 		{
-			if(     std::is_same<T, Vector2f>::value)     return *(const T*)&properties.at(prop).v;
-			else if(std::is_same<T, std::string>::value)  return *(const T*)&properties.at(prop).s;
-			else if(std::is_same<T, unsigned int>::value) return *(const T*)&properties.at(prop).i;
-			else if(std::is_same<T, float>::value)        return *(const T*)&properties.at(prop).f;
-			else if(std::is_same<T, bool>::value)         return *(const T*)&properties.at(prop).b;
-			else if (std::is_same<T, Vector4f>::value)         return *(const T*)&properties.at(prop).r;
-			return T();
+			PropertyId id;
+			T value;
+			read(findPropertyId(prop, id) ? find(id) : nullptr, value);
+			return value;
 		}
 
-		inline bool has(const std::string& prop) const { return (properties.find(prop) != properties.cend()); }
+		inline bool has(PropertyId id) const { return find(id) != nullptr; }
+		inline bool has(const std::string& prop) const { PropertyId id; return findPropertyId(prop, id) && has(id); }
+
+		const Property* find(PropertyId id) const;
+
+	private:
+		Property* getOrAdd(PropertyId id, bool isString);
+
+		void read(const Property* prop, Vector2f& value) const     { value = prop ? Vector2f(prop->r[0], prop->r[1]) : Vector2f::Zero(); }
+		void read(const Property* prop, Vector4f& value) const     { value = prop ? Vector4f(prop->r[0], prop->r[1], prop->r[2], prop->r[3]) : Vector4f::Zero(); }
+		void read(const Property* prop, unsigned int& value) const { value = prop ? prop->i : 0; }
+		void read(const Property* prop, float& value) const        { value = prop ? prop->f : 0.0f; }
+		void read(const Property* prop, bool& value) const         { value = prop ? prop->b : false; }
+		void read(const Property* prop, std::string& value) const  { value = prop && prop->isString ? strings[prop->i] : std::string(); }
 	};
 
 private:
@@ -274,6 +312,9 @@ public:
 
 	static std::vector<Subset> getSubSet(const std::vector<Subset>& subsets, const std::string& subset);
 
+	// Releases the theme files kept parsed between the loading of the systems
+	static void clearDocumentCache();
+
 	static void setDefaultTheme(ThemeData* theme);
 	static ThemeData* getDefaultTheme() { return mDefaultTheme; }
 	
@@ -321,6 +362,8 @@ private:
 
 	void parseCustomViewBaseClass(const pugi::xml_node& root, ThemeView& view, std::string baseClass);
 
+	static std::shared_ptr<pugi::xml_document> loadDocument(const std::string& path, std::string& error);
+
 	std::string resolveSystemVariable(const std::string& systemThemeFolder, const std::string& path);
 	std::string resolvePlaceholders(const char* in);
 
@@ -334,6 +377,12 @@ private:
 	std::string mRegion;
 
 	std::map<std::string, std::string> mVariables;
+
+	// Theme files read by parseInclude, whether they exist or not
+	std::vector<std::string> mIncludedFiles;
+
+	// Files probed for PATH properties, whether they exist or not
+	std::set<std::string> mResourceFiles;
 	
 	class UnsortedViewMap : public std::vector<std::pair<std::string, ThemeView>>
 	{
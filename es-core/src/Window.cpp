@@ -4,9 +4,11 @@
 #include "components/ImageComponent.h"
 #include "components/TextComponent.h"
 #include "resources/Font.h"
+#include "resources/TextureData.h"
 #include "resources/TextureResource.h"
 #include "Log.h"
 #include "Scripting.h"
+#include "utils/ProfilingUtil.h"
 #include <algorithm>
 #include <iomanip>
 #include <SDL_events.h>
@@ -22,6 +24,17 @@
 #include "components/VolumeInfoComponent.h"
 #include "components/BrightnessInfoComponent.h"
 
+// Read on every frame
+static BoolSetting sDrawFramerate("DrawFramerate");
+static BoolSetting sDrawClock("DrawClock");
+static BoolSetting sClockMode12("ClockMode12");
+static BoolSetting sShowBatteryIndicator("ShowBatteryIndicator");
+static BoolSetting sShowNetworkIndicator("ShowNetworkIndicator");
+static BoolSetting sVolumePopup("VolumePopup");
+static BoolSetting sBrightnessPopup("BrightnessPopup");
+static IntSetting sScreenSaverTime("ScreenSaverTime");
+static IntSetting sMaxVRAM("MaxVRAM");
+
 
 Window::Window() : mNormalizeNextUpdate(false), mFrameTimeElapsed(0), mFrameCountElapsed(0), mAverageDeltaTime(10),
   mAllowSleep(true), mSleeping(false), mTimeSinceLastInput(0), mScreenSaver(NULL), mRenderScreenSaver(false), mInfoPopup(NULL), mClockElapsed(0) // batocera
@@ -254,6 +267,13 @@ void Window::input(InputConfig* config, Input input)
 		// toggle TextComponent debug view with Ctrl-I
 		Settings::getInstance()->setBool("DebugImage", !Settings::getInstance()->getBool("DebugImage"));
 	}
+#if defined(USE_PROFILING)
+	else if(config->getDeviceId() == DEVICE_KEYBOARD && input.value && input.id == SDLK_p && SDL_GetModState() & KMOD_LCTRL)
+	{
+		// write a Chrome trace of the last frames with Ctrl-P
+		ProfileExport();
+	}
+#endif // USE_PROFILING
 	else
 	{
 		//if (Settings::getInstance()->getBool("ShowControllerActivity") && (mControllerActivity != nullptr))
@@ -268,8 +288,11 @@ void Window::input(InputConfig* config, Input input)
 
 void Window::update(int deltaTime)
 {	
+	ProfileScope("Window::update");
+
 	processPostedFunctions();
 	processNotificationMessages();
+	TextureResource::processLoadedTextures();
 
 	if(mNormalizeNextUpdate)
 	{
@@ -278,10 +301,10 @@ void Window::update(int deltaTime)
 			deltaTime = mAverageDeltaTime;
 	}
 
-	if (Settings::getInstance()->getBool("VolumePopup") && (mVolumeInfo != nullptr))
+	if (sVolumePopup && (mVolumeInfo != nullptr))
 		mVolumeInfo->update(deltaTime);
 
-	if (Settings::getInstance()->getBool("BrightnessPopup") && (mBrightnessInfo != nullptr))
+	if (sBrightnessPopup && (mBrightnessInfo != nullptr))
 		mBrightnessInfo->update(deltaTime);
 
 	mFrameTimeElapsed += deltaTime;
@@ -290,7 +313,7 @@ void Window::update(int deltaTime)
 	{
 		mAverageDeltaTime = mFrameTimeElapsed / mFrameCountElapsed;
 
-		if(Settings::getInstance()->getBool("DrawFramerate"))
+		if(sDrawFramerate)
 		{
 			std::stringstream ss;
 
@@ -305,6 +328,21 @@ void Window::update(int deltaTime)
 
 			ss << "\nFont VRAM: " << fontVramUsageMb << " Tex VRAM: " << textureVramUsageMb <<
 				  " Tex Max: " << textureTotalUsageMb;
+
+			// texture budget & evictions since the last refresh
+			unsigned int evictedCount;
+			size_t evictedSize;
+			TextureResource::getEvictionStats(evictedCount, evictedSize, true);
+
+			ss << "\nTex RAM: " << TextureData::getTotalRAMUsage() / 1000.0f / 1000.0f << " Tex GPU: " << TextureData::getTotalVRAMUsage() / 1000.0f / 1000.0f <<
+				  " Budget: " << sMaxVRAM.get() << " Evicted: " << evictedCount << " (" << evictedSize / 1000.0f / 1000.0f << ")";
+
+			// texture loader queue latency (avg/max ms) since the last refresh
+			TextureLoader::Stats stats = TextureResource::getLoaderStats(true);
+			ss << "\nTex Queue: " << TextureResource::getLoaderQueueCount() << " Loaded: " << stats.loaded << " Dropped: " << stats.cancelled + stats.dropped <<
+				  " Vis: " << stats.averageLatency(TextureLoader::PRIORITY_VISIBLE) << "/" << stats.maxLatency[TextureLoader::PRIORITY_VISIBLE] <<
+				  " Next: " << stats.averageLatency(TextureLoader::PRIORITY_NEXT_PAGE) << "/" << stats.maxLatency[TextureLoader::PRIORITY_NEXT_PAGE] <<
+				  " Pref: " << stats.averageLatency(TextureLoader::PRIORITY_PREFETCH) << "/" << stats.maxLatency[TextureLoader::PRIORITY_PREFETCH];
 			mFrameDataText = std::unique_ptr<TextCache>(mDefaultFonts.at(1)->buildTextCache(ss.str(), 50.f, 50.f, 0xFF00FFFF));
 		}
 
@@ -313,7 +351,7 @@ void Window::update(int deltaTime)
 	}
 
 	/* draw the clock */ // batocera
-	if (Settings::getInstance()->getBool("DrawClock") && mClock) 
+	if (sDrawClock && mClock) 
 	{
 		mClockElapsed -= deltaTime;
 		if (mClockElapsed <= 0)
@@ -327,7 +365,7 @@ void Window::update(int deltaTime)
 				// Visit http://en.cppreference.com/w/cpp/chrono/c/strftime for more information about date/time format
 				
 				std::string clockBuf;
-				if (Settings::getInstance()->getBool("ClockMode12"))
+				if (sClockMode12)
 					clockBuf = Utils::Time::timeToString(clockNow, "%I:%M %p");
 				else
 					clockBuf = Utils::Time::timeToString(clockNow, "%H:%M");
@@ -353,7 +391,7 @@ void Window::update(int deltaTime)
 	//if (mControllerActivity)
 		//mControllerActivity->update(deltaTime);
 
-	if ((mBatteryIndicator != nullptr) && (Settings::getInstance()->getBool("ShowBatteryIndicator") || Settings::getInstance()->getBool("ShowNetworkIndicator")))
+	if ((mBatteryIndicator != nullptr) && (sShowBatteryIndicator || sShowNetworkIndicator))
 		mBatteryIndicator->update(deltaTime);
 
 	AudioManager::update(deltaTime);
@@ -361,6 +399,8 @@ void Window::update(int deltaTime)
 
 void Window::render()
 {
+	ProfileScope("Window::render");
+
 	Transform4x4f transform = Transform4x4f::Identity();
 
 	mRenderedHelpPrompts = false;
@@ -392,7 +432,7 @@ void Window::render()
 		if(!mRenderedHelpPrompts)
 			mHelp->render(transform);
 
-	if(Settings::getInstance()->getBool("DrawFramerate") && mFrameDataText)
+	if(sDrawFramerate && mFrameDataText)
 	{
 		Renderer::setMatrix(Transform4x4f::Identity());
 		mDefaultFonts.at(1)->renderTextCache(mFrameDataText.get());
@@ -400,20 +440,20 @@ void Window::render()
 
 
 	// clock // batocera
-	if (Settings::getInstance()->getBool("DrawClock") && (mClock != nullptr) && (mGuiStack.size() < 2 || !Renderer::isSmallScreen()))
+	if (sDrawClock && (mClock != nullptr) && (mGuiStack.size() < 2 || !Renderer::isSmallScreen()))
 		mClock->render(transform);
 
 	//if (Settings::getInstance()->getBool("ShowControllerActivity") && (mControllerActivity != nullptr) && (mGuiStack.size() < 2 || !Renderer::isSmallScreen()))ShowNetworkIndicator
 	//if ((mControllerActivity != nullptr) && (mGuiStack.size() < 2 || !Renderer::isSmallScreen()))
 		//mControllerActivity->render(transform);
 
-	if ((mBatteryIndicator != nullptr) && (Settings::getInstance()->getBool("ShowBatteryIndicator") || Settings::getInstance()->getBool("ShowNetworkIndicator")) && (mGuiStack.size() < 2 || !Renderer::isSmallScreen()))
+	if ((mBatteryIndicator != nullptr) && (sShowBatteryIndicator || sShowNetworkIndicator) && (mGuiStack.size() < 2 || !Renderer::isSmallScreen()))
 		mBatteryIndicator->render(transform);
 
 	// pads // batocera
 	Renderer::setMatrix(Transform4x4f::Identity());
 
-	unsigned int screensaverTime = (unsigned int)Settings::getInstance()->getInt("ScreenSaverTime");
+	unsigned int screensaverTime = (unsigned int)sScreenSaverTime.get();
 	if(isScreenSaverEnabled() && (mTimeSinceLastInput >= screensaverTime) )
 		startScreenSaver();
 
@@ -430,10 +470,10 @@ void Window::render()
 	for (auto extra : mScreenExtras)
 		extra->render(transform);
 
-	if (Settings::getInstance()->getBool("VolumePopup") && mVolumeInfo)
+	if (sVolumePopup && mVolumeInfo)
 		mVolumeInfo->render(transform);
 
-	if (Settings::getInstance()->getBool("BrightnessPopup") && mBrightnessInfo)
+	if (sBrightnessPopup && mBrightnessInfo)
 		mBrightnessInfo->render(transform);
 
 	if(isScreenSaverEnabled() && (mTimeSinceLastInput >= screensaverTime))
@@ -894,10 +934,10 @@ void Window::onThemeChanged(const std::shared_ptr<ThemeData>& theme)
 	if (mBatteryIndicator != nullptr)
 		mBatteryIndicator->applyTheme(theme, "screen", "batteryIndicator", ThemeFlags::ALL);
 
-	if (Settings::getInstance()->getBool("VolumePopup") && (mVolumeInfo != nullptr))
+	if (sVolumePopup && (mVolumeInfo != nullptr))
 		mVolumeInfo = std::make_shared<VolumeInfoComponent>(this);
 
-	if (Settings::getInstance()->getBool("BrightnessPopup") && (mBrightnessInfo != nullptr))
+	if (sBrightnessPopup && (mBrightnessInfo != nullptr))
 		mBrightnessInfo = std::make_shared<BrightnessInfoComponent>(this);
 
 }
@@ -5,6 +5,7 @@
 #include "ThemeData.h"
 #include "InputManager.h"
 #include "Settings.h"
+#include "SystemMetrics.h"
 #include "platform.h"
 #include "Log.h"
 
@@ -316,6 +317,20 @@ void ControllerActivityComponent::render(const Transform4x4f& parentTrans)
 
 void ControllerActivityComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {	
+	static const ThemeData::PropertyId idImagePath = ThemeData::getPropertyId("imagePath");
+	static const ThemeData::PropertyId idNetworkIcon = ThemeData::getPropertyId("networkIcon");
+	static const ThemeData::PropertyId idIncharge = ThemeData::getPropertyId("incharge");
+	static const ThemeData::PropertyId idFull = ThemeData::getPropertyId("full");
+	static const ThemeData::PropertyId idAt75 = ThemeData::getPropertyId("at75");
+	static const ThemeData::PropertyId idAt50 = ThemeData::getPropertyId("at50");
+	static const ThemeData::PropertyId idAt25 = ThemeData::getPropertyId("at25");
+	static const ThemeData::PropertyId idEmpty = ThemeData::getPropertyId("empty");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idActivityColor = ThemeData::getPropertyId("activityColor");
+	static const ThemeData::PropertyId idHotkeyColor = ThemeData::getPropertyId("hotkeyColor");
+	static const ThemeData::PropertyId idItemSpacing = ThemeData::getPropertyId("itemSpacing");
+	static const ThemeData::PropertyId idHorizontalAlignment = ThemeData::getPropertyId("horizontalAlignment");
+
 	init();
 
 	GuiComponent::applyTheme(theme, view, element, properties);
@@ -329,64 +344,64 @@ void ControllerActivityComponent::applyTheme(const std::shared_ptr<ThemeData>& t
 	if (properties & PATH)
 	{		
 		// Controllers
-		if (elem->has("imagePath") && ResourceManager::getInstance()->fileExists(elem->get<std::string>("imagePath")))
-			mPadTexture = TextureResource::get(elem->get<std::string>("imagePath"), false, true);
+		if (elem->has(idImagePath) && ResourceManager::getInstance()->fileExists(elem->get<std::string>(idImagePath)))
+			mPadTexture = TextureResource::get(elem->get<std::string>(idImagePath), false, true);
 
 		// Wifi
-		if (elem->has("networkIcon"))
+		if (elem->has(idNetworkIcon))
 		{
-			if (ResourceManager::getInstance()->fileExists(elem->get<std::string>("networkIcon")))
+			if (ResourceManager::getInstance()->fileExists(elem->get<std::string>(idNetworkIcon)))
 			{
 				mView |= ActivityView::NETWORK;
-				mNetworkImage = TextureResource::get(elem->get<std::string>("networkIcon"), false, true);
+				mNetworkImage = TextureResource::get(elem->get<std::string>(idNetworkIcon), false, true);
 			}
 			else
 				mNetworkImage = nullptr;
 		}
 
 		// Battery
-		if (elem->has("incharge") && ResourceManager::getInstance()->fileExists(elem->get<std::string>("incharge")))
+		if (elem->has(idIncharge) && ResourceManager::getInstance()->fileExists(elem->get<std::string>(idIncharge)))
 		{
 			mView |= ActivityView::BATTERY;
-			mIncharge = elem->get<std::string>("incharge");
+			mIncharge = elem->get<std::string>(idIncharge);
 		}
 
-		if (elem->has("full") && ResourceManager::getInstance()->fileExists(elem->get<std::string>("full")))
-			mFull = elem->get<std::string>("full");
+		if (elem->has(idFull) && ResourceManager::getInstance()->fileExists(elem->get<std::string>(idFull)))
+			mFull = elem->get<std::string>(idFull);
 
-		if (elem->has("at75") && ResourceManager::getInstance()->fileExists(elem->get<std::string>("at75")))
-			mAt75 = elem->get<std::string>("at75");
+		if (elem->has(idAt75) && ResourceManager::getInstance()->fileExists(elem->get<std::string>(idAt75)))
+			mAt75 = elem->get<std::string>(idAt75);
 
-		if (elem->has("at50") && ResourceManager::getInstance()->fileExists(elem->get<std::string>("at50")))
-			mAt50 = elem->get<std::string>("at50");
+		if (elem->has(idAt50) && ResourceManager::getInstance()->fileExists(elem->get<std::string>(idAt50)))
+			mAt50 = elem->get<std::string>(idAt50);
 
-		if (elem->has("at25") && ResourceManager::getInstance()->fileExists(elem->get<std::string>("at25")))
-			mAt25 = elem->get<std::string>("at25");
+		if (elem->has(idAt25) && ResourceManager::getInstance()->fileExists(elem->get<std::string>(idAt25)))
+			mAt25 = elem->get<std::string>(idAt25);
 
-		if (elem->has("empty") && ResourceManager::getInstance()->fileExists(elem->get<std::string>("empty")))
-			mEmpty = elem->get<std::string>("empty");
+		if (elem->has(idEmpty) && ResourceManager::getInstance()->fileExists(elem->get<std::string>(idEmpty)))
+			mEmpty = elem->get<std::string>(idEmpty);
 	}
 
 	if (properties & COLOR)
 	{
-		if (elem->has("color"))
-			setColorShift(elem->get<unsigned int>("color"));
+		if (elem->has(idColor))
+			setColorShift(elem->get<unsigned int>(idColor));
 
-		if (elem->has("activityColor"))
-			setActivityColor(elem->get<unsigned int>("activityColor"));
+		if (elem->has(idActivityColor))
+			setActivityColor(elem->get<unsigned int>(idActivityColor));
 
-		if (elem->has("hotkeyColor"))
-			setHotkeyColor(elem->get<unsigned int>("hotkeyColor"));
+		if (elem->has(idHotkeyColor))
+			setHotkeyColor(elem->get<unsigned int>(idHotkeyColor));
 
-		if (elem->has("itemSpacing"))
-			setSpacing(elem->get<float>("itemSpacing") * Renderer::getScreenWidth());
+		if (elem->has(idItemSpacing))
+			setSpacing(elem->get<float>(idItemSpacing) * Renderer::getScreenWidth());
 	}
 
 	if (properties & ALIGNMENT)
 	{
-		if (elem->has("horizontalAlignment"))
+		if (elem->has(idHorizontalAlignment))
 		{
-			std::string str = elem->get<std::string>("horizontalAlignment");
+			std::string str = elem->get<std::string>(idHorizontalAlignment);
 			if (str == "left")
 				setHorizontalAlignment(ALIGN_LEFT);
 			else if (str == "right")
@@ -405,7 +420,14 @@ void ControllerActivityComponent::applyTheme(const std::shared_ptr<ThemeData>& t
 
 void ControllerActivityComponent::updateNetworkInfo()
 {
-	mNetworkConnected = Settings::getInstance()->getBool("ShowNetworkIndicator") && queryNetworkConnectedFast();
+	if (!Settings::getInstance()->getBool("ShowNetworkIndicator"))
+	{
+		mNetworkConnected = false;
+		return;
+	}
+
+	auto metrics = SystemMetrics::get();
+	mNetworkConnected = metrics != nullptr ? metrics->wifiConnected : queryNetworkConnectedFast();
 }
 
 void ControllerActivityComponent::updateBatteryInfo()
@@ -416,7 +438,8 @@ void ControllerActivityComponent::updateBatteryInfo()
 		return;
 	}
 
-	BatteryInformation info = queryBatteryInformation(false);
+	auto metrics = SystemMetrics::get();
+	BatteryInformation info = metrics != nullptr ? metrics->battery : queryBatteryInformation(false);
 
 	if (info.hasBattery == mBatteryInfo.hasBattery && info.isCharging == mBatteryInfo.isCharging && info.level == mBatteryInfo.level)
 		return;
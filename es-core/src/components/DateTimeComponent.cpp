@@ -84,6 +84,14 @@ void DateTimeComponent::render(const Transform4x4f& parentTrans)
 
 void DateTimeComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {
+	static const ThemeData::PropertyId idDisplayRelative = ThemeData::getPropertyId("displayRelative");
+	static const ThemeData::PropertyId idFormat = ThemeData::getPropertyId("format");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idBackgroundColor = ThemeData::getPropertyId("backgroundColor");
+	static const ThemeData::PropertyId idAlignment = ThemeData::getPropertyId("alignment");
+	static const ThemeData::PropertyId idForceUppercase = ThemeData::getPropertyId("forceUppercase");
+	static const ThemeData::PropertyId idLineSpacing = ThemeData::getPropertyId("lineSpacing");
+
 	GuiComponent::applyTheme(theme, view, element, properties);
 
 	using namespace ThemeFlags;
@@ -92,24 +100,24 @@ void DateTimeComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, cons
 	if(!elem)
 		return;
 
-	if(elem->has("displayRelative"))
-		setDisplayRelative(elem->get<bool>("displayRelative"));
+	if(elem->has(idDisplayRelative))
+		setDisplayRelative(elem->get<bool>(idDisplayRelative));
 
-	if(elem->has("format"))
-		setFormat(elem->get<std::string>("format"));
+	if(elem->has(idFormat))
+		setFormat(elem->get<std::string>(idFormat));
 
-	if (properties & COLOR && elem->has("color"))
-		setColor(elem->get<unsigned int>("color"));
+	if (properties & COLOR && elem->has(idColor))
+		setColor(elem->get<unsigned int>(idColor));
 
 	setRenderBackground(false);
-	if (properties & COLOR && elem->has("backgroundColor")) {
-		setBackgroundColor(elem->get<unsigned int>("backgroundColor"));
+	if (properties & COLOR && elem->has(idBackgroundColor)) {
+		setBackgroundColor(elem->get<unsigned int>(idBackgroundColor));
 		setRenderBackground(true);
 	}
 
-	if(properties & ALIGNMENT && elem->has("alignment"))
+	if(properties & ALIGNMENT && elem->has(idAlignment))
 	{
-		std::string str = elem->get<std::string>("alignment");
+		std::string str = elem->get<std::string>(idAlignment);
 		if(str == "left")
 			setHorizontalAlignment(ALIGN_LEFT);
 		else if(str == "center")
@@ -120,11 +128,11 @@ void DateTimeComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, cons
 		LOG(LogError) << "DateTimeComponent::applyTheme() - ERROR: Unknown text alignment string: " << str;
 	}
 
-	if(properties & FORCE_UPPERCASE && elem->has("forceUppercase"))
-		setUppercase(elem->get<bool>("forceUppercase"));
+	if(properties & FORCE_UPPERCASE && elem->has(idForceUppercase))
+		setUppercase(elem->get<bool>(idForceUppercase));
 
-	if(properties & LINE_SPACING && elem->has("lineSpacing"))
-		setLineSpacing(elem->get<float>("lineSpacing"));
+	if(properties & LINE_SPACING && elem->has(idLineSpacing))
+		setLineSpacing(elem->get<float>(idLineSpacing));
 
 	setFont(Font::getFromTheme(elem, properties, mFont));
 }
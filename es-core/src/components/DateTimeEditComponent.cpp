@@ -321,6 +321,10 @@ void DateTimeEditComponent::setUppercase(bool uppercase)
 
 void DateTimeEditComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {
+	static const ThemeData::PropertyId idSize = ThemeData::getPropertyId("size");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idForceUppercase = ThemeData::getPropertyId("forceUppercase");
+
 	const ThemeData::ThemeElement* elem = theme->getElement(view, element, "datetime");
 	if(!elem)
 		return;
@@ -329,17 +333,17 @@ void DateTimeEditComponent::applyTheme(const std::shared_ptr<ThemeData>& theme,
 	// setSize(), which will call updateTextCache(), which will reset mSize if
 	// mAutoSize == true, ignoring the theme's value.
 	if(properties & ThemeFlags::SIZE)
-		mAutoSize = !elem->has("size");
+		mAutoSize = !elem->has(idSize);
 
 	GuiComponent::applyTheme(theme, view, element, properties);
 
 	using namespace ThemeFlags;
 
-	if(properties & COLOR && elem->has("color"))
-		setColor(elem->get<unsigned int>("color"));
+	if(properties & COLOR && elem->has(idColor))
+		setColor(elem->get<unsigned int>(idColor));
 
-	if(properties & FORCE_UPPERCASE && elem->has("forceUppercase"))
-		setUppercase(elem->get<bool>("forceUppercase"));
+	if(properties & FORCE_UPPERCASE && elem->has(idForceUppercase))
+		setUppercase(elem->get<bool>(idForceUppercase));
 
 	setFont(Font::getFromTheme(elem, properties, mFont));
 }
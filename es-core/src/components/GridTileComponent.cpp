@@ -32,6 +32,7 @@ GridTileComponent::GridTileComponent(Window* window) : GuiComponent(window), mBa
 
 	mImage = new ImageComponent(mWindow);
 	mImage->setOrigin(0.5f, 0.5f);
+	mImage->setAllowAtlas(true);
 
 	mLabel.setDefaultZIndex(10);
 
@@ -382,6 +383,7 @@ void GridTileComponent::createMarquee()
 	mMarquee = new ImageComponent(mWindow);
 	mMarquee->setOrigin(0.5f, 0.5f);
 	mMarquee->setDefaultZIndex(20);
+	mMarquee->setAllowAtlas(true);
 	addChild(mMarquee);
 }
 
@@ -427,100 +429,134 @@ void GridTileComponent::createVideo()
 
 void GridTileComponent::applyThemeToProperties(const ThemeData::ThemeElement* elem, GridTileProperties& properties)
 {
+	static const ThemeData::PropertyId idSize = ThemeData::getPropertyId("size");
+	static const ThemeData::PropertyId idPadding = ThemeData::getPropertyId("padding");
+	static const ThemeData::PropertyId idSelectionMode = ThemeData::getPropertyId("selectionMode");
+	static const ThemeData::PropertyId idBackgroundImage = ThemeData::getPropertyId("backgroundImage");
+	static const ThemeData::PropertyId idBackgroundCornerSize = ThemeData::getPropertyId("backgroundCornerSize");
+	static const ThemeData::PropertyId idBackgroundColor = ThemeData::getPropertyId("backgroundColor");
+	static const ThemeData::PropertyId idBackgroundCenterColor = ThemeData::getPropertyId("backgroundCenterColor");
+	static const ThemeData::PropertyId idBackgroundEdgeColor = ThemeData::getPropertyId("backgroundEdgeColor");
+	static const ThemeData::PropertyId idReflexion = ThemeData::getPropertyId("reflexion");
+	static const ThemeData::PropertyId idImageColor = ThemeData::getPropertyId("imageColor");
+	static const ThemeData::PropertyId idImageSizeMode = ThemeData::getPropertyId("imageSizeMode");
+
 	if (elem == nullptr)
 		return;
 
 	Vector2f screen = Vector2f((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight());
 
-	if (elem->has("size"))
-		properties.Size = elem->get<Vector2f>("size") * screen;
+	if (elem->has(idSize))
+		properties.Size = elem->get<Vector2f>(idSize) * screen;
 
-	if (elem->has("padding"))
-		properties.Padding = elem->get<Vector4f>("padding");
+	if (elem->has(idPadding))
+		properties.Padding = elem->get<Vector4f>(idPadding);
 
-	if (elem && elem->has("selectionMode"))
-		properties.SelectionMode = elem->get<std::string>("selectionMode");		
+	if (elem && elem->has(idSelectionMode))
+		properties.SelectionMode = elem->get<std::string>(idSelectionMode);		
 
 	// Retrocompatibility for Background properties
-	if (elem->has("backgroundImage"))
-		properties.Background.path = elem->get<std::string>("backgroundImage");
+	if (elem->has(idBackgroundImage))
+		properties.Background.path = elem->get<std::string>(idBackgroundImage);
 
-	if (elem->has("backgroundCornerSize"))
-		properties.Background.cornerSize = elem->get<Vector2f>("backgroundCornerSize");
+	if (elem->has(idBackgroundCornerSize))
+		properties.Background.cornerSize = elem->get<Vector2f>(idBackgroundCornerSize);
 
-	if (elem->has("backgroundColor"))
+	if (elem->has(idBackgroundColor))
 	{
-		properties.Background.centerColor = elem->get<unsigned int>("backgroundColor");
-		properties.Background.edgeColor = elem->get<unsigned int>("backgroundColor");
+		properties.Background.centerColor = elem->get<unsigned int>(idBackgroundColor);
+		properties.Background.edgeColor = elem->get<unsigned int>(idBackgroundColor);
 	}
 
-	if (elem->has("backgroundCenterColor"))
-		properties.Background.centerColor = elem->get<unsigned int>("backgroundCenterColor");
+	if (elem->has(idBackgroundCenterColor))
+		properties.Background.centerColor = elem->get<unsigned int>(idBackgroundCenterColor);
 
-	if (elem->has("backgroundEdgeColor"))
-		properties.Background.edgeColor = elem->get<unsigned int>("backgroundEdgeColor");
+	if (elem->has(idBackgroundEdgeColor))
+		properties.Background.edgeColor = elem->get<unsigned int>(idBackgroundEdgeColor);
 
 	// Retrocompatibility for Image properties
-	if (elem && elem->has("reflexion"))
-		properties.Image.reflexion = elem->get<Vector2f>("reflexion");
+	if (elem && elem->has(idReflexion))
+		properties.Image.reflexion = elem->get<Vector2f>(idReflexion);
 
-	if (elem->has("imageColor"))
-		properties.Image.color = properties.Image.colorEnd = elem->get<unsigned int>("imageColor");
+	if (elem->has(idImageColor))
+		properties.Image.color = properties.Image.colorEnd = elem->get<unsigned int>(idImageColor);
 
-	if (elem && elem->has("imageSizeMode"))
-		properties.Image.sizeMode = elem->get<std::string>("imageSizeMode");
+	if (elem && elem->has(idImageSizeMode))
+		properties.Image.sizeMode = elem->get<std::string>(idImageSizeMode);
 }
 
 bool GridImageProperties::applyTheme(const ThemeData::ThemeElement* elem)
 {
+	static const ThemeData::PropertyId idVisible = ThemeData::getPropertyId("visible");
+	static const ThemeData::PropertyId idOrigin = ThemeData::getPropertyId("origin");
+	static const ThemeData::PropertyId idPos = ThemeData::getPropertyId("pos");
+	static const ThemeData::PropertyId idSize = ThemeData::getPropertyId("size");
+	static const ThemeData::PropertyId idMinSize = ThemeData::getPropertyId("minSize");
+	static const ThemeData::PropertyId idMaxSize = ThemeData::getPropertyId("maxSize");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idColorEnd = ThemeData::getPropertyId("colorEnd");
+	static const ThemeData::PropertyId idReflexion = ThemeData::getPropertyId("reflexion");
+	static const ThemeData::PropertyId idRoundCorners = ThemeData::getPropertyId("roundCorners");
+
 	if (!elem)
 		return false;
 
 	Loaded = true;
 	Visible = true;
 
-	if (elem && elem->has("visible"))
-		Visible = elem->get<bool>("visible");
+	if (elem && elem->has(idVisible))
+		Visible = elem->get<bool>(idVisible);
 
-	if (elem && elem->has("origin"))
-		origin = elem->get<Vector2f>("origin");
+	if (elem && elem->has(idOrigin))
+		origin = elem->get<Vector2f>(idOrigin);
 
-	if (elem && elem->has("pos"))
-		pos = elem->get<Vector2f>("pos");
+	if (elem && elem->has(idPos))
+		pos = elem->get<Vector2f>(idPos);
 
-	if (elem && elem->has("size"))
+	if (elem && elem->has(idSize))
 	{
 		sizeMode = "size";
-		size = elem->get<Vector2f>("size");
+		size = elem->get<Vector2f>(idSize);
 	}
-	else if (elem && elem->has("minSize"))
+	else if (elem && elem->has(idMinSize))
 	{
 		sizeMode = "minSize";
-		size = elem->get<Vector2f>("minSize");
+		size = elem->get<Vector2f>(idMinSize);
 	}
-	else if (elem && elem->has("maxSize"))
+	else if (elem && elem->has(idMaxSize))
 	{
 		sizeMode = "maxSize";
-		size = elem->get<Vector2f>("maxSize");
+		size = elem->get<Vector2f>(idMaxSize);
 	}
 
-	if (elem && elem->has("color"))
-		color = colorEnd = elem->get<unsigned int>("color");
+	if (elem && elem->has(idColor))
+		color = colorEnd = elem->get<unsigned int>(idColor);
 
-	if (elem && elem->has("colorEnd"))
-		colorEnd = elem->get<unsigned int>("colorEnd");
+	if (elem && elem->has(idColorEnd))
+		colorEnd = elem->get<unsigned int>(idColorEnd);
 
-	if (elem && elem->has("reflexion"))
-		reflexion = elem->get<Vector2f>("reflexion");
+	if (elem && elem->has(idReflexion))
+		reflexion = elem->get<Vector2f>(idReflexion);
 
-	if (elem && elem->has("roundCorners"))
-		roundCorners = elem->get<float>("roundCorners");
+	if (elem && elem->has(idRoundCorners))
+		roundCorners = elem->get<float>(idRoundCorners);
 
 	return true;
 }
 
 bool GridTextProperties::applyTheme(const ThemeData::ThemeElement* elem)
 {
+	static const ThemeData::PropertyId idVisible = ThemeData::getPropertyId("visible");
+	static const ThemeData::PropertyId idPos = ThemeData::getPropertyId("pos");
+	static const ThemeData::PropertyId idSize = ThemeData::getPropertyId("size");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idBackgroundColor = ThemeData::getPropertyId("backgroundColor");
+	static const ThemeData::PropertyId idGlowColor = ThemeData::getPropertyId("glowColor");
+	static const ThemeData::PropertyId idGlowSize = ThemeData::getPropertyId("glowSize");
+	static const ThemeData::PropertyId idFontSize = ThemeData::getPropertyId("fontSize");
+	static const ThemeData::PropertyId idFontPath = ThemeData::getPropertyId("fontPath");
+	static const ThemeData::PropertyId idSingleLineScroll = ThemeData::getPropertyId("singleLineScroll");
+
 	if (!elem)
 	{
 		Visible = false;
@@ -530,45 +566,56 @@ bool GridTextProperties::applyTheme(const ThemeData::ThemeElement* elem)
 	Loaded = true;
 	Visible = true;
 
-	if (elem && elem->has("visible"))
-		Visible = elem->get<bool>("visible");
+	if (elem && elem->has(idVisible))
+		Visible = elem->get<bool>(idVisible);
 
-	if (elem && elem->has("pos"))
-		pos = elem->get<Vector2f>("pos");
+	if (elem && elem->has(idPos))
+		pos = elem->get<Vector2f>(idPos);
 
-	if (elem && elem->has("size"))
+	if (elem && elem->has(idSize))
 	{
-		size = elem->get<Vector2f>("size");
+		size = elem->get<Vector2f>(idSize);
 		if (size.y() == 0)
 			Visible = false;
 	}
 
-	if (elem && elem->has("color"))
-		color = elem->get<unsigned int>("color");
+	if (elem && elem->has(idColor))
+		color = elem->get<unsigned int>(idColor);
 
-	if (elem && elem->has("backgroundColor"))
-		backColor = elem->get<unsigned int>("backgroundColor");
+	if (elem && elem->has(idBackgroundColor))
+		backColor = elem->get<unsigned int>(idBackgroundColor);
 
-	if (elem && elem->has("glowColor"))
-		glowColor = elem->get<unsigned int>("glowColor");
+	if (elem && elem->has(idGlowColor))
+		glowColor = elem->get<unsigned int>(idGlowColor);
 
-	if (elem && elem->has("glowSize"))
-		glowSize = elem->get<float>("glowSize");
+	if (elem && elem->has(idGlowSize))
+		glowSize = elem->get<float>(idGlowSize);
 
-	if (elem && elem->has("fontSize"))
-		fontSize = elem->get<float>("fontSize");
+	if (elem && elem->has(idFontSize))
+		fontSize = elem->get<float>(idFontSize);
 
-	if (elem && elem->has("fontPath"))
-		fontPath = elem->get<std::string>("fontPath");
+	if (elem && elem->has(idFontPath))
+		fontPath = elem->get<std::string>(idFontPath);
 
-	if (elem->has("singleLineScroll"))
-		autoScroll = elem->get<bool>("singleLineScroll");
+	if (elem->has(idSingleLineScroll))
+		autoScroll = elem->get<bool>(idSingleLineScroll);
 
 	return true;
 }
 
 bool GridNinePatchProperties::applyTheme(const ThemeData::ThemeElement* elem)
 {
+	static const ThemeData::PropertyId idVisible = ThemeData::getPropertyId("visible");
+	static const ThemeData::PropertyId idPos = ThemeData::getPropertyId("pos");
+	static const ThemeData::PropertyId idSize = ThemeData::getPropertyId("size");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idCenterColor = ThemeData::getPropertyId("centerColor");
+	static const ThemeData::PropertyId idEdgeColor = ThemeData::getPropertyId("edgeColor");
+	static const ThemeData::PropertyId idCornerSize = ThemeData::getPropertyId("cornerSize");
+	static const ThemeData::PropertyId idPath = ThemeData::getPropertyId("path");
+	static const ThemeData::PropertyId idAnimateColor = ThemeData::getPropertyId("animateColor");
+	static const ThemeData::PropertyId idAnimateColorTime = ThemeData::getPropertyId("animateColorTime");
+
 	if (!elem)
 	{
 		Visible = false;
@@ -578,48 +625,53 @@ bool GridNinePatchProperties::applyTheme(const ThemeData::ThemeElement* elem)
 	Loaded = true;
 	Visible = true;
 
-	if (elem && elem->has("visible"))
-		Visible = elem->get<bool>("visible");
+	if (elem && elem->has(idVisible))
+		Visible = elem->get<bool>(idVisible);
 	/*
-	if (elem && elem->has("pos"))
-		pos = elem->get<Vector2f>("pos");
+	if (elem && elem->has(idPos))
+		pos = elem->get<Vector2f>(idPos);
 
-	if (elem && elem->has("size"))
-		size = elem->get<Vector2f>("size");
+	if (elem && elem->has(idSize))
+		size = elem->get<Vector2f>(idSize);
 		*/
-	if (elem && elem->has("color"))
-		centerColor = edgeColor = elem->get<unsigned int>("color");
+	if (elem && elem->has(idColor))
+		centerColor = edgeColor = elem->get<unsigned int>(idColor);
 
-	if (elem && elem->has("centerColor"))
-		centerColor = elem->get<unsigned int>("centerColor");
+	if (elem && elem->has(idCenterColor))
+		centerColor = elem->get<unsigned int>(idCenterColor);
 
-	if (elem && elem->has("edgeColor"))
-		edgeColor = elem->get<unsigned int>("edgeColor");
+	if (elem && elem->has(idEdgeColor))
+		edgeColor = elem->get<unsigned int>(idEdgeColor);
 
-	if (elem && elem->has("cornerSize"))
-		cornerSize = elem->get<Vector2f>("cornerSize");
+	if (elem && elem->has(idCornerSize))
+		cornerSize = elem->get<Vector2f>(idCornerSize);
 
-	if (elem && elem->has("path"))
-		path = elem->get<std::string>("path");
+	if (elem && elem->has(idPath))
+		path = elem->get<std::string>(idPath);
 
-	if (elem && elem->has("animateColor"))
-		animateColor = elem->get<unsigned int>("animateColor");
+	if (elem && elem->has(idAnimateColor))
+		animateColor = elem->get<unsigned int>(idAnimateColor);
 
-	if (elem && elem->has("animateColorTime"))
-		animateTime = elem->get<float>("animateColorTime");
+	if (elem && elem->has(idAnimateColorTime))
+		animateTime = elem->get<float>(idAnimateColorTime);
 
 	return true;
 }
 
 void GridTileComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {
+	static const ThemeData::PropertyId idShowVideoAtDelay = ThemeData::getPropertyId("showVideoAtDelay");
+	static const ThemeData::PropertyId idVisible = ThemeData::getPropertyId("visible");
+	static const ThemeData::PropertyId idPos = ThemeData::getPropertyId("pos");
+	static const ThemeData::PropertyId idSize = ThemeData::getPropertyId("size");
+
 	if (mSize == Vector2f::Zero())
 		setSize(getDefaultTileSize());
 
 	resetProperties();
 
 	const ThemeData::ThemeElement* grid = theme->getElement(view, "gamegrid", "imagegrid");
-	if (grid && grid->has("showVideoAtDelay"))
+	if (grid && grid->has(idShowVideoAtDelay))
 	{
 		createVideo();
 
@@ -748,9 +800,9 @@ void GridTileComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, cons
 		mDefaultProperties.Label.applyTheme(elem);
 		mSelectedProperties.Label.applyTheme(elem);		
 
-		bool hasVisible = elem->has("visible");
-		mLabelMerged = elem->has("pos");
-		if (!mLabelMerged && elem->has("size"))
+		bool hasVisible = elem->has(idVisible);
+		mLabelMerged = elem->has(idPos);
+		if (!mLabelMerged && elem->has(idSize))
 			mLabelMerged = mDefaultProperties.Label.size.x() == 0;
 
 		// Apply theme to the <text name="gridtile:selected"> element
@@ -763,7 +815,7 @@ void GridTileComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, cons
 		if (elem)
 		{
 			mSelectedProperties.Label.applyTheme(elem);
-			if (hasVisible && !elem->has("visible"))
+			if (hasVisible && !elem->has(idVisible))
 				mSelectedProperties.Label.Visible = mDefaultProperties.Label.Visible;
 		}
 	}
@@ -822,13 +874,25 @@ void GridTileComponent::setImage(const std::string& path, bool isDefaultImage)
 		return;
 
 	mCurrentPath = path;
+	mImage->setImage(path, false, getImageMaxSizeInfo());
 
+	resize();
+}
+
+MaxSizeInfo GridTileComponent::getImageMaxSizeInfo()
+{
 	if (mSelectedProperties.Size.x() > mSize.x())
-		mImage->setImage(path, false, MaxSizeInfo(mSelectedProperties.Size, mSelectedProperties.Image.sizeMode != "maxSize"));
-	else
-		mImage->setImage(path, false, MaxSizeInfo(mSize, mSelectedProperties.Image.sizeMode != "maxSize"));
+		return MaxSizeInfo(mSelectedProperties.Size, mSelectedProperties.Image.sizeMode != "maxSize");
 
-	resize();
+	return MaxSizeInfo(mSize, mSelectedProperties.Image.sizeMode != "maxSize");
+}
+
+MaxSizeInfo GridTileComponent::getMarqueeMaxSizeInfo()
+{
+	if (mSelectedProperties.Size.x() > mSize.x())
+		return MaxSizeInfo(mSelectedProperties.Size);
+
+	return MaxSizeInfo(mSize);
 }
 
 void GridTileComponent::setMarquee(const std::string& path)
@@ -840,11 +904,7 @@ void GridTileComponent::setMarquee(const std::string& path)
 		return;
 
 	mCurrentMarquee = path;
-
-	if (mSelectedProperties.Size.x() > mSize.x())
-		mMarquee->setImage(path, false, MaxSizeInfo(mSelectedProperties.Size));
-	else
-		mMarquee->setImage(path, false, MaxSizeInfo(mSize));
+	mMarquee->setImage(path, false, getMarqueeMaxSizeInfo());
 
 	resize();
 }
@@ -203,6 +203,11 @@ public:
 
 	void setImage(const std::string& path, bool isDefaultImage = false);
 	void setMarquee(const std::string& path);
+
+	// Sizes the image and the marquee are downscaled to when loaded
+	MaxSizeInfo getImageMaxSizeInfo();
+	MaxSizeInfo getMarqueeMaxSizeInfo();
+	bool hasMarquee() { return mMarquee != nullptr; }
 	
 	void setFavorite(bool favorite);
 	bool hasFavoriteMedia() { return mFavorite != nullptr; }
@@ -28,6 +28,7 @@ ImageComponent::ImageComponent(Window* window, bool forceLoad, bool dynamic) : G
 	mTopLeftCrop(0.0f, 0.0f), mBottomRightCrop(1.0f, 1.0f), mMirror(0.0f, 0.0f), mPadding(Vector4f(0, 0, 0, 0))
 {
 	mLinear = false;
+	mAllowAtlas = false;
 	mHorizontalAlignment = ALIGN_CENTER;
 	mVerticalAlignment = ALIGN_CENTER;
 	mReflectOnBorders = false;
@@ -169,11 +170,11 @@ void ImageComponent::setImage(std::string path, bool tile, MaxSizeInfo maxSize)
 		if (mDefaultPath.empty() || !ResourceManager::getInstance()->fileExists(mDefaultPath))
 			mTexture.reset();
 		else
-			mTexture = TextureResource::get(mDefaultPath, tile, mLinear, mForceLoad, mDynamic, true, maxSize);
+			mTexture = TextureResource::get(mDefaultPath, tile, mLinear, mForceLoad, mDynamic, true, maxSize, mAllowAtlas);
 	}
 	else
 	{
-		std::shared_ptr<TextureResource> texture = TextureResource::get(mPath, tile, mLinear, mForceLoad, mDynamic, true, maxSize);
+		std::shared_ptr<TextureResource> texture = TextureResource::get(mPath, tile, mLinear, mForceLoad, mDynamic, true, maxSize, mAllowAtlas);
 
 		if (!mForceLoad && mDynamic && !mAllowFading && texture != nullptr && !texture->isLoaded())
 			mLoadingTexture = texture;
@@ -420,6 +421,21 @@ void ImageComponent::render(const Transform4x4f& parentTrans)
 		mVertices[2].col = mColorGradientHorizontal ? color : colorEnd;
 		mVertices[3].col = colorEnd;
 
+		// Texture packed in the atlas : map the texture coordinates to its region
+		Renderer::Vertex vertices[4];
+		for (int i = 0; i < 4; i++)
+			vertices[i] = mVertices[i];
+
+		Vector4f region;
+		if (mAllowAtlas && mTexture->getAtlasTexCoords(region))
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				vertices[i].tex[0] = region.x() + vertices[i].tex[0] * (region.z() - region.x());
+				vertices[i].tex[1] = region.y() + vertices[i].tex[1] * (region.w() - region.y());
+			}
+		}
+
 		if (mRoundCorners > 0)
 		{
 			float x = 0;
@@ -443,7 +459,7 @@ void ImageComponent::render(const Transform4x4f& parentTrans)
 			mTexture->bind();
 		}			
 	
-		Renderer::drawTriangleStrips(&mVertices[0], 4);
+		Renderer::drawTriangleStrips(&vertices[0], 4);
 		
 		if (mRoundCorners > 0)
 			Renderer::disableStencil();			
@@ -466,22 +482,22 @@ void ImageComponent::render(const Transform4x4f& parentTrans)
 
 			mirrorVertices[0] = {
 				{ mVertices[0].pos.x(), mVertices[0].pos.y() + h },
-				{ mVertices[0].tex.x(), mVertices[1].tex.y() },
+				{ vertices[0].tex.x(), vertices[1].tex.y() },
 				colorT };
 
 			mirrorVertices[1] = {
 				{ mVertices[1].pos.x(), mVertices[1].pos.y() + h },
-				{ mVertices[1].tex.x(), mVertices[0].tex.y() },
+				{ vertices[1].tex.x(), vertices[0].tex.y() },
 				colorB };
 
 			mirrorVertices[2] = {
 				{ mVertices[2].pos.x(), mVertices[2].pos.y() + h },
-				{ mVertices[2].tex.x(), mVertices[3].tex.y() },
+				{ vertices[2].tex.x(), vertices[3].tex.y() },
 				colorT };
 
 			mirrorVertices[3] = {
 				{ mVertices[3].pos.x(), mVertices[3].pos.y() + h },
-				{ mVertices[3].tex.x(), mVertices[2].tex.y() },
+				{ vertices[3].tex.x(), vertices[2].tex.y() },
 				colorB };
 
 			Renderer::drawTriangleStrips(&mirrorVertices[0], 4);
@@ -544,6 +560,31 @@ bool ImageComponent::hasImage()
 
 void ImageComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {
+	// Resolved once for all the components
+	static const ThemeData::PropertyId idLinearSmooth = ThemeData::getPropertyId("linearSmooth");
+	static const ThemeData::PropertyId idPos = ThemeData::getPropertyId("pos");
+	static const ThemeData::PropertyId idSize = ThemeData::getPropertyId("size");
+	static const ThemeData::PropertyId idMaxSize = ThemeData::getPropertyId("maxSize");
+	static const ThemeData::PropertyId idMinSize = ThemeData::getPropertyId("minSize");
+	static const ThemeData::PropertyId idOrigin = ThemeData::getPropertyId("origin");
+	static const ThemeData::PropertyId idDefault = ThemeData::getPropertyId("default");
+	static const ThemeData::PropertyId idPath = ThemeData::getPropertyId("path");
+	static const ThemeData::PropertyId idTile = ThemeData::getPropertyId("tile");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idColorEnd = ThemeData::getPropertyId("colorEnd");
+	static const ThemeData::PropertyId idGradientType = ThemeData::getPropertyId("gradientType");
+	static const ThemeData::PropertyId idReflexion = ThemeData::getPropertyId("reflexion");
+	static const ThemeData::PropertyId idReflexionOnFrame = ThemeData::getPropertyId("reflexionOnFrame");
+	static const ThemeData::PropertyId idRotation = ThemeData::getPropertyId("rotation");
+	static const ThemeData::PropertyId idRotationOrigin = ThemeData::getPropertyId("rotationOrigin");
+	static const ThemeData::PropertyId idFlipX = ThemeData::getPropertyId("flipX");
+	static const ThemeData::PropertyId idFlipY = ThemeData::getPropertyId("flipY");
+	static const ThemeData::PropertyId idHorizontalAlignment = ThemeData::getPropertyId("horizontalAlignment");
+	static const ThemeData::PropertyId idVerticalAlignment = ThemeData::getPropertyId("verticalAlignment");
+	static const ThemeData::PropertyId idZIndex = ThemeData::getPropertyId("zIndex");
+	static const ThemeData::PropertyId idRoundCorners = ThemeData::getPropertyId("roundCorners");
+	static const ThemeData::PropertyId idVisible = ThemeData::getPropertyId("visible");
+
 	using namespace ThemeFlags;
 
 	const ThemeData::ThemeElement* elem = theme->getElement(view, element, "image");
@@ -552,22 +593,22 @@ void ImageComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const s
 		return;
 	}
 
-	if (elem->has("linearSmooth"))
-		mLinear = elem->get<bool>("linearSmooth");
+	if (elem->has(idLinearSmooth))
+		mLinear = elem->get<bool>(idLinearSmooth);
 
 	Vector2f scale = getParent() ? getParent()->getSize() : Vector2f((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight());
 	
-	if(properties & POSITION && elem->has("pos"))
+	if(properties & POSITION && elem->has(idPos))
 	{
-		Vector2f denormalized = elem->get<Vector2f>("pos") * scale;
+		Vector2f denormalized = elem->get<Vector2f>(idPos) * scale;
 		setPosition(Vector3f(denormalized.x(), denormalized.y(), 0));
 	}
 
 	if(properties & ThemeFlags::SIZE)
 	{
-		if(elem->has("size"))
+		if(elem->has(idSize))
 		{
-			auto sz = elem->get<Vector2f>("size");
+			auto sz = elem->get<Vector2f>(idSize);
 			if (sz.x() == 0 && sz.y() != 0 && Settings::getInstance()->getInt("ScreenRotate") != 0)
 			{
 				sz.x() = sz.y();
@@ -581,72 +622,72 @@ void ImageComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const s
 			else
 				setResize(sz * scale);
 		}
-		else if(elem->has("maxSize"))
-			setMaxSize(elem->get<Vector2f>("maxSize") * scale);
-		else if(elem->has("minSize"))
-			setMinSize(elem->get<Vector2f>("minSize") * scale);
+		else if(elem->has(idMaxSize))
+			setMaxSize(elem->get<Vector2f>(idMaxSize) * scale);
+		else if(elem->has(idMinSize))
+			setMinSize(elem->get<Vector2f>(idMinSize) * scale);
 	}
 	
 	// position + size also implies origin
-	if((properties & ORIGIN || (properties & POSITION && properties & ThemeFlags::SIZE)) && elem->has("origin"))
-		setOrigin(elem->get<Vector2f>("origin"));
+	if((properties & ORIGIN || (properties & POSITION && properties & ThemeFlags::SIZE)) && elem->has(idOrigin))
+		setOrigin(elem->get<Vector2f>(idOrigin));
 
-	if(elem->has("default")) {
-		setDefaultImage(elem->get<std::string>("default"));
+	if(elem->has(idDefault)) {
+		setDefaultImage(elem->get<std::string>(idDefault));
 	}
 
 
 
-	if(properties & PATH && elem->has("path"))
+	if(properties & PATH && elem->has(idPath))
 	{
-		auto path = elem->get<std::string>("path");
+		auto path = elem->get<std::string>(idPath);
 		if (ResourceManager::getInstance()->fileExists(path))
 		{
-			bool tile = (elem->has("tile") && elem->get<bool>("tile"));
+			bool tile = (elem->has(idTile) && elem->get<bool>(idTile));
 			setImage(path, tile/*, Vector2f(mTargetSize.x(), mTargetSize.y())*/);
 		}
 	}
 
 	if (properties & COLOR)
 	{
-		if (elem->has("color"))
-			setColorShift(elem->get<unsigned int>("color"));
+		if (elem->has(idColor))
+			setColorShift(elem->get<unsigned int>(idColor));
 
-		if (elem->has("colorEnd"))
-			setColorShiftEnd(elem->get<unsigned int>("colorEnd"));
+		if (elem->has(idColorEnd))
+			setColorShiftEnd(elem->get<unsigned int>(idColorEnd));
 
-		if (elem->has("gradientType"))
-			setColorGradientHorizontal(elem->get<std::string>("gradientType").compare("horizontal"));
+		if (elem->has(idGradientType))
+			setColorGradientHorizontal(elem->get<std::string>(idGradientType).compare("horizontal"));
 
-		if (elem->has("reflexion"))
-			mMirror = elem->get<Vector2f>("reflexion");
+		if (elem->has(idReflexion))
+			mMirror = elem->get<Vector2f>(idReflexion);
 		else
 			mMirror = Vector2f::Zero();
 
-		if (elem->has("reflexionOnFrame"))
-			mReflectOnBorders = elem->get<bool>("reflexionOnFrame");
+		if (elem->has(idReflexionOnFrame))
+			mReflectOnBorders = elem->get<bool>(idReflexionOnFrame);
 		else
 			mReflectOnBorders = false;
 	}
 
 	if(properties & ThemeFlags::ROTATION) 
 	{
-		if(elem->has("rotation"))
-			setRotationDegrees(elem->get<float>("rotation"));
+		if(elem->has(idRotation))
+			setRotationDegrees(elem->get<float>(idRotation));
 
-		if(elem->has("rotationOrigin"))
-			setRotationOrigin(elem->get<Vector2f>("rotationOrigin"));
+		if(elem->has(idRotationOrigin))
+			setRotationOrigin(elem->get<Vector2f>(idRotationOrigin));
 
-		if (elem->has("flipX"))
-			setFlipX(elem->get<bool>("flipX"));
+		if (elem->has(idFlipX))
+			setFlipX(elem->get<bool>(idFlipX));
 
-		if (elem->has("flipY"))
-			setFlipY(elem->get<bool>("flipY"));
+		if (elem->has(idFlipY))
+			setFlipY(elem->get<bool>(idFlipY));
 	}
 
-	if (properties & ALIGNMENT && elem->has("horizontalAlignment"))
+	if (properties & ALIGNMENT && elem->has(idHorizontalAlignment))
 	{
-		std::string str = elem->get<std::string>("horizontalAlignment");
+		std::string str = elem->get<std::string>(idHorizontalAlignment);
 		if (str == "left")
 			setHorizontalAlignment(ALIGN_LEFT);
 		else if (str == "right")
@@ -655,9 +696,9 @@ void ImageComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const s
 			setHorizontalAlignment(ALIGN_CENTER);
 	}
 
-	if (properties & ALIGNMENT && elem->has("verticalAlignment"))
+	if (properties & ALIGNMENT && elem->has(idVerticalAlignment))
 	{
-		std::string str = elem->get<std::string>("verticalAlignment");
+		std::string str = elem->get<std::string>(idVerticalAlignment);
 		if (str == "top")
 			setVerticalAlignment(ALIGN_TOP);
 		else if (str == "bottom")
@@ -666,16 +707,16 @@ void ImageComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const s
 			setVerticalAlignment(ALIGN_CENTER);
 	}
 
-	if(properties & ThemeFlags::Z_INDEX && elem->has("zIndex"))
-		setZIndex(elem->get<float>("zIndex"));
+	if(properties & ThemeFlags::Z_INDEX && elem->has(idZIndex))
+		setZIndex(elem->get<float>(idZIndex));
 	else
 		setZIndex(getDefaultZIndex());
 
-	if (properties & ALIGNMENT && elem->has("roundCorners"))
-		mRoundCorners = elem->get<float>("roundCorners");
+	if (properties & ALIGNMENT && elem->has(idRoundCorners))
+		mRoundCorners = elem->get<float>(idRoundCorners);
 
-	if(properties & ThemeFlags::VISIBLE && elem->has("visible"))
-		setVisible(elem->get<bool>("visible"));
+	if(properties & ThemeFlags::VISIBLE && elem->has(idVisible))
+		setVisible(elem->get<bool>(idVisible));
 	else
 		setVisible(true);
 }
@@ -119,6 +119,9 @@ public:
 	bool isLinear() { return mLinear; }
 	void setIsLinear(bool value) { mLinear = value; }
 
+	// Allows the texture to be packed in the shared texture atlas. Must be set before setImage.
+	void setAllowAtlas(bool value) { mAllowAtlas = value; }
+
 private:
 	Vector2f mTargetSize;
 
@@ -168,6 +171,7 @@ private:
 	float mPlaylistTimer;
 
 	bool mLinear;
+	bool mAllowAtlas;
 };
 
 #endif // ES_CORE_COMPONENTS_IMAGE_COMPONENT_H
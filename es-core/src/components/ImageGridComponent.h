@@ -89,6 +89,8 @@ public:
 	void setGridSizeOverride(Vector2f size);
 
 	std::shared_ptr<GridTileComponent> getSelectedTile();
+	// All tiles share the same layout : any of them tells how images are displayed
+	std::shared_ptr<GridTileComponent> getFirstTile() { return mTiles.size() == 0 ? nullptr : mTiles.at(0); }
 	
 	void resetLastCursor() { mLastCursor = -1; }
 
@@ -425,6 +427,21 @@ void ImageGridComponent<T>::render(const Transform4x4f& parentTrans)
 template<typename T>
 void ImageGridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {
+	static const ThemeData::PropertyId idMargin = ThemeData::getPropertyId("margin");
+	static const ThemeData::PropertyId idPadding = ThemeData::getPropertyId("padding");
+	static const ThemeData::PropertyId idAutoLayout = ThemeData::getPropertyId("autoLayout");
+	static const ThemeData::PropertyId idAnimateSelection = ThemeData::getPropertyId("animateSelection");
+	static const ThemeData::PropertyId idAutoLayoutSelectedZoom = ThemeData::getPropertyId("autoLayoutSelectedZoom");
+	static const ThemeData::PropertyId idImageSource = ThemeData::getPropertyId("imageSource");
+	static const ThemeData::PropertyId idScrollDirection = ThemeData::getPropertyId("scrollDirection");
+	static const ThemeData::PropertyId idShowVideoAtDelay = ThemeData::getPropertyId("showVideoAtDelay");
+	static const ThemeData::PropertyId idCenterSelection = ThemeData::getPropertyId("centerSelection");
+	static const ThemeData::PropertyId idScrollLoop = ThemeData::getPropertyId("scrollLoop");
+	static const ThemeData::PropertyId idGameImage = ThemeData::getPropertyId("gameImage");
+	static const ThemeData::PropertyId idFolderImage = ThemeData::getPropertyId("folderImage");
+	static const ThemeData::PropertyId idScrollSound = ThemeData::getPropertyId("scrollSound");
+	static const ThemeData::PropertyId idSize = ThemeData::getPropertyId("size");
+
 	// Keep the theme pointer to apply it on the tiles later on
 	mTheme = nullptr;
 
@@ -436,24 +453,24 @@ void ImageGridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 	const ThemeData::ThemeElement* elem = theme->getElement(view, element, "imagegrid");
 	if (elem)
 	{
-		if (elem->has("margin"))
-			mMargin = elem->get<Vector2f>("margin") * screen;
+		if (elem->has(idMargin))
+			mMargin = elem->get<Vector2f>(idMargin) * screen;
 
-		if (elem->has("padding"))
-			mPadding = elem->get<Vector4f>("padding") * Vector4f(screen.x(), screen.y(), screen.x(), screen.y());
+		if (elem->has(idPadding))
+			mPadding = elem->get<Vector4f>(idPadding) * Vector4f(screen.x(), screen.y(), screen.x(), screen.y());
 
-		if (elem->has("autoLayout"))
-			mAutoLayout = elem->get<Vector2f>("autoLayout");		
+		if (elem->has(idAutoLayout))
+			mAutoLayout = elem->get<Vector2f>(idAutoLayout);		
 
-		if (elem->has("animateSelection"))
-			mAnimateSelection = elem->get<bool>("animateSelection");
+		if (elem->has(idAnimateSelection))
+			mAnimateSelection = elem->get<bool>(idAnimateSelection);
 
-		if (elem->has("autoLayoutSelectedZoom"))
-			mAutoLayoutZoom = elem->get<float>("autoLayoutSelectedZoom");
+		if (elem->has(idAutoLayoutSelectedZoom))
+			mAutoLayoutZoom = elem->get<float>(idAutoLayoutSelectedZoom);
 
-		if (elem->has("imageSource"))
+		if (elem->has(idImageSource))
 		{
-			auto direction = elem->get<std::string>("imageSource");
+			auto direction = elem->get<std::string>(idImageSource);
 			if (direction == "image")
 				mImageSource = IMAGE;
 			else if (direction == "marquee")
@@ -464,9 +481,9 @@ void ImageGridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 		else 
 			mImageSource = THUMBNAIL;
 
-		if (elem->has("scrollDirection"))
+		if (elem->has(idScrollDirection))
 		{
-			auto direction = elem->get<std::string>("scrollDirection");
+			auto direction = elem->get<std::string>(idScrollDirection);
 			if (direction == "horizontal")
 			{
 				mCenterSelection = CenterSelection::PARTIAL;
@@ -489,32 +506,32 @@ void ImageGridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 			}
 		}
 
-		if (elem->has("showVideoAtDelay"))
+		if (elem->has(idShowVideoAtDelay))
 		{
-			mVideoDelay = elem->get<float>("showVideoAtDelay");
+			mVideoDelay = elem->get<float>(idShowVideoAtDelay);
 			mAllowVideo = (mVideoDelay >= 0);
 		}
 		else
 			mAllowVideo = false;
 
-		if (elem->has("centerSelection"))
+		if (elem->has(idCenterSelection))
 		{
-			if (!(elem->get<std::string>("centerSelection").compare("true")))
+			if (!(elem->get<std::string>(idCenterSelection).compare("true")))
 				mCenterSelection = CenterSelection::FULL;
-			else if (!(elem->get<std::string>("centerSelection").compare("partial")))
+			else if (!(elem->get<std::string>(idCenterSelection).compare("partial")))
 				mCenterSelection = CenterSelection::PARTIAL;
 			else 
 				mCenterSelection = CenterSelection::NEVER;
 		}
 
-		if (mCenterSelection != CenterSelection::NEVER && elem->has("scrollLoop"))
-			mScrollLoop = (elem->get<bool>("scrollLoop"));
+		if (mCenterSelection != CenterSelection::NEVER && elem->has(idScrollLoop))
+			mScrollLoop = (elem->get<bool>(idScrollLoop));
 		else
 			mScrollLoop = false;
 
-		if (elem->has("gameImage"))
+		if (elem->has(idGameImage))
 		{
-			std::string path = elem->get<std::string>("gameImage");
+			std::string path = elem->get<std::string>(idGameImage);
 
 			if (!ResourceManager::getInstance()->fileExists(path))
 				LOG(LogWarning) << "ImageGridComponent<T>::applyTheme() - Could not replace default game image, check path: " << path;
@@ -533,9 +550,9 @@ void ImageGridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 			}
 		}
 
-		if (elem->has("folderImage"))
+		if (elem->has(idFolderImage))
 		{
-			std::string path = elem->get<std::string>("folderImage");
+			std::string path = elem->get<std::string>(idFolderImage);
 
 			if (!ResourceManager::getInstance()->fileExists(path))
 				LOG(LogWarning) << "ImageGridComponent<T>::applyTheme() - Could not replace default folder image, check path: " << path;
@@ -555,15 +572,15 @@ void ImageGridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 		}
 	}
 
-	if (elem->has("scrollSound"))
-		mScrollSound = elem->get<std::string>("scrollSound");
+	if (elem->has(idScrollSound))
+		mScrollSound = elem->get<std::string>(idScrollSound);
 
 	// We still need to manually get the grid tile size here,
 	// so we can recalculate the new grid dimension, and THEN (re)build the tiles
 	elem = theme->getElement(view, "default", "gridtile");
 
-	mTileSize = elem && elem->has("size") ?
-				elem->get<Vector2f>("size") * screen :
+	mTileSize = elem && elem->has(idSize) ?
+				elem->get<Vector2f>(idSize) * screen :
 				GridTileComponent::getDefaultTileSize();
 
 	// Apply size property, will trigger a call to onSizeChanged() which will build the tiles
@@ -800,11 +817,20 @@ void ImageGridComponent<T>::updateTiles(bool allowAnimation, bool updateSelected
 	}
 	
 	// Collect new textures
+	int extraTiles = EXTRAITEMS * (isVertical() ? mGridDimension.x() : mGridDimension.y());
+
 	std::vector<std::shared_ptr<TextureResource>> newTextures;
 	for (int ti = 0; ti < (int)mTiles.size(); ti++)
 	{
 		newTextures.push_back(mTiles.at(ti)->getTexture(true));
 		newTextures.push_back(mTiles.at(ti)->getTexture(false));
+
+		// Extra tiles are off-screen until the next scroll : load them after the visible ones
+		if (ti < extraTiles || ti >= (int)mTiles.size() - extraTiles)
+		{
+			TextureResource::setLoadingPriority(mTiles.at(ti)->getTexture(true), TextureLoader::PRIORITY_NEXT_PAGE);
+			TextureResource::setLoadingPriority(mTiles.at(ti)->getTexture(false), TextureLoader::PRIORITY_NEXT_PAGE);
+		}
 	}
 
 	// Compare old texture with new textures -> Remove missing from async queue if existing
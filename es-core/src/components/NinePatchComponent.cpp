@@ -262,6 +262,14 @@ void NinePatchComponent::setCenterColor(unsigned int centerColor)
 
 void NinePatchComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {
+	static const ThemeData::PropertyId idPath = ThemeData::getPropertyId("path");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idCenterColor = ThemeData::getPropertyId("centerColor");
+	static const ThemeData::PropertyId idEdgeColor = ThemeData::getPropertyId("edgeColor");
+	static const ThemeData::PropertyId idCornerSize = ThemeData::getPropertyId("cornerSize");
+	static const ThemeData::PropertyId idAnimateColor = ThemeData::getPropertyId("animateColor");
+	static const ThemeData::PropertyId idAnimateColorTime = ThemeData::getPropertyId("animateColorTime");
+
 	GuiComponent::applyTheme(theme, view, element, properties);
 
 	using namespace ThemeFlags;
@@ -270,30 +278,30 @@ void NinePatchComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, con
 	if (!elem)
 		return;
 
-	if (properties & PATH && elem->has("path"))
-		setImagePath(elem->get<std::string>("path"));
+	if (properties & PATH && elem->has(idPath))
+		setImagePath(elem->get<std::string>(idPath));
 
 	if (properties & COLOR)
 	{
-		if (elem->has("color"))
+		if (elem->has(idColor))
 		{
-			setCenterColor(elem->get<unsigned int>("color"));
-			setEdgeColor(elem->get<unsigned int>("color"));
+			setCenterColor(elem->get<unsigned int>(idColor));
+			setEdgeColor(elem->get<unsigned int>(idColor));
 		}
 
-		if (elem->has("centerColor"))
-			setCenterColor(elem->get<unsigned int>("centerColor"));
+		if (elem->has(idCenterColor))
+			setCenterColor(elem->get<unsigned int>(idCenterColor));
 
-		if (elem->has("edgeColor"))
-			setEdgeColor(elem->get<unsigned int>("edgeColor"));
+		if (elem->has(idEdgeColor))
+			setEdgeColor(elem->get<unsigned int>(idEdgeColor));
 	}
 
-	if (elem->has("cornerSize"))
-		setCornerSize(elem->get<Vector2f>("cornerSize"));
+	if (elem->has(idCornerSize))
+		setCornerSize(elem->get<Vector2f>(idCornerSize));
 
-	if (elem->has("animateColor"))
-		setAnimateColor(elem->get<unsigned int>("animateColor"));
+	if (elem->has(idAnimateColor))
+		setAnimateColor(elem->get<unsigned int>(idAnimateColor));
 
-	if (elem->has("animateColorTime"))
-		setAnimateTiming(elem->get<float>("animateColorTime"));
+	if (elem->has(idAnimateColorTime))
+		setAnimateTiming(elem->get<float>(idAnimateColorTime));
 }
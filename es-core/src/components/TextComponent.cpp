@@ -449,6 +449,22 @@ std::string TextComponent::getValue() const
 
 void TextComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {
+	// Resolved once for all the components
+	static const ThemeData::PropertyId idAlignment = ThemeData::getPropertyId("alignment");
+	static const ThemeData::PropertyId idVerticalAlignment = ThemeData::getPropertyId("verticalAlignment");
+	static const ThemeData::PropertyId idPadding = ThemeData::getPropertyId("padding");
+	static const ThemeData::PropertyId idText = ThemeData::getPropertyId("text");
+	static const ThemeData::PropertyId idForceUppercase = ThemeData::getPropertyId("forceUppercase");
+	static const ThemeData::PropertyId idLineSpacing = ThemeData::getPropertyId("lineSpacing");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idBackgroundColor = ThemeData::getPropertyId("backgroundColor");
+	static const ThemeData::PropertyId idGlowColor = ThemeData::getPropertyId("glowColor");
+	static const ThemeData::PropertyId idGlowSize = ThemeData::getPropertyId("glowSize");
+	static const ThemeData::PropertyId idGlowOffset = ThemeData::getPropertyId("glowOffset");
+	static const ThemeData::PropertyId idReflexion = ThemeData::getPropertyId("reflexion");
+	static const ThemeData::PropertyId idReflexionOnFrame = ThemeData::getPropertyId("reflexionOnFrame");
+	static const ThemeData::PropertyId idSingleLineScroll = ThemeData::getPropertyId("singleLineScroll");
+
 	//LOG(LogDebug) << "TextComponent::applyTheme() - mText: " << mText;
 	GuiComponent::applyTheme(theme, view, element, properties);
 
@@ -460,9 +476,9 @@ void TextComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const st
 
 	if (properties & ALIGNMENT)
 	{
-		if (elem->has("alignment"))
+		if (elem->has(idAlignment))
 		{
-			std::string str = elem->get<std::string>("alignment");
+			std::string str = elem->get<std::string>(idAlignment);
 			if (str == "left")
 				setHorizontalAlignment(ALIGN_LEFT);
 			else if (str == "center")
@@ -473,9 +489,9 @@ void TextComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const st
 				LOG(LogError) << "TextComponent::applyTheme() - Unknown text alignment string: " << str;
 		}
 
-		if (elem->has("verticalAlignment"))
+		if (elem->has(idVerticalAlignment))
 		{
-			std::string str = elem->get<std::string>("verticalAlignment");
+			std::string str = elem->get<std::string>(idVerticalAlignment);
 			if (str == "top")
 				setVerticalAlignment(ALIGN_TOP);
 			else if (str == "center")
@@ -486,10 +502,10 @@ void TextComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const st
 				LOG(LogError) << "TextComponent::applyTheme() - Unknown text alignment string: " << str;
 		}
 
-		if (elem->has("padding"))
+		if (elem->has(idPadding))
 		{
 			Vector2f scale = getParent() ? getParent()->getSize() : Vector2f((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight());
-			mPadding = elem->get<Vector4f>("padding") * Vector4f(scale.x(), scale.y(), scale.x(), scale.y());
+			mPadding = elem->get<Vector4f>(idPadding) * Vector4f(scale.x(), scale.y(), scale.x(), scale.y());
 		}
 		else
 			mPadding = Vector4f::Zero();
@@ -497,60 +513,60 @@ void TextComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const st
 
 	if (properties & TEXT)
 	{
-		if (elem->has("text"))
+		if (elem->has(idText))
 		{
-			mSourceText = elem->get<std::string>("text");
+			mSourceText = elem->get<std::string>(idText);
 			setText(mSourceText);
 		}
 		else
 			mSourceText = "";
 	}
 
-	if (properties & FORCE_UPPERCASE && elem->has("forceUppercase"))
-		setUppercase(elem->get<bool>("forceUppercase"));
+	if (properties & FORCE_UPPERCASE && elem->has(idForceUppercase))
+		setUppercase(elem->get<bool>(idForceUppercase));
 
-	if (properties & LINE_SPACING && elem->has("lineSpacing"))
-		setLineSpacing(elem->get<float>("lineSpacing"));
+	if (properties & LINE_SPACING && elem->has(idLineSpacing))
+		setLineSpacing(elem->get<float>(idLineSpacing));
 
 	if (properties & COLOR)
 	{
-		if (elem->has("color"))
+		if (elem->has(idColor))
 		{
-			//LOG(LogDebug) << "TextComponent::applyTheme() - mText: " << mText << ", mColor: " << std::to_string( mColor ) << ", theme->color: " << std::to_string( elem->get<unsigned int>("color") );
-			setColor(elem->get<unsigned int>("color"));
+			//LOG(LogDebug) << "TextComponent::applyTheme() - mText: " << mText << ", mColor: " << std::to_string( mColor ) << ", theme->color: " << std::to_string( elem->get<unsigned int>(idColor) );
+			setColor(elem->get<unsigned int>(idColor));
 		}
 
-		if (elem->has("backgroundColor"))
+		if (elem->has(idBackgroundColor))
 		{
-			setBackgroundColor(elem->get<unsigned int>("backgroundColor"));
+			setBackgroundColor(elem->get<unsigned int>(idBackgroundColor));
 			setRenderBackground(true);
 		}
 		else 
 			setRenderBackground(false);
 
-		if (elem->has("glowColor"))
-			mGlowColor = elem->get<unsigned int>("glowColor");
+		if (elem->has(idGlowColor))
+			mGlowColor = elem->get<unsigned int>(idGlowColor);
 		else
 			mGlowColor = 0;
 
-		if (elem->has("glowSize"))
-			mGlowSize = (int)elem->get<float>("glowSize");
+		if (elem->has(idGlowSize))
+			mGlowSize = (int)elem->get<float>(idGlowSize);
 
-		if (elem->has("glowOffset"))
-			mGlowOffset = elem->get<Vector2f>("glowOffset");
+		if (elem->has(idGlowOffset))
+			mGlowOffset = elem->get<Vector2f>(idGlowOffset);
 
-		if (elem->has("reflexion"))
-			mReflection = elem->get<Vector2f>("reflexion");
+		if (elem->has(idReflexion))
+			mReflection = elem->get<Vector2f>(idReflexion);
 		else
 			mReflection = Vector2f::Zero();
 
-		if (elem->has("reflexionOnFrame"))
-			mReflectOnBorders = elem->get<bool>("reflexionOnFrame");
+		if (elem->has(idReflexionOnFrame))
+			mReflectOnBorders = elem->get<bool>(idReflexionOnFrame);
 		else
 			mReflectOnBorders = false;
 
-		if (elem->has("singleLineScroll"))
-			mAutoScroll = elem->get<bool>("singleLineScroll");
+		if (elem->has(idSingleLineScroll))
+			mAutoScroll = elem->get<bool>(idSingleLineScroll);
 		else
 			mAutoScroll = false;
 	}
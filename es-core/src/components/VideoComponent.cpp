@@ -209,6 +209,23 @@ void VideoComponent::renderSnapshot(const Transform4x4f& parentTrans)
 
 void VideoComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {
+	static const ThemeData::PropertyId idPos = ThemeData::getPropertyId("pos");
+	static const ThemeData::PropertyId idSize = ThemeData::getPropertyId("size");
+	static const ThemeData::PropertyId idMaxSize = ThemeData::getPropertyId("maxSize");
+	static const ThemeData::PropertyId idMinSize = ThemeData::getPropertyId("minSize");
+	static const ThemeData::PropertyId idOrigin = ThemeData::getPropertyId("origin");
+	static const ThemeData::PropertyId idDefault = ThemeData::getPropertyId("default");
+	static const ThemeData::PropertyId idDelay = ThemeData::getPropertyId("delay");
+	static const ThemeData::PropertyId idShowSnapshotNoVideo = ThemeData::getPropertyId("showSnapshotNoVideo");
+	static const ThemeData::PropertyId idShowSnapshotDelay = ThemeData::getPropertyId("showSnapshotDelay");
+	static const ThemeData::PropertyId idSnapshotSource = ThemeData::getPropertyId("snapshotSource");
+	static const ThemeData::PropertyId idRotation = ThemeData::getPropertyId("rotation");
+	static const ThemeData::PropertyId idRotationOrigin = ThemeData::getPropertyId("rotationOrigin");
+	static const ThemeData::PropertyId idZIndex = ThemeData::getPropertyId("zIndex");
+	static const ThemeData::PropertyId idVisible = ThemeData::getPropertyId("visible");
+	static const ThemeData::PropertyId idAudio = ThemeData::getPropertyId("audio");
+	static const ThemeData::PropertyId idPath = ThemeData::getPropertyId("path");
+
 	using namespace ThemeFlags;
 
 	const ThemeData::ThemeElement* elem = theme->getElement(view, element, "video");
@@ -219,42 +236,42 @@ void VideoComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const s
 
 	Vector2f scale = getParent() ? getParent()->getSize() : Vector2f((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight());
 
-	if ((properties & POSITION) && elem->has("pos"))
+	if ((properties & POSITION) && elem->has(idPos))
 	{
-		Vector2f denormalized = elem->get<Vector2f>("pos") * scale;
+		Vector2f denormalized = elem->get<Vector2f>(idPos) * scale;
 		setPosition(Vector3f(denormalized.x(), denormalized.y(), 0));
 		mStaticImage.setPosition(Vector3f(denormalized.x(), denormalized.y(), 0));
 	}
 
 	if(properties & ThemeFlags::SIZE)
 	{
-		if(elem->has("size"))
-			setResize(elem->get<Vector2f>("size") * scale);
-		else if(elem->has("maxSize"))
-			setMaxSize(elem->get<Vector2f>("maxSize") * scale);
-		else if (elem->has("minSize"))
-			setMinSize(elem->get<Vector2f>("minSize") * scale);
+		if(elem->has(idSize))
+			setResize(elem->get<Vector2f>(idSize) * scale);
+		else if(elem->has(idMaxSize))
+			setMaxSize(elem->get<Vector2f>(idMaxSize) * scale);
+		else if (elem->has(idMinSize))
+			setMinSize(elem->get<Vector2f>(idMinSize) * scale);
 	}
 
 	// position + size also implies origin
-	if (((properties & ORIGIN) || ((properties & POSITION) && (properties & ThemeFlags::SIZE))) && elem->has("origin"))
-		setOrigin(elem->get<Vector2f>("origin"));
+	if (((properties & ORIGIN) || ((properties & POSITION) && (properties & ThemeFlags::SIZE))) && elem->has(idOrigin))
+		setOrigin(elem->get<Vector2f>(idOrigin));
 
-	if(elem->has("default"))
-		mConfig.defaultVideoPath = elem->get<std::string>("default");
+	if(elem->has(idDefault))
+		mConfig.defaultVideoPath = elem->get<std::string>(idDefault);
 
-	if((properties & ThemeFlags::DELAY) && elem->has("delay"))
-		mConfig.startDelay = (unsigned)(elem->get<float>("delay") * 1000.0f);
+	if((properties & ThemeFlags::DELAY) && elem->has(idDelay))
+		mConfig.startDelay = (unsigned)(elem->get<float>(idDelay) * 1000.0f);
 
-	if (elem->has("showSnapshotNoVideo"))
-		mConfig.showSnapshotNoVideo = elem->get<bool>("showSnapshotNoVideo");
+	if (elem->has(idShowSnapshotNoVideo))
+		mConfig.showSnapshotNoVideo = elem->get<bool>(idShowSnapshotNoVideo);
 
-	if (elem->has("showSnapshotDelay"))
-		mConfig.showSnapshotDelay = elem->get<bool>("showSnapshotDelay");
+	if (elem->has(idShowSnapshotDelay))
+		mConfig.showSnapshotDelay = elem->get<bool>(idShowSnapshotDelay);
 
-	if (elem->has("snapshotSource"))
+	if (elem->has(idSnapshotSource))
 	{
-		auto direction = elem->get<std::string>("snapshotSource");
+		auto direction = elem->get<std::string>(idSnapshotSource);
 		if (direction == "image")
 			mConfig.snapshotSource = IMAGE;
 		else if (direction == "marquee")
@@ -264,31 +281,31 @@ void VideoComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const s
 	}
 
 	if(properties & ThemeFlags::ROTATION) {
-		if(elem->has("rotation"))
-			setRotationDegrees(elem->get<float>("rotation"));
-		if(elem->has("rotationOrigin"))
-			setRotationOrigin(elem->get<Vector2f>("rotationOrigin"));
+		if(elem->has(idRotation))
+			setRotationDegrees(elem->get<float>(idRotation));
+		if(elem->has(idRotationOrigin))
+			setRotationOrigin(elem->get<Vector2f>(idRotationOrigin));
 	}
 
-	if(properties & ThemeFlags::Z_INDEX && elem->has("zIndex"))
-		setZIndex(elem->get<float>("zIndex"));
+	if(properties & ThemeFlags::Z_INDEX && elem->has(idZIndex))
+		setZIndex(elem->get<float>(idZIndex));
 	else
 		setZIndex(getDefaultZIndex());
 
-	if(properties & ThemeFlags::VISIBLE && elem->has("visible"))
-		setVisible(elem->get<bool>("visible"));
+	if(properties & ThemeFlags::VISIBLE && elem->has(idVisible))
+		setVisible(elem->get<bool>(idVisible));
 	else
 		setVisible(true);
 
-	if (properties & ThemeFlags::VISIBLE && elem->has("audio"))
-		setPlayAudio(elem->get<bool>("audio"));
+	if (properties & ThemeFlags::VISIBLE && elem->has(idAudio))
+		setPlayAudio(elem->get<bool>(idAudio));
 	else
 		setPlayAudio(true);
 
-	if (elem->has("path"))
+	if (elem->has(idPath))
 	{
-		if (Utils::FileSystem::exists(elem->get<std::string>("path")))
-			mVideoPath = elem->get<std::string>("path");
+		if (Utils::FileSystem::exists(elem->get<std::string>(idPath)))
+			mVideoPath = elem->get<std::string>(idPath);
 		else
 			mVideoPath = mConfig.defaultVideoPath;
 	}
@@ -611,34 +611,39 @@ void VideoVlcComponent::stopVideo()
 
 void VideoVlcComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties)
 {
+	static const ThemeData::PropertyId idEffect = ThemeData::getPropertyId("effect");
+	static const ThemeData::PropertyId idRoundCorners = ThemeData::getPropertyId("roundCorners");
+	static const ThemeData::PropertyId idColor = ThemeData::getPropertyId("color");
+	static const ThemeData::PropertyId idLoops = ThemeData::getPropertyId("loops");
+
 	VideoComponent::applyTheme(theme, view, element, properties);
 
 	using namespace ThemeFlags;
 
 	const ThemeData::ThemeElement* elem = theme->getElement(view, element, "video");
-	if (elem && elem->has("effect"))
+	if (elem && elem->has(idEffect))
 	{
-		if (!(elem->get<std::string>("effect").compare("slideRight")))
+		if (!(elem->get<std::string>(idEffect).compare("slideRight")))
 			mEffect = VideoVlcFlags::VideoVlcEffect::SLIDERIGHT;
-		else if (!(elem->get<std::string>("effect").compare("size")))
+		else if (!(elem->get<std::string>(idEffect).compare("size")))
 			mEffect = VideoVlcFlags::VideoVlcEffect::SIZE;
-		else if (!(elem->get<std::string>("effect").compare("bump")))
+		else if (!(elem->get<std::string>(idEffect).compare("bump")))
 			mEffect = VideoVlcFlags::VideoVlcEffect::BUMP;
 		else
 			mEffect = VideoVlcFlags::VideoVlcEffect::NONE;
 	}
 
-	if (elem && elem->has("roundCorners"))
-		setRoundCorners(elem->get<float>("roundCorners"));
+	if (elem && elem->has(idRoundCorners))
+		setRoundCorners(elem->get<float>(idRoundCorners));
 	
 	if (properties & COLOR)
 	{
-		if (elem && elem->has("color"))
-			setColorShift(elem->get<unsigned int>("color"));
+		if (elem && elem->has(idColor))
+			setColorShift(elem->get<unsigned int>(idColor));
 	}
 
-	if (elem && elem->has("loops"))
-		mLoops = (int)elem->get<float>("loops");
+	if (elem && elem->has(idLoops))
+		mLoops = (int)elem->get<float>(idLoops);
 	else
 		mLoops = -1;
 }
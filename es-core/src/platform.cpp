@@ -20,21 +20,21 @@
 int runShutdownCommand()
 {
 	LOG(LogInfo) << "Paltform::runShutdownCommand()";
-	Log::flush();
+	Log::drain();
 	return system("sudo shutdown -h now");
 }
 
 int runRestartCommand()
 {
 	LOG(LogInfo) << "Paltform::runRestartCommand()";
-	Log::flush();
+	Log::drain();
 	return system("sudo shutdown -r now");
 }
 
 int runSuspendCommand()
 {
 	LOG(LogInfo) << "Paltform::runSuspendCommand()";
-	Log::flush();
+	Log::drain();
 	return system("sudo systemctl suspend");
 }
 
@@ -217,20 +217,17 @@ bool isFastShutdown()
 
 std::string queryBatteryRootPath()
 {
-	static std::string batteryRootPath;
-
-	if (batteryRootPath.empty())
+	// Searched once, even on devices without battery. The initialization is thread safe : the UI & SystemMetrics threads both call it
+	static const std::string batteryRootPath = []
 	{
 		auto files = Utils::FileSystem::getDirContent("/sys/class/power_supply");
 		for (auto file : files)
-		{
 			if (Utils::String::toLower(file).find("/bat") != std::string::npos)
-			{
-				batteryRootPath = file;
-				break;
-			}
-		}
-	}
+				return file;
+
+		return std::string();
+	}();
+
 	return batteryRootPath;
 }
 
@@ -79,6 +79,7 @@ struct BatteryInformation
 	float voltage;
 };
 
+std::string queryBatteryRootPath();
 BatteryInformation queryBatteryInformation(bool summary);
 int queryBatteryLevel();
 bool queryBatteryCharging();
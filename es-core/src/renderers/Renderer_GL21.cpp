@@ -231,6 +231,11 @@ namespace Renderer
 
 	} // drawTriangleStrips
 
+	void flush()
+	{
+		// Draw calls are immediate with this API
+	} // flush
+
 	void setProjection(const Transform4x4f& _projection)
 	{
 		glMatrixMode(GL_PROJECTION);
@@ -110,6 +110,36 @@ namespace Renderer
 		return info;
 	}
 
+	//
+	// Sprite batching : drawTriangleStrips doesn't draw immediately, it transforms the vertices with the current matrix
+	// and appends them to a batch. Strips are joined with degenerate triangles. The batch is submitted in a single
+	// draw call when the texture or blend mode changes, when the clip rect or stencil changes, and at the end of the frame.
+	//
+
+	struct Batch
+	{
+		Batch() : texture(0), srcBlendFactor(Blend::SRC_ALPHA), dstBlendFactor(Blend::ONE_MINUS_SRC_ALPHA) { }
+
+		std::vector<Vertex> vertices;
+		unsigned int        texture;
+		Blend::Factor       srcBlendFactor;
+		Blend::Factor       dstBlendFactor;
+	};
+
+	static Batch         batch;
+	static Transform4x4f currentMatrix  = Transform4x4f::Identity();
+	static unsigned int  currentTexture = 0; // texture requested by the last bindTexture call
+	static unsigned int  glTexture      = 0; // texture actually bound in the GL context
+
+	// The GL state is lost with the context, so is the batch
+	static void resetState()
+	{
+		batch          = Batch();
+		currentTexture = 0;
+		glTexture      = 0;
+
+	} // resetState
+
 	void createContext()
 	{
 		// sdlContext = SDL_GL_CreateContext(getSDLWindow());
@@ -135,6 +165,7 @@ namespace Renderer
 
 		context = go2_context_create(display, w, h, &attr);
 		go2_context_make_current(context);
+		resetState();
 
 		presenter = go2_presenter_create(display, DRM_FORMAT_RGB565, 0xff080808);
 
@@ -159,6 +190,10 @@ namespace Renderer
 	{
 		//SDL_GL_DeleteContext(sdlContext);
 		//sdlContext = nullptr;
+
+		// Nothing pending may be drawn, nor any texture considered bound, in the next context
+		resetState();
+
 		go2_context_destroy(context);
 		context = nullptr;
 
@@ -175,12 +210,74 @@ namespace Renderer
 		input = nullptr;
 	} // destroyContext
 
+	static void applyTexture(const unsigned int _texture)
+	{
+		if (_texture == glTexture)
+			return;
+
+		glBindTexture(GL_TEXTURE_2D, _texture);
+
+		if (_texture == 0) glDisable(GL_TEXTURE_2D);
+		else               glEnable(GL_TEXTURE_2D);
+
+		glTexture = _texture;
+
+	} // applyTexture
+
+	static void submitVertices(const Vertex* _vertices, const unsigned int _numVertices, const GLenum _mode, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		glEnable(GL_BLEND);
+		glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor));
+
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glEnableClientState(GL_COLOR_ARRAY);
+
+		glVertexPointer(  2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].pos);
+		glTexCoordPointer(2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].tex);
+		glColorPointer(   4, GL_UNSIGNED_BYTE, sizeof(Vertex), &_vertices[0].col);
+
+		glDrawArrays(_mode, 0, _numVertices);
+
+		glDisableClientState(GL_COLOR_ARRAY);
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+
+		glDisable(GL_BLEND);
+
+	} // submitVertices
+
+	static void transformVertices(Vertex* _vertices, const unsigned int _numVertices)
+	{
+		for (unsigned int i = 0; i < _numVertices; ++i)
+		{
+			const Vector3f pos = currentMatrix * Vector3f(_vertices[i].pos.x(), _vertices[i].pos.y(), 0.0f);
+			_vertices[i].pos = Vector2f(pos.x(), pos.y());
+		}
+
+	} // transformVertices
+
+	void flush()
+	{
+		if (batch.vertices.empty())
+			return;
+
+		applyTexture(batch.texture);
+		submitVertices(&batch.vertices[0], batch.vertices.size(), GL_TRIANGLE_STRIP, batch.srcBlendFactor, batch.dstBlendFactor);
+
+		batch.vertices.clear();
+
+	} // flush
+
 	unsigned int createTexture(const Texture::Type _type, const bool _linear, const bool _repeat, const unsigned int _width, const unsigned int _height, void* _data)
 	{
+		flush();
+
 		const GLenum type = convertTextureType(_type);
 		unsigned int texture;
 
 		glGenTextures(1, &texture);
+		applyTexture(texture);
 		bindTexture(texture);
 
 		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, _repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE);
@@ -200,13 +297,24 @@ namespace Renderer
 
 	void destroyTexture(const unsigned int _texture)
 	{
+		// The pending batch may still use it
+		if (batch.texture == _texture)
+			flush();
+
+		if (glTexture == _texture)
+			applyTexture(0);
+
 		glDeleteTextures(1, &_texture);
 
 	} // destroyTexture
 
 	void updateTexture(const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data)
 	{
-		bindTexture(_texture);
+		// The pending batch may draw the current content of the texture
+		if (batch.texture == _texture)
+			flush();
+
+		applyTexture(_texture);
 
 		if (_x == -1 && _y == -1)
 		{
@@ -222,77 +330,75 @@ namespace Renderer
 
 	void bindTexture(const unsigned int _texture)
 	{
-		glBindTexture(GL_TEXTURE_2D, _texture);
-
-		if(_texture == 0) glDisable(GL_TEXTURE_2D);
-		else              glEnable(GL_TEXTURE_2D);
+		// Only remembered : the texture is bound when the batch using it is submitted
+		currentTexture = _texture;
 
 	} // bindTexture
 
 	void drawLines(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{
-		glEnable(GL_BLEND);
-		glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor));
+		flush();
 
-		glEnableClientState(GL_VERTEX_ARRAY);
-		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-		glEnableClientState(GL_COLOR_ARRAY);
-
-		glVertexPointer(  2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].pos);
-		glTexCoordPointer(2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].tex);
-		glColorPointer(   4, GL_UNSIGNED_BYTE, sizeof(Vertex), &_vertices[0].col);
+		std::vector<Vertex> vertices(_vertices, _vertices + _numVertices);
+		transformVertices(&vertices[0], _numVertices);
 
-		glDrawArrays(GL_LINES, 0, _numVertices);
-
-		glDisableClientState(GL_COLOR_ARRAY);
-		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-		glDisableClientState(GL_VERTEX_ARRAY);
-
-		glDisable(GL_BLEND);
+		applyTexture(currentTexture);
+		submitVertices(&vertices[0], _numVertices, GL_LINES, _srcBlendFactor, _dstBlendFactor);
 
 	} // drawLines
 
 	void drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{
-		glEnable(GL_BLEND);
-		glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor));
+		if (_numVertices == 0)
+			return;
 
-		glEnableClientState(GL_VERTEX_ARRAY);
-		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-		glEnableClientState(GL_COLOR_ARRAY);
+		if (!batch.vertices.empty() && (batch.texture != currentTexture || batch.srcBlendFactor != _srcBlendFactor || batch.dstBlendFactor != _dstBlendFactor))
+			flush();
 
-		glVertexPointer(  2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].pos);
-		glTexCoordPointer(2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].tex);
-		glColorPointer(   4, GL_UNSIGNED_BYTE, sizeof(Vertex), &_vertices[0].col);
+		batch.texture = currentTexture;
+		batch.srcBlendFactor = _srcBlendFactor;
+		batch.dstBlendFactor = _dstBlendFactor;
 
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, _numVertices);
+		size_t start = batch.vertices.size();
 
-		glDisableClientState(GL_COLOR_ARRAY);
-		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-		glDisableClientState(GL_VERTEX_ARRAY);
+		if (start > 0)
+		{
+			// Degenerate triangles between the previous strip and this one
+			batch.vertices.push_back(batch.vertices[start - 1]);
+			batch.vertices.push_back(_vertices[0]);
+		}
 
-		glDisable(GL_BLEND);
+		size_t first = batch.vertices.size() - (start > 0 ? 1 : 0);
+
+		batch.vertices.insert(batch.vertices.end(), _vertices, _vertices + _numVertices);
+		transformVertices(&batch.vertices[first], batch.vertices.size() - first);
 
 	} // drawTriangleStrips
 
 	void setProjection(const Transform4x4f& _projection)
 	{
+		flush();
+
 		glMatrixMode(GL_PROJECTION);
 		glLoadMatrixf((GLfloat*)&_projection);
 
+		// The model view matrix is applied to the vertices when they are batched
+		glMatrixMode(GL_MODELVIEW);
+		glLoadIdentity();
+
 	} // setProjection
 
 	void setMatrix(const Transform4x4f& _matrix)
 	{
-		Transform4x4f matrix = _matrix;
-		matrix.round();
-		glMatrixMode(GL_MODELVIEW);
-		glLoadMatrixf((GLfloat*)&matrix);
+		currentMatrix = _matrix;
+		currentMatrix.round();
 
 	} // setMatrix
 
 	void setViewport(const Rect& _viewport)
 	{
+		flush();
+
 		// glViewport starts at the bottom left of the window
 		glViewport( _viewport.x, getWindowHeight() - _viewport.y - _viewport.h, _viewport.w, _viewport.h);
 
@@ -300,6 +406,8 @@ namespace Renderer
 
 	void setScissor(const Rect& _scissor)
 	{
+		flush();
+
 		if((_scissor.x == 0) && (_scissor.y == 0) && (_scissor.w == 0) && (_scissor.h == 0))
 		{
 			glDisable(GL_SCISSOR_TEST);
@@ -863,6 +971,8 @@ namespace Renderer
 
 	void swapBuffers()
 	{
+		flush();
+
 		if (Renderer::isFullScreenMode())
 		{
 			//LOG(LogDebug) << "Renderer_GLES10::swapBuffers() - Full Screen Mode";
@@ -916,37 +1026,20 @@ namespace Renderer
 		drawGLRoundedCorner(x + width, y + height - radius, ES_PI / 2.0f, ES_PI / 2.0f, radius, finalColor, vertex);
 		drawGLRoundedCorner(x + radius, y + height, ES_PI, ES_PI / 2.0f, radius, finalColor, vertex);
 
-		Vertex* vxs = new Vertex[vertex.size()];
-		for (int i = 0; i < vertex.size(); i++)
-			vxs[i] = vertex[i];
+		flush();
 
-		bindTexture(0);
+		transformVertices(&vertex[0], vertex.size());
 
-		glEnable(GL_BLEND);
-		glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor));
-
-		glEnableClientState(GL_VERTEX_ARRAY);
-		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-		glEnableClientState(GL_COLOR_ARRAY);
-
-		glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &vxs[0].pos);
-		glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), &vxs[0].tex);
-		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), &vxs[0].col);
-
-		glDrawArrays(GL_TRIANGLE_FAN, 0, vertex.size());
-
-		glDisableClientState(GL_COLOR_ARRAY);
-		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-		glDisableClientState(GL_VERTEX_ARRAY);
-		glDisable(GL_BLEND);
-
-		delete[] vxs;	
+		bindTexture(0);
+		applyTexture(0);
+		submitVertices(&vertex[0], vertex.size(), GL_TRIANGLE_FAN, _srcBlendFactor, _dstBlendFactor);
 	}
 
 	void enableRoundCornerStencil(float x, float y, float width, float height, float radius)
 	{
-		bool tx = glIsEnabled(GL_TEXTURE_2D);
-		glDisable(GL_TEXTURE_2D);
+		flush();
+
+		unsigned int texture = currentTexture;
 
 		glClear(GL_DEPTH_BUFFER_BIT);
 		glEnable(GL_STENCIL_TEST);
@@ -966,12 +1059,13 @@ namespace Renderer
 		glStencilFunc(GL_EQUAL, 0, 0xFF);
 		glStencilFunc(GL_EQUAL, 1, 0xFF);
 
-		if (tx)
-			glEnable(GL_TEXTURE_2D);
+		bindTexture(texture);
 	}
 
 	void disableStencil()
 	{
+		flush();
+
 		glDisable(GL_STENCIL_TEST);
 	}
 } // Renderer::
@@ -1,10 +1,22 @@
 #include "resources/Font.h"
 
 #include "renderers/Renderer.h" 
+#include "utils/BinaryFileUtil.h"
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
 #include "Log.h"
 
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+// Budgets of the text layout caches of each font, in bytes
+#define WRAP_CACHE_SIZE   (128 * 1024)
+#define LAYOUT_CACHE_SIZE (512 * 1024)
+
+#define FONT_ATLAS_MAGIC   0x4C544146 // "FATL"
+#define FONT_ATLAS_VERSION 1
+
 FT_Library Font::sLibrary = NULL;
 
 int Font::getSize() const { return mSize; }
@@ -68,7 +80,7 @@ size_t Font::getTotalMemUsage()
 	return total;
 }
 
-Font::Font(int size, const std::string& path) : mSize(size), mPath(path)
+Font::Font(int size, const std::string& path) : mSize(size), mPath(path), mWrapCache(WRAP_CACHE_SIZE), mLayoutCache(LAYOUT_CACHE_SIZE)
 {
 	mSize = size;
 	
@@ -107,7 +119,10 @@ Font::~Font()
 	for (auto it = mGlyphMap.cbegin(); it != mGlyphMap.cend(); it++)
 		delete it->second;
 
-	unload();
+	if (mLoaded)
+		unloadTextures();
+	else if (isAtlasCacheable())
+		Utils::FileSystem::removeFile(getAtlasCacheFile());
 }
 
 void Font::reload()
@@ -115,7 +130,9 @@ void Font::reload()
 	if (mLoaded)
 		return;
 
-	rebuildTextures();
+	if (!loadAtlas())
+		rebuildTextures();
+
 	mLoaded = true;
 }
 
@@ -123,6 +140,7 @@ bool Font::unload()
 {
 	if (mLoaded)
 	{
+		saveAtlas();
 		unloadTextures();
 		mLoaded = false;
 		return true;
@@ -234,6 +252,7 @@ void Font::getTextureForNewGlyph(const Vector2i& glyphSize, FontTexture*& tex_ou
 	// current textures are full,
 	// make a new one
 	mTextures.push_back(FontTexture());
+	clearLayoutCaches(); // glyphs may have moved with the vector
 	tex_out = &mTextures.back();
 	tex_out->initTexture();
 
@@ -358,9 +377,15 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 	// upload glyph bitmap to texture
 	Renderer::updateTexture(tex->textureId, Renderer::Texture::ALPHA, cursor.x(), cursor.y(), glyphSize.x(), glyphSize.y(), g->bitmap.buffer);
 
+	if (isAtlasCacheable())
+		storeGlyphPixels(tex, cursor, glyphSize, g->bitmap.buffer);
+
 	// update max glyph height
 	if (id != 61446 && glyphSize.y() > mMaxGlyphHeight)
+	{
 		mMaxGlyphHeight = glyphSize.y();
+		clearLayoutCaches();
+	}
 
 	mGlyphMap[id] = pGlyph;
 
@@ -394,7 +419,133 @@ void Font::rebuildTextures()
 		
 		// upload to texture
 		Renderer::updateTexture(tex->textureId, Renderer::Texture::ALPHA, cursor.x(), cursor.y(), glyphSize.x(), glyphSize.y(), glyphSlot->bitmap.buffer);
+
+		if (isAtlasCacheable())
+			storeGlyphPixels(tex, cursor, glyphSize, glyphSlot->bitmap.buffer);
+	}
+}
+
+bool Font::isAtlasCacheable() const
+{
+	return Utils::String::startsWith(mPath, ":/");
+}
+
+std::string Font::getAtlasCacheFile() const
+{
+	std::stringstream ss;
+	ss << Utils::FileSystem::getEsConfigPath() << "/cache/fonts/" << std::hex << std::setw(16) << std::setfill('0') << (uint64_t)std::hash<std::string>()(mPath) << std::dec << "_" << mSize << ".bin";
+	return ss.str();
+}
+
+void Font::storeGlyphPixels(FontTexture* tex, const Vector2i& cursor, const Vector2i& glyphSize, const unsigned char* buffer)
+{
+	size_t pitch = (size_t)tex->textureSize.x();
+	size_t rows = (size_t)(cursor.y() + glyphSize.y());
+	if (tex->pixels.size() < rows * pitch)
+		tex->pixels.resize(rows * pitch, 0);
+
+	for (int y = 0; y < glyphSize.y(); y++)
+		memcpy(tex->pixels.data() + (cursor.y() + y) * pitch + cursor.x(), buffer + y * glyphSize.x(), glyphSize.x());
+}
+
+// Moves the copy of the glyphs from memory to disk while the textures are unloaded
+void Font::saveAtlas()
+{
+	if (!isAtlasCacheable() || mTextures.size() == 0)
+		return;
+
+	Utils::BinaryWriter writer;
+	writer.write<uint32_t>(FONT_ATLAS_MAGIC);
+	writer.write<uint32_t>(FONT_ATLAS_VERSION);
+	writer.writeString(mPath);
+	writer.write<int32_t>(mSize);
+	writer.write<uint32_t>((uint32_t)mGlyphMap.size());
+	writer.write<uint32_t>((uint32_t)mTextures.size());
+
+	for (auto& tex : mTextures)
+	{
+		writer.write<int32_t>(tex.writePos.x());
+		writer.write<int32_t>(tex.writePos.y());
+		writer.write<uint32_t>((uint32_t)tex.pixels.size());
+		writer.writeRaw(tex.pixels.data(), tex.pixels.size());
+	}
+
+	std::string file = getAtlasCacheFile();
+	if (!writer.save(file))
+	{
+		// Keep the copy in memory then
+		Utils::FileSystem::removeFile(file);
+		return;
+	}
+
+	for (auto& tex : mTextures)
+		std::vector<unsigned char>().swap(tex.pixels);
+}
+
+// Uploads the glyphs from the saved copy, returns false if they must be rendered again
+bool Font::loadAtlas()
+{
+	if (!isAtlasCacheable() || mTextures.size() == 0)
+		return false;
+
+	std::string file = getAtlasCacheFile();
+	if (Utils::FileSystem::exists(file))
+	{
+		std::vector< std::vector<unsigned char> > pixels;
+
+		{
+			Utils::MappedFile mapped(file);
+			Utils::BinaryReader reader(mapped.data(), mapped.size());
+
+			bool valid = reader.read<uint32_t>() == FONT_ATLAS_MAGIC && reader.read<uint32_t>() == FONT_ATLAS_VERSION &&
+				reader.readString() == mPath && reader.read<int32_t>() == mSize &&
+				reader.read<uint32_t>() == mGlyphMap.size() && reader.read<uint32_t>() == mTextures.size();
+
+			for (auto it = mTextures.cbegin(); valid && it != mTextures.cend(); it++)
+			{
+				valid = reader.read<int32_t>() == it->writePos.x() && reader.read<int32_t>() == it->writePos.y();
+
+				uint32_t length = reader.read<uint32_t>();
+				const char* data = reader.readRaw(length);
+				if (!valid || data == nullptr || length > (uint32_t)(it->textureSize.x() * it->textureSize.y()))
+					valid = false;
+				else
+					pixels.push_back(std::vector<unsigned char>(data, data + length));
+			}
+
+			if (!valid)
+			{
+				LOG(LogWarning) << "Font::loadAtlas() - Invalid glyph atlas for " << mPath << ", size " << mSize;
+				pixels.clear();
+			}
+		}
+
+		Utils::FileSystem::removeFile(file);
+
+		if (pixels.size() != mTextures.size())
+			return false;
+
+		for (unsigned int i = 0; i < mTextures.size(); i++)
+			mTextures[i].pixels.swap(pixels[i]);
+	}
+
+	for (auto& tex : mTextures)
+	{
+		// Glyphs were added without a copy : the file is gone
+		if (tex.pixels.size() == 0 && tex.writePos != Vector2i::Zero())
+			return false;
 	}
+
+	for (auto& tex : mTextures)
+	{
+		tex.initTexture();
+
+		int rows = (int)(tex.pixels.size() / tex.textureSize.x());
+		if (rows > 0)
+			Renderer::updateTexture(tex.textureId, Renderer::Texture::ALPHA, 0, 0, tex.textureSize.x(), rows, tex.pixels.data());
+	}
+
+	return true;
 }
 
 void Font::renderTextCache(TextCache* cache)
@@ -570,6 +721,12 @@ std::string Font::wrapText(std::string text, float maxWidth)
 	if (maxWidth <= 0)
 		return out;
 
+	std::string key = std::string((const char*)&maxWidth, sizeof(float)) + text;
+
+	std::string* cached = mWrapCache.get(key);
+	if (cached != nullptr)
+		return *cached;
+
 	while(text.length() > 0)  // find next cut-point
 	{
 		size_t cursor = 0;
@@ -604,6 +761,8 @@ std::string Font::wrapText(std::string text, float maxWidth)
 			lineWidth = 0.0f;
 		}
 	}
+
+	mWrapCache.put(key, out, key.size() + out.size());
 	return out;
 }
 
@@ -680,11 +839,34 @@ float Font::getNewlineStartOffset(const std::string& text, const unsigned int& c
 
 TextCache* Font::buildTextCache(const std::string& text, Vector2f offset, unsigned int color, float xLen, Alignment alignment, float lineSpacing)
 {
-	float x = offset[0] + (xLen != 0 ? getNewlineStartOffset(text, 0, xLen, alignment) : 0);
+	std::string key;
+	key.reserve(text.size() + sizeof(float) * 2 + 1);
+	key.append((const char*)&xLen, sizeof(float));
+	key.append((const char*)&lineSpacing, sizeof(float));
+	key.push_back((char)alignment);
+	key.append(text);
+
+	TextLayout* cached = mLayoutCache.get(key);
+	if (cached != nullptr)
+		return createTextCache(*cached, offset, color);
+
+	TextLayout layout = buildTextLayout(text, xLen, alignment, lineSpacing);
+
+	size_t size = key.size();
+	for (auto& list : layout.vertexLists)
+		size += list.second.size() * sizeof(Renderer::Vertex);
+
+	mLayoutCache.put(key, layout, size);
+	return createTextCache(layout, offset, color);
+}
+
+Font::TextLayout Font::buildTextLayout(const std::string& text, float xLen, Alignment alignment, float lineSpacing)
+{
+	float x = (xLen != 0 ? getNewlineStartOffset(text, 0, xLen, alignment) : 0);
 	
 	float yTop = getGlyph('S')->bearing.y();
 	float yBot = getHeight(lineSpacing);
-	float y = offset[1] + (yBot + yTop)/2.0f;
+	float y = (yBot + yTop)/2.0f;
 
 	// vertices by texture
 	std::map< FontTexture*, std::vector<Renderer::Vertex> > vertMap;
@@ -702,7 +884,7 @@ TextCache* Font::buildTextCache(const std::string& text, Vector2f offset, unsign
 		if(character == '\n')
 		{
 			y += getHeight(lineSpacing);
-			x = offset[0] + (xLen != 0 ? getNewlineStartOffset(text, (const unsigned int)cursor /* cursor is already advanced */, xLen, alignment) : 0);
+			x = (xLen != 0 ? getNewlineStartOffset(text, (const unsigned int)cursor /* cursor is already advanced */, xLen, alignment) : 0);
 			continue;
 		}
 
@@ -717,16 +899,11 @@ TextCache* Font::buildTextCache(const std::string& text, Vector2f offset, unsign
 
 		const float        glyphStartX = x + glyph->bearing.x();
 		const Vector2i&    textureSize = glyph->texture->textureSize;
-		const unsigned int convertedColor = Renderer::convertColor(color);
-
-		vertices[1] = { { glyphStartX                                       , y - glyph->bearing.y()                                          }, { glyph->texPos.x(),                      glyph->texPos.y()                      }, convertedColor };
-		vertices[2] = { { glyphStartX                                       , y - glyph->bearing.y() + (glyph->texSize.y() * textureSize.y()) }, { glyph->texPos.x(),                      glyph->texPos.y() + glyph->texSize.y() }, convertedColor };
-		vertices[3] = { { glyphStartX + glyph->texSize.x() * textureSize.x(), y - glyph->bearing.y()                                          }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y()                      }, convertedColor };
-		vertices[4] = { { glyphStartX + glyph->texSize.x() * textureSize.x(), y - glyph->bearing.y() + (glyph->texSize.y() * textureSize.y()) }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y() + glyph->texSize.y() }, convertedColor };
 
-		// round vertices
-		for(int i = 1; i < 5; ++i)
-			vertices[i].pos.round();
+		vertices[1] = { { glyphStartX                                       , y - glyph->bearing.y()                                          }, { glyph->texPos.x(),                      glyph->texPos.y()                      }, 0 };
+		vertices[2] = { { glyphStartX                                       , y - glyph->bearing.y() + (glyph->texSize.y() * textureSize.y()) }, { glyph->texPos.x(),                      glyph->texPos.y() + glyph->texSize.y() }, 0 };
+		vertices[3] = { { glyphStartX + glyph->texSize.x() * textureSize.x(), y - glyph->bearing.y()                                          }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y()                      }, 0 };
+		vertices[4] = { { glyphStartX + glyph->texSize.x() * textureSize.x(), y - glyph->bearing.y() + (glyph->texSize.y() * textureSize.y()) }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y() + glyph->texSize.y() }, 0 };
 
 		// make duplicates of first and last vertex so this can be rendered as a triangle strip
 		vertices[0] = vertices[1];
@@ -736,26 +913,50 @@ TextCache* Font::buildTextCache(const std::string& text, Vector2f offset, unsign
 		x += glyph->advance.x();
 	}
 
-	//TextCache::CacheMetrics metrics = { sizeText(text, lineSpacing) };
+	TextLayout layout;
+	layout.size = sizeText(text, lineSpacing);
+
+	for (auto it = vertMap.begin(); it != vertMap.end(); it++)
+		layout.vertexLists.push_back(std::make_pair(it->first, std::move(it->second)));
+
+	clearFaceCache();
+
+	return layout;
+}
+
+TextCache* Font::createTextCache(const TextLayout& layout, const Vector2f& offset, unsigned int color)
+{
+	const unsigned int convertedColor = Renderer::convertColor(color);
 
 	TextCache* cache = new TextCache();
-	cache->vertexLists.resize(vertMap.size());
-	cache->metrics = { sizeText(text, lineSpacing) };
+	cache->vertexLists.resize(layout.vertexLists.size());
+	cache->metrics = { layout.size };
 
-	unsigned int i = 0;
-	for(auto it = vertMap.cbegin(); it != vertMap.cend(); it++)
+	for (unsigned int i = 0; i < layout.vertexLists.size(); i++)
 	{
-		TextCache::VertexList& vertList = cache->vertexLists.at(i);
+		TextCache::VertexList& vertList = cache->vertexLists[i];
 
-		vertList.textureIdPtr = &it->first->textureId;
-		vertList.verts = it->second;
-	}
+		vertList.textureIdPtr = &layout.vertexLists[i].first->textureId;
+		vertList.verts = layout.vertexLists[i].second;
 
-	clearFaceCache();
+		for (auto& vertex : vertList.verts)
+		{
+			// round vertices
+			vertex.pos += offset;
+			vertex.pos.round();
+			vertex.col = convertedColor;
+		}
+	}
 
 	return cache;
 }
 
+void Font::clearLayoutCaches()
+{
+	mWrapCache.clear();
+	mLayoutCache.clear();
+}
+
 TextCache* Font::buildTextCache(const std::string& text, float offsetX, float offsetY, unsigned int color)
 {
 	return buildTextCache(text, Vector2f(offsetX, offsetY), color, 0.0f);
@@ -772,6 +973,9 @@ void TextCache::setColor(unsigned int color)
 
 std::shared_ptr<Font> Font::getFromTheme(const ThemeData::ThemeElement* elem, unsigned int properties, const std::shared_ptr<Font>& orig)
 {
+	static const ThemeData::PropertyId idFontSize = ThemeData::getPropertyId("fontSize");
+	static const ThemeData::PropertyId idFontPath = ThemeData::getPropertyId("fontPath");
+
 	using namespace ThemeFlags;
 	if (!(properties & FONT_PATH) && !(properties & FONT_SIZE))
 		return orig;
@@ -781,15 +985,15 @@ std::shared_ptr<Font> Font::getFromTheme(const ThemeData::ThemeElement* elem, un
 	std::string path = (orig ? orig->mPath : getDefaultPath());
 
 	float sh = (float)Renderer::getScreenHeight();
-	if (properties & FONT_SIZE && elem->has("fontSize"))
+	if (properties & FONT_SIZE && elem->has(idFontSize))
 	{
-		if ((int)(sh * elem->get<float>("fontSize")) > 0)
-			size = (int)(sh * elem->get<float>("fontSize"));
+		if ((int)(sh * elem->get<float>(idFontSize)) > 0)
+			size = (int)(sh * elem->get<float>(idFontSize));
 	}
 
-	if (properties & FONT_PATH && elem->has("fontPath"))
+	if (properties & FONT_PATH && elem->has(idFontPath))
 	{
-		std::string tmppath = elem->get<std::string>("fontPath");
+		std::string tmppath = elem->get<std::string>(idFontPath);
 		if (ResourceManager::getInstance()->fileExists(tmppath))
 			path = tmppath;
 	}
@@ -9,6 +9,7 @@
 #include "ThemeData.h"
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include <list>
 #include <vector>
 
 class TextCache;
@@ -84,6 +85,9 @@ private:
 		Vector2i writePos;
 		int rowHeight;
 
+		// Copy of the glyphs uploaded so far, only kept for the default fonts (see saveAtlas)
+		std::vector<unsigned char> pixels;
+
 		FontTexture();
 		~FontTexture();
 		bool findEmpty(const Vector2i& size, Vector2i& cursor_out);
@@ -105,6 +109,14 @@ private:
 	void rebuildTextures();
 	void unloadTextures();
 
+	// The glyphs of the default fonts are stored on disk when the textures are unloaded (game launch),
+	// so they are uploaded back in one go instead of being rendered again by FreeType
+	bool isAtlasCacheable() const;
+	std::string getAtlasCacheFile() const;
+	void saveAtlas();
+	bool loadAtlas();
+	void storeGlyphPixels(FontTexture* tex, const Vector2i& cursor, const Vector2i& glyphSize, const unsigned char* buffer);
+
 	std::vector<FontTexture> mTextures;
 
 	void getTextureForNewGlyph(const Vector2i& glyphSize, FontTexture*& tex_out, Vector2i& cursor_out);
@@ -141,6 +153,78 @@ private:
 
 	float getNewlineStartOffset(const std::string& text, const unsigned int& charStart, const float& xLen, const Alignment& alignment);
 
+	// Most recently used values, up to a total size in bytes
+	template<typename T> class LayoutCache
+	{
+	public:
+		LayoutCache(size_t maxSize) : mMaxSize(maxSize), mSize(0) { }
+
+		T* get(const std::string& key)
+		{
+			auto it = mMap.find(key);
+			if (it == mMap.cend())
+				return nullptr;
+
+			mItems.splice(mItems.begin(), mItems, it->second);
+			return &it->second->value;
+		}
+
+		void put(const std::string& key, const T& value, size_t size)
+		{
+			if (size > mMaxSize || mMap.find(key) != mMap.cend())
+				return;
+
+			mItems.push_front(Item(key, value, size));
+			mMap[key] = mItems.begin();
+			mSize += size;
+
+			while (mSize > mMaxSize)
+			{
+				mSize -= mItems.back().size;
+				mMap.erase(mItems.back().key);
+				mItems.pop_back();
+			}
+		}
+
+		void clear()
+		{
+			mMap.clear();
+			mItems.clear();
+			mSize = 0;
+		}
+
+	private:
+		struct Item
+		{
+			Item(const std::string& _key, const T& _value, size_t _size) : key(_key), value(_value), size(_size) { }
+
+			std::string key;
+			T value;
+			size_t size;
+		};
+
+		size_t mMaxSize;
+		size_t mSize;
+		std::list<Item> mItems;
+		std::map<std::string, typename std::list<Item>::iterator> mMap;
+	};
+
+	// Vertices of a text at offset 0, before rounding & coloring
+	struct TextLayout
+	{
+		std::vector< std::pair<FontTexture*, std::vector<Renderer::Vertex> > > vertexLists;
+		Vector2f size;
+	};
+
+	LayoutCache<std::string> mWrapCache;
+	LayoutCache<TextLayout> mLayoutCache;
+
+	TextLayout buildTextLayout(const std::string& text, float xLen, Alignment alignment, float lineSpacing);
+	TextCache* createTextCache(const TextLayout& layout, const Vector2f& offset, unsigned int color);
+
+	// Layouts depend on the line height & point to the textures
+	void clearLayoutCaches();
+
 
 	bool mLoaded;
 
@@ -0,0 +1,262 @@
+#include "resources/TextureAtlas.h"
+
+#include "renderers/Renderer.h"
+#include "Log.h"
+#include <SDL_timer.h>
+#include <string.h>
+
+#define ATLAS_PAGE_SIZE		1024
+#define ATLAS_MAX_PAGES		8
+#define ATLAS_MAX_CELL_SIZE	512
+#define ATLAS_CELL_ALIGN	32
+#define ATLAS_MIN_IDLE_TIME	1000 // Don't recycle a cell that was drawn less than a second ago : it is probably still on screen
+
+TextureAtlas* TextureAtlas::getInstance()
+{
+	static TextureAtlas instance;
+	return &instance;
+}
+
+TextureAtlas::TextureAtlas() : mGeneration(0)
+{
+	mPages.resize(ATLAS_MAX_PAGES);
+}
+
+static int alignCellSize(int size, int maxSize)
+{
+	// Use the display size when it is known, so that all the images of a grid end in the same cell size
+	if (maxSize > size && maxSize + 2 <= ATLAS_MAX_CELL_SIZE)
+		size = maxSize;
+
+	size += 2; // 1px border on each side, so that linear filtering never samples a neighbour
+	return ((size + ATLAS_CELL_ALIGN - 1) / ATLAS_CELL_ALIGN) * ATLAS_CELL_ALIGN;
+}
+
+bool TextureAtlas::add(const unsigned char* dataRGBA, int width, int height, int maxWidth, int maxHeight, bool linear, TextureAtlasRegion& region)
+{
+	if (dataRGBA == nullptr || width <= 0 || height <= 0)
+		return false;
+
+	int cellWidth = alignCellSize(width, maxWidth);
+	int cellHeight = alignCellSize(height, maxHeight);
+	if (cellWidth > ATLAS_MAX_CELL_SIZE || cellHeight > ATLAS_MAX_CELL_SIZE)
+		return false;
+
+	std::unique_lock<std::mutex> lock(mLock);
+
+	int cellIndex = -1;
+	int pageIndex = findCell(cellWidth, cellHeight, linear, cellIndex);
+	if (pageIndex < 0)
+		return false;
+
+	Page& page = mPages[pageIndex];
+	Cell& cell = page.cells[cellIndex];
+
+	cell.used = true;
+	cell.generation = ++mGeneration;
+	cell.lastUse = SDL_GetTicks();
+	cell.width = width;
+	cell.height = height;
+
+	// Copy the image with its border pixels duplicated around it
+	int paddedWidth = width + 2;
+	int paddedHeight = height + 2;
+
+	unsigned char* padded = new unsigned char[paddedWidth * paddedHeight * 4];
+	for (int y = 0; y < paddedHeight; y++)
+	{
+		int sy = (y == 0 ? 0 : (y > height ? height - 1 : y - 1));
+
+		const unsigned char* src = dataRGBA + sy * width * 4;
+		unsigned char* dst = padded + y * paddedWidth * 4;
+
+		memcpy(dst, src, 4);
+		memcpy(dst + 4, src, width * 4);
+		memcpy(dst + (paddedWidth - 1) * 4, src + (width - 1) * 4, 4);
+	}
+
+	int x = (cellIndex % page.columns) * page.cellWidth;
+	int y = (cellIndex / page.columns) * page.cellHeight;
+	Renderer::updateTexture(page.textureId, Renderer::Texture::RGBA, x, y, paddedWidth, paddedHeight, padded);
+
+	delete[] padded;
+
+	region.page = pageIndex;
+	region.cell = cellIndex;
+	region.generation = cell.generation;
+	return true;
+}
+
+int TextureAtlas::findCell(int cellWidth, int cellHeight, bool linear, int& cell)
+{
+	unsigned int now = SDL_GetTicks();
+
+	int freePage = -1;
+	int lruPage = -1;
+	int lruCell = -1;
+	unsigned int lruTime = 0;
+
+	for (int p = 0; p < (int)mPages.size(); p++)
+	{
+		Page& page = mPages[p];
+
+		if (page.textureId == 0)
+		{
+			if (freePage < 0)
+				freePage = p;
+
+			continue;
+		}
+
+		if (page.cellWidth != cellWidth || page.cellHeight != cellHeight || page.linear != linear)
+			continue;
+
+		for (int c = 0; c < (int)page.cells.size(); c++)
+		{
+			Cell& item = page.cells[c];
+			if (!item.used)
+			{
+				cell = c;
+				return p;
+			}
+
+			if (now - item.lastUse >= ATLAS_MIN_IDLE_TIME && (lruPage < 0 || item.lastUse < lruTime))
+			{
+				lruPage = p;
+				lruCell = c;
+				lruTime = item.lastUse;
+			}
+		}
+	}
+
+	// No free cell in this size : open a new page while we can, then recycle the least recently used cell
+	if (freePage >= 0 && createPage(mPages[freePage], cellWidth, cellHeight, linear))
+	{
+		cell = 0;
+		return freePage;
+	}
+
+	if (lruPage >= 0)
+	{
+		cell = lruCell;
+		return lruPage;
+	}
+
+	return -1;
+}
+
+bool TextureAtlas::createPage(Page& page, int cellWidth, int cellHeight, bool linear)
+{
+	page.textureId = Renderer::createTexture(Renderer::Texture::RGBA, linear, false, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, nullptr);
+	if (page.textureId == 0)
+	{
+		LOG(LogError) << "TextureAtlas::createPage() - failed to create texture " << ATLAS_PAGE_SIZE << "x" << ATLAS_PAGE_SIZE;
+		return false;
+	}
+
+	page.cellWidth = cellWidth;
+	page.cellHeight = cellHeight;
+	page.columns = ATLAS_PAGE_SIZE / cellWidth;
+	page.linear = linear;
+	page.cells.clear();
+	page.cells.resize(page.columns * (ATLAS_PAGE_SIZE / cellHeight));
+
+	LOG(LogDebug) << "TextureAtlas::createPage() - New page for " << cellWidth << "x" << cellHeight << " cells (" << page.cells.size() << " cells)";
+	return true;
+}
+
+void TextureAtlas::releasePage(Page& page)
+{
+	if (page.textureId != 0)
+		Renderer::destroyTexture(page.textureId);
+
+	page.textureId = 0;
+	page.cells.clear();
+}
+
+void TextureAtlas::remove(TextureAtlasRegion& region)
+{
+	std::unique_lock<std::mutex> lock(mLock);
+
+	if (isValidLocked(region))
+	{
+		Page& page = mPages[region.page];
+		page.cells[region.cell].used = false;
+
+		// Give the memory back as soon as a page is empty
+		bool empty = true;
+		for (auto& cell : page.cells)
+		{
+			if (cell.used)
+			{
+				empty = false;
+				break;
+			}
+		}
+
+		if (empty)
+			releasePage(page);
+	}
+
+	region = TextureAtlasRegion();
+}
+
+bool TextureAtlas::isValidLocked(const TextureAtlasRegion& region)
+{
+	if (region.page < 0 || region.page >= (int)mPages.size())
+		return false;
+
+	const Page& page = mPages[region.page];
+	if (page.textureId == 0 || region.cell < 0 || region.cell >= (int)page.cells.size())
+		return false;
+
+	const Cell& cell = page.cells[region.cell];
+	return cell.used && cell.generation == region.generation;
+}
+
+bool TextureAtlas::isValid(const TextureAtlasRegion& region)
+{
+	std::unique_lock<std::mutex> lock(mLock);
+	return isValidLocked(region);
+}
+
+bool TextureAtlas::bind(const TextureAtlasRegion& region)
+{
+	std::unique_lock<std::mutex> lock(mLock);
+	if (!isValidLocked(region))
+		return false;
+
+	Page& page = mPages[region.page];
+	page.cells[region.cell].lastUse = SDL_GetTicks();
+
+	Renderer::bindTexture(page.textureId);
+	return true;
+}
+
+bool TextureAtlas::getTexCoords(const TextureAtlasRegion& region, Vector4f& coords)
+{
+	std::unique_lock<std::mutex> lock(mLock);
+	if (!isValidLocked(region))
+		return false;
+
+	const Page& page = mPages[region.page];
+	const Cell& cell = page.cells[region.cell];
+
+	float x = (float)((region.cell % page.columns) * page.cellWidth + 1);
+	float y = (float)((region.cell / page.columns) * page.cellHeight + 1);
+
+	coords = Vector4f(x / ATLAS_PAGE_SIZE, y / ATLAS_PAGE_SIZE, (x + cell.width) / ATLAS_PAGE_SIZE, (y + cell.height) / ATLAS_PAGE_SIZE);
+	return true;
+}
+
+size_t TextureAtlas::getVRAMUsage()
+{
+	std::unique_lock<std::mutex> lock(mLock);
+
+	size_t total = 0;
+	for (auto& page : mPages)
+		if (page.textureId != 0)
+			total += ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE * 4;
+
+	return total;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#ifndef ES_CORE_RESOURCES_TEXTURE_ATLAS_H
+#define ES_CORE_RESOURCES_TEXTURE_ATLAS_H
+
+#include "math/Vector4f.h"
+#include <mutex>
+#include <vector>
+
+// Handle on a region of the atlas. It becomes invalid as soon as the region is evicted.
+struct TextureAtlasRegion
+{
+	TextureAtlasRegion() : page(-1), cell(-1), generation(0) { }
+
+	inline bool empty() const { return page < 0; }
+
+	int page;
+	int cell;
+	unsigned int generation;
+};
+
+//
+// Packs small textures (grid tiles, thumbnails) into a few large textures, so that
+// a page of the grid can be drawn without binding a texture per image.
+//
+// Each atlas page is split in cells of the same size, the size being computed from the
+// MaxSizeInfo of the image : all the tiles of a grid share the same cell size.
+// When a page is full, the least recently used cell is recycled. The owner of an evicted region
+// sees its handle become invalid and reloads its texture.
+//
+class TextureAtlas
+{
+public:
+	static TextureAtlas* getInstance();
+
+	// Uploads the pixels in a free region. Returns false if the image does not fit in the atlas,
+	// in which case the caller should use a texture of its own.
+	bool add(const unsigned char* dataRGBA, int width, int height, int maxWidth, int maxHeight, bool linear, TextureAtlasRegion& region);
+	void remove(TextureAtlasRegion& region);
+
+	bool isValid(const TextureAtlasRegion& region);
+
+	// Binds the page containing the region. Returns false if the region has been evicted
+	bool bind(const TextureAtlasRegion& region);
+
+	// Texture coordinates of the region in its page : x, y = top left, z, w = bottom right
+	bool getTexCoords(const TextureAtlasRegion& region, Vector4f& coords);
+
+	size_t getVRAMUsage();
+
+private:
+	TextureAtlas();
+
+	struct Cell
+	{
+		Cell() : used(false), generation(0), lastUse(0), width(0), height(0) { }
+
+		bool used;
+		unsigned int generation;
+		unsigned int lastUse;
+		int width;
+		int height;
+	};
+
+	struct Page
+	{
+		Page() : textureId(0), cellWidth(0), cellHeight(0), columns(0), linear(false) { }
+
+		unsigned int textureId;
+		int cellWidth;
+		int cellHeight;
+		int columns;
+		bool linear;
+		std::vector<Cell> cells;
+	};
+
+	bool isValidLocked(const TextureAtlasRegion& region);
+	bool createPage(Page& page, int cellWidth, int cellHeight, bool linear);
+	void releasePage(Page& page);
+	int findCell(int cellWidth, int cellHeight, bool linear, int& cell);
+
+	std::mutex mLock;
+	std::vector<Page> mPages;
+	unsigned int mGeneration;
+};
+
+#endif // ES_CORE_RESOURCES_TEXTURE_ATLAS_H
@@ -3,6 +3,7 @@
 #include "math/Misc.h"
 #include "renderers/Renderer.h" 
 #include "resources/ResourceManager.h"
+#include "resources/ThumbnailCache.h"
 #include "ImageIO.h"
 #include "Log.h"
 #include <nanosvg/nanosvg.h>
@@ -14,10 +15,18 @@
 
 bool TextureData::OPTIMIZEVRAM = false;
 
+std::atomic<size_t> TextureData::sTotalRAMUsage(0);
+std::atomic<size_t> TextureData::sTotalVRAMUsage(0);
+
 TextureData::TextureData(bool tile, bool linear) : mTile(tile), mLinear(linear), mTextureID(0), mDataRGBA(nullptr), mScalable(false),
 									  mWidth(0), mHeight(0), mSourceWidth(0.0f), mSourceHeight(0.0f), mMaxSize(MaxSizeInfo()), mPackedSize(Vector2i(0,0)), mBaseSize(Vector2i(0, 0))
 {
 	mIsExternalDataRGBA = false;
+	mAllowAtlas = false;
+	mOwner = nullptr;
+	mLastUse = 0;
+	mRAMUsage = 0;
+	mVRAMUsage = 0;
 }
 
 TextureData::~TextureData()
@@ -114,6 +123,7 @@ bool TextureData::initSVGFromMemory(const unsigned char* fileData, size_t length
 	ImageIO::flipPixelsVert(dataRGBA, mWidth, mHeight);
 
 	mDataRGBA = dataRGBA;
+	updateMemoryUsage();
 
 	return true;
 }
@@ -152,7 +162,29 @@ bool TextureData::initImageFromMemory(const unsigned char* fileData, size_t leng
 			return true;
 	}
 	
+	Vector2i maxSize = getMaxImageSize();
+
+	unsigned char* imageRGBA = ImageIO::loadFromMemoryRGBA32Ex((const unsigned char*)(fileData), length, width, height, maxSize.x(), maxSize.y(), mMaxSize.externalZoom(), mBaseSize, mPackedSize);
+	if (imageRGBA == NULL)
+	{
+		LOG(LogError) << "TextureData::initImageFromMemory() - ERROR: Could not initialize texture from memory, invalid data!  (file path: " << mPath << ", data ptr: " << (size_t)fileData << ", reported size: " << length << ")";
+		return false;
+	}
+
+	// Keep the downscaled pixels, next time the full image won't have to be decoded
+	if (mPackedSize != Vector2i(0, 0))
+		ThumbnailCache::save(mPath, maxSize.x(), maxSize.y(), mMaxSize.externalZoom(), imageRGBA, width, height, mBaseSize);
+
+	mSourceWidth = (float) width;
+	mSourceHeight = (float) height;
+	mScalable = false;
+
+	return initFromRGBAEx(imageRGBA, width, height);
+}
 
+
+Vector2i TextureData::getMaxImageSize()
+{
 	auto x = OPTIMIZEVRAM ? mMaxSize.x() : Renderer::getScreenWidth();
 	if (x > Renderer::getScreenWidth())
 		x = Renderer::getScreenWidth();
@@ -161,13 +193,29 @@ bool TextureData::initImageFromMemory(const unsigned char* fileData, size_t leng
 	if (y > Renderer::getScreenHeight())
 		y = Renderer::getScreenHeight();
 
-	unsigned char* imageRGBA = ImageIO::loadFromMemoryRGBA32Ex((const unsigned char*)(fileData), length, width, height, x, y, mMaxSize.externalZoom(), mBaseSize, mPackedSize);
-	if (imageRGBA == NULL)
+	return Vector2i((int)x, (int)y);
+}
+
+bool TextureData::initImageFromCache(size_t& fileSize)
+{
+	// If already initialised then don't read again
 	{
-		LOG(LogError) << "TextureData::initImageFromMemory() - ERROR: Could not initialize texture from memory, invalid data!  (file path: " << mPath << ", data ptr: " << (size_t)fileData << ", reported size: " << length << ")";
-		return false;
+		std::unique_lock<std::mutex> lock(mMutex);
+		if (mDataRGBA)
+			return false;
 	}
 
+	Vector2i maxSize = getMaxImageSize();
+
+	size_t width, height;
+	Vector2i baseSize;
+
+	unsigned char* imageRGBA = ThumbnailCache::load(mPath, maxSize.x(), maxSize.y(), mMaxSize.externalZoom(), width, height, baseSize, fileSize);
+	if (imageRGBA == nullptr)
+		return false;
+
+	mBaseSize = baseSize;
+	mPackedSize = Vector2i(width, height);
 	mSourceWidth = (float) width;
 	mSourceHeight = (float) height;
 	mScalable = false;
@@ -175,7 +223,6 @@ bool TextureData::initImageFromMemory(const unsigned char* fileData, size_t leng
 	return initFromRGBAEx(imageRGBA, width, height);
 }
 
-
 void TextureData::setMaxSize(MaxSizeInfo maxSize)
 {
 	if (mSourceWidth == 0 || mSourceHeight == 0)
@@ -212,6 +259,7 @@ bool TextureData::initFromRGBA(const unsigned char* dataRGBA, size_t width, size
 	memcpy(mDataRGBA, dataRGBA, width * height * 4);
 	mWidth = width;
 	mHeight = height;
+	updateMemoryUsage();
 	return true;
 }
 
@@ -233,6 +281,7 @@ bool TextureData::initFromRGBAEx(unsigned char* dataRGBA, size_t width, size_t h
 	mDataRGBA = dataRGBA;
 	mWidth = width;
 	mHeight = height;
+	updateMemoryUsage();
 
 	return true;
 }
@@ -249,6 +298,7 @@ bool TextureData::initFromExternalRGBA(unsigned char* dataRGBA, size_t width, si
 	mDataRGBA = dataRGBA;
 	mWidth = width;
 	mHeight = height;
+	updateMemoryUsage();
 
 	if (mTextureID != 0)
 		Renderer::updateTexture(mTextureID, Renderer::Texture::RGBA, -1, -1, mWidth, mHeight, mDataRGBA);
@@ -265,18 +315,29 @@ bool TextureData::load(bool updateCache)
 	{
 		std::shared_ptr<ResourceManager>& rm = ResourceManager::getInstance();
 
-		const ResourceData& data = rm->getFileData(mPath);
+		size_t length = 0;
+
 		// is it an SVG?
 		if (mPath.substr(mPath.size() - 4, std::string::npos) == ".svg")
 		{
+			const ResourceData& data = rm->getFileData(mPath);
+			length = data.length;
+
 			mScalable = true; // ??? interest ?
 			retval = initSVGFromMemory((const unsigned char*)data.ptr.get(), data.length);
 		}
+		else if (initImageFromCache(length))
+			retval = true;
 		else
+		{
+			const ResourceData& data = rm->getFileData(mPath);
+			length = data.length;
+
 			retval = initImageFromMemory((const unsigned char*)data.ptr.get(), data.length);
+		}
 
 		if (updateCache && retval)
-			ImageIO::updateImageCache(mPath, data.length, mBaseSize.x(), mBaseSize.y());
+			ImageIO::updateImageCache(mPath, length, mBaseSize.x(), mBaseSize.y());
 	}
 
 	return retval;
@@ -288,13 +349,35 @@ bool TextureData::isLoaded()
 	if (mDataRGBA || (mTextureID != 0))
 		return true;
 
+	if (!mAtlasRegion.empty() && TextureAtlas::getInstance()->isValid(mAtlasRegion))
+		return true;
+
 	return false;
 }
 
+bool TextureData::getAtlasTexCoords(Vector4f& coords)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	if (mAtlasRegion.empty())
+		return false;
+
+	return TextureAtlas::getInstance()->getTexCoords(mAtlasRegion, coords);
+}
+
 bool TextureData::uploadAndBind()
 {
 	// See if it's already been uploaded
 	std::unique_lock<std::mutex> lock(mMutex);
+
+	if (!mAtlasRegion.empty())
+	{
+		if (TextureAtlas::getInstance()->bind(mAtlasRegion))
+			return true;
+
+		// The region was recycled : the pixels are gone, the texture has to be loaded again
+		mAtlasRegion = TextureAtlasRegion();
+	}
+
 	if (mTextureID != 0)
 	{
 		Renderer::bindTexture(mTextureID);
@@ -310,6 +393,15 @@ bool TextureData::uploadAndBind()
 		if ((mWidth == 0) || (mHeight == 0) || (mDataRGBA == nullptr))
 			return false;
 
+		if (mAllowAtlas && !mTile && !mIsExternalDataRGBA && TextureAtlas::getInstance()->add(mDataRGBA, mWidth, mHeight, (int)mMaxSize.x(), (int)mMaxSize.y(), mLinear, mAtlasRegion))
+		{
+			delete[] mDataRGBA;
+			mDataRGBA = nullptr;
+			updateMemoryUsage();
+
+			return TextureAtlas::getInstance()->bind(mAtlasRegion);
+		}
+
 		mTextureID = Renderer::createTexture(Renderer::Texture::RGBA, mLinear, mTile, mWidth, mHeight, mDataRGBA);
 		if (mTextureID)
 		{
@@ -318,6 +410,8 @@ bool TextureData::uploadAndBind()
 
 			mDataRGBA = nullptr;
 		}
+
+		updateMemoryUsage();
 	}
 
 	return true;
@@ -326,11 +420,17 @@ bool TextureData::uploadAndBind()
 void TextureData::releaseVRAM()
 {
 	std::unique_lock<std::mutex> lock(mMutex);
+
+	if (!mAtlasRegion.empty())
+		TextureAtlas::getInstance()->remove(mAtlasRegion);
+
 	if (mTextureID != 0)
 	{
 		Renderer::destroyTexture(mTextureID);
 		mTextureID = 0;
 	}
+
+	updateMemoryUsage();
 }
 
 void TextureData::releaseRAM()
@@ -341,6 +441,7 @@ void TextureData::releaseRAM()
 		delete[] mDataRGBA;
 
 	mDataRGBA = 0;
+	updateMemoryUsage();
 }
 
 size_t TextureData::width()
@@ -395,6 +496,38 @@ void TextureData::setSourceSize(float width, float height)
 	}
 }
 
+void TextureData::updateMemoryUsage()
+{
+	size_t size = mWidth * mHeight * 4;
+
+	size_t ram = mDataRGBA != nullptr && !mIsExternalDataRGBA ? size : 0;
+	size_t vram = mTextureID != 0 ? size : 0;
+
+	if (ram != mRAMUsage)
+	{
+		sTotalRAMUsage += ram;
+		sTotalRAMUsage -= mRAMUsage;
+		mRAMUsage = ram;
+	}
+
+	if (vram != mVRAMUsage)
+	{
+		sTotalVRAMUsage += vram;
+		sTotalVRAMUsage -= mVRAMUsage;
+		mVRAMUsage = vram;
+	}
+}
+
+size_t TextureData::getTotalRAMUsage()
+{
+	return sTotalRAMUsage;
+}
+
+size_t TextureData::getTotalVRAMUsage()
+{
+	return sTotalVRAMUsage;
+}
+
 size_t TextureData::getVRAMUsage()
 {
 	if ((mTextureID != 0) || (mDataRGBA != nullptr))
@@ -2,12 +2,14 @@
 #ifndef ES_CORE_RESOURCES_TEXTURE_DATA_H
 #define ES_CORE_RESOURCES_TEXTURE_DATA_H
 
+#include <atomic>
 #include <mutex>
 #include <string>
 
 #include "math/Vector2f.h"
 #include "math/Vector2i.h"
 #include "resources/TextureResource.h"
+#include "resources/TextureAtlas.h"
 
 // class TextureResource;
 
@@ -25,6 +27,8 @@ public:
 	void initFromPath(const std::string& path);
 	bool initSVGFromMemory(const unsigned char* fileData, size_t length);
 	bool initImageFromMemory(const unsigned char* fileData, size_t length);
+	// Loads the downscaled pixels kept by the ThumbnailCache, if they are still valid
+	bool initImageFromCache(size_t& fileSize);
 	bool initFromRGBA(const unsigned char* dataRGBA, size_t width, size_t height);
 	bool initFromRGBAEx(unsigned char* dataRGBA, size_t width, size_t height);
 	bool initFromExternalRGBA(unsigned char* dataRGBA, size_t width, size_t height);
@@ -45,10 +49,20 @@ public:
 	void releaseRAM();
 
 	void setMaxSize(MaxSizeInfo maxSize);
+	// Size the image is downscaled to fit when loaded
+	Vector2i getMaxImageSize();
+
+	// Small textures are packed in the shared TextureAtlas instead of getting a texture of their own
+	void setAllowAtlas(bool value) { mAllowAtlas = value; }
+	bool getAtlasTexCoords(Vector4f& coords);
 
 	// Get the amount of VRAM currenty used by this texture
 	size_t getVRAMUsage();
 
+	// Running totals of the pixel buffers in RAM / of the textures in VRAM, over every TextureData alive
+	static size_t getTotalRAMUsage();
+	static size_t getTotalVRAMUsage();
+
 	size_t width();
 	size_t height();
 	float sourceWidth();
@@ -61,6 +75,14 @@ public:
 
 	bool isRequiredTextureSizeOk();
 
+	// TextureResource this data is managed for by the TextureDataManager. Only accessed under the manager lock
+	const TextureResource* getOwner() { return mOwner; }
+	void setOwner(const TextureResource* owner) { mOwner = owner; }
+
+	// Last time (SDL ticks) the manager was asked for this texture. Only accessed under the manager lock
+	unsigned int getLastUse() { return mLastUse; }
+	void setLastUse(unsigned int time) { mLastUse = time; }
+
 	std::string		mPath;
 	unsigned int	mTextureID;
 
@@ -69,6 +91,9 @@ public:
 	}
 
 private:
+	// Reports the changes of mDataRGBA / mTextureID to the running totals. Called with mMutex held
+	void updateMemoryUsage();
+
 	std::mutex		mMutex;
 	bool			mTile;
 	bool			mLinear;
@@ -85,6 +110,18 @@ private:
 	MaxSizeInfo		mMaxSize;
 
 	bool			mIsExternalDataRGBA;
+
+	bool				mAllowAtlas;
+	TextureAtlasRegion	mAtlasRegion;
+
+	const TextureResource* mOwner;
+	unsigned int		mLastUse;
+
+	size_t				mRAMUsage;
+	size_t				mVRAMUsage;
+
+	static std::atomic<size_t> sTotalRAMUsage;
+	static std::atomic<size_t> sTotalVRAMUsage;
 };
 
 #endif // ES_CORE_RESOURCES_TEXTURE_DATA_H
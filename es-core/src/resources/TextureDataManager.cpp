@@ -5,8 +5,13 @@
 #include "Settings.h"
 #include "utils/StringUtil.h"
 #include "utils/FileSystemUtil.h"
+#include "utils/ProfilingUtil.h"
+#include "Log.h"
 #include <SDL_timer.h>
 
+// Textures requested within this delay (ms) are considered on screen and are evicted last
+#define TEXTURE_VISIBLE_DELAY 500
+
 TextureDataManager::TextureDataManager()
 {
 	unsigned char data[5 * 5 * 4];
@@ -20,6 +25,9 @@ TextureDataManager::TextureDataManager()
 	}
 	mBlank->initFromRGBA(data, 5, 5);
 	
+	mEvictedCount = 0;
+	mEvictedSize = 0;
+
 	mLoader = new TextureLoader(this);
 }
 
@@ -32,15 +40,24 @@ void TextureDataManager::onTextureLoaded(std::shared_ptr<TextureData> tex)
 {
 	std::unique_lock<std::mutex> lock(mMutex);
 
-	for (auto it = mTextureLookup.cbegin(); it != mTextureLookup.cend(); it++)
+	// The UI thread reads the size of the TextureResource at any time : don't write it from the loader
+	if (tex->getOwner() != nullptr)
+		mLoadedTextures.push_back(tex);
+}
+
+void TextureDataManager::processLoadedTextures()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	// The owner is cleared under this lock before the TextureResource is destroyed
+	for (auto& tex : mLoadedTextures)
 	{
-		std::shared_ptr<TextureData> texture = *(*it).second;		
-		if (texture == tex)
-		{
-			const TextureResource* pResource = it->first;
+		const TextureResource* pResource = tex->getOwner();
+		if (pResource != nullptr)
 			((TextureResource*)pResource)->onTextureLoaded(tex);
-		}
 	}
+
+	mLoadedTextures.clear();
 }
 
 
@@ -52,6 +69,7 @@ std::shared_ptr<TextureData> TextureDataManager::add(const TextureResource* key,
 	auto it = mTextureLookup.find(key);
 	if (it != mTextureLookup.cend())
 	{
+		(*(*it).second)->setOwner(nullptr);
 		// Remove the list entry
 		mTextures.erase((*it).second);
 		// And the lookup
@@ -59,6 +77,8 @@ std::shared_ptr<TextureData> TextureDataManager::add(const TextureResource* key,
 	}
 
 	std::shared_ptr<TextureData> data = std::make_shared<TextureData>(tiled, linear);
+	data->setOwner(key);
+	data->setLastUse(SDL_GetTicks());
 	mTextures.push_front(data);
 	mTextureLookup[key] = mTextures.cbegin();
 
@@ -73,6 +93,10 @@ void TextureDataManager::remove(const TextureResource* key)
 	auto it = mTextureLookup.find(key);
 	if (it != mTextureLookup.cend())
 	{
+		// Don't keep it in the loader queue, nobody will display it
+		mLoader->remove(*(*it).second);
+		// It may still be loading : the loader must not notify the resource being destroyed
+		(*(*it).second)->setOwner(nullptr);
 		// Remove the list entry
 		mTextures.erase((*it).second);
 		// And the lookup
@@ -89,6 +113,15 @@ void TextureDataManager::cancelAsync(const TextureResource* key)
 		mLoader->remove(*(*it).second);
 }
 
+void TextureDataManager::setLoadingPriority(const TextureResource* key, TextureLoader::Priority priority)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	auto it = mTextureLookup.find(key);
+	if (it != mTextureLookup.cend())
+		mLoader->prioritize(*(*it).second, priority);
+}
+
 std::shared_ptr<TextureData> TextureDataManager::get(const TextureResource* key, bool enableLoading)
 {
 	std::unique_lock<std::mutex> lock(mMutex);
@@ -100,6 +133,7 @@ std::shared_ptr<TextureData> TextureDataManager::get(const TextureResource* key,
 	if (it != mTextureLookup.cend())
 	{
 		tex = *(*it).second;
+		tex->setLastUse(SDL_GetTicks());
 
 		if (mTextures.cbegin() != (*it).second)
 		{
@@ -159,17 +193,7 @@ size_t TextureDataManager::getQueueSize()
 	return mLoader->getQueueSize();
 }
 
-bool compareTextures(const std::shared_ptr<TextureData>& first, const std::shared_ptr<TextureData>& second)
-{	
-	bool isResource = first->mPath.rfind(":/") == 0;
-	bool secondIsResource = second->mPath.rfind(":/") == 0;
-	if (isResource && !secondIsResource)
-		return true;
-
-	return false;
-}
-
-void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block)
+void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block, TextureLoader::Priority priority)
 {
 	// See if it's already loaded
 	if (tex->isLoaded())
@@ -185,51 +209,13 @@ void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block)
 	}
 
 	// Not loaded. Make sure there is room
-	size_t size = TextureResource::getTotalMemUsage();
 	size_t max_texture = (size_t)Settings::getInstance()->getInt("MaxVRAM") * 1024 * 1024;
-
-	if (size >= max_texture)
-	{
-		std::unique_lock<std::mutex> lock(mMutex);
-
-		std::list<std::shared_ptr<TextureData>> orderedTextures(mTextures);
-		orderedTextures.sort(compareTextures);
-
-		for (auto it = orderedTextures.crbegin(); it != orderedTextures.crend(); ++it)
-		{
-			if (size < max_texture)
-				break;
-
-			if ((*it) == tex)
-				continue;
-
-			bool changed = false;
-
-			if ((*it)->isLoaded())
-			{
-				(*it)->releaseVRAM();
-				(*it)->releaseRAM();
-
-				changed = true;
-			}
-
-			// It may be already in the loader queue. In this case it wouldn't have been using
-			// any VRAM yet but it will be. Remove it from the loader queue
-			if (mLoader->remove(*it))
-				changed = true;
-
-			if (changed)
-			{
-				lock.unlock();
-				size = TextureResource::getTotalMemUsage();
-				lock.lock();
-			}
-		}
-	}
+	if (TextureResource::getTotalMemUsage() >= max_texture)
+		evict(tex, max_texture);
 
 	if (!block)
 	{
-		mLoader->load(tex);
+		mLoader->load(tex, priority);
 	}
 	else
 	{				
@@ -238,7 +224,7 @@ void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block)
 	}
 }
 
-TextureLoader::TextureLoader(TextureDataManager* mgr) : mExit(false)
+TextureLoader::TextureLoader(TextureDataManager* mgr) : mExit(false), mQueuedSize(0)
 {
 	mManager = mgr;
 
@@ -265,42 +251,73 @@ TextureLoader::~TextureLoader()
 
 void TextureLoader::threadProc()
 {
+	ProfileThreadName("TextureLoader");
+
 	while (true)
 	{
 		// Wait for an event to say there is something in the queue
 		std::unique_lock<std::mutex> lock(mLoaderLock);
-		mEvent.wait(lock, [this]() { return mExit || !mTextureDataQ.empty(); });
+		mEvent.wait(lock, [this]() { return mExit || !mTextureDataLookup.empty(); });
 
 		if (mExit)
 			break;
 
-		if (!mTextureDataQ.empty())
+		// Highest priority first
+		int priority = 0;
+		while (priority < PRIORITY_COUNT && mTextureDataQ[priority].empty())
+			priority++;
+
+		if (priority == PRIORITY_COUNT)
+			continue;
+
+		std::shared_ptr<TextureData> textureData = mTextureDataQ[priority].front();
+		mTextureDataQ[priority].pop_front();
+
+		auto entry = mTextureDataLookup.find(textureData.get());
+		if (entry != mTextureDataLookup.cend())
 		{
-			std::shared_ptr<TextureData> textureData = mTextureDataQ.front();
-			mTextureDataQ.pop_front();
+			unsigned int latency = SDL_GetTicks() - entry->second.queuedTime;
 
-			mProcessingTextureDataQ.push_back(textureData);
+			mStats.count[priority]++;
+			mStats.totalLatency[priority] += latency;
+			if (latency > mStats.maxLatency[priority])
+				mStats.maxLatency[priority] = latency;
 
-			lock.unlock();
+			mQueuedSize -= entry->second.size;
+			mTextureDataLookup.erase(entry);
+		}
 
-			if (textureData && !textureData->isLoaded())
-			{
-				std::this_thread::yield();
+		// The queue holds the last reference : the TextureResource is gone, don't waste time decoding it
+		if (textureData.use_count() == 1)
+		{
+			mStats.dropped++;
+			continue;
+		}
 
-				textureData->load(true);
-				// mManager->onTextureLoaded(textureData);
+		mProcessingTextureDataQ.push_back(textureData);
 
-				lock.lock();
-				mProcessingTextureDataQ.remove(textureData);
-				lock.unlock();
-			}
+		lock.unlock();
 
+		if (textureData && !textureData->isLoaded())
+		{
 			std::this_thread::yield();
+
+			ProfileScope("TextureLoader::load");
+
+			if (textureData->load(true))
+				mManager->onTextureLoaded(textureData);
 		}
+
+		lock.lock();
+		mProcessingTextureDataQ.remove(textureData);
+		mStats.loaded++;
+		lock.unlock();
+
+		std::this_thread::yield();
 	}
 }
 
-void TextureLoader::load(std::shared_ptr<TextureData> textureData)
+void TextureLoader::load(std::shared_ptr<TextureData> textureData, Priority priority)
 {
 	std::unique_lock<std::mutex> lock(mLoaderLock);
 
@@ -312,29 +329,73 @@ void TextureLoader::load(std::shared_ptr<TextureData> textureData)
 	if (std::find(mProcessingTextureDataQ.cbegin(), mProcessingTextureDataQ.cend(), textureData) != mProcessingTextureDataQ.cend())
 		return;
 
-	// Remove it from the queue if it is already there
-	auto tx = std::find(mTextureDataQ.cbegin(), mTextureDataQ.cend(), textureData);
-	if (tx != mTextureDataQ.cend())
-		mTextureDataQ.erase(tx);
+	unsigned int queuedTime = SDL_GetTicks();
+	size_t size = textureData->width() * textureData->height() * 4;
+
+	// Already queued : it keeps the best of both priorities and moves to the top of the queue (latency is still counted from the first request)
+	auto it = mTextureDataLookup.find(textureData.get());
+	if (it != mTextureDataLookup.cend())
+	{
+		if (it->second.priority < priority)
+			priority = it->second.priority;
+
+		queuedTime = it->second.queuedTime;
+		size = it->second.size;
+
+		if (it->second.priority == priority && it->second.position == mTextureDataQ[priority].begin())
+			return;
+
+		mTextureDataQ[it->second.priority].erase(it->second.position);
+		mQueuedSize -= size;
+	}
 
 	// Put it on the start of the queue as we want the newly requested textures to load first
-	mTextureDataQ.push_front(textureData);
+	mTextureDataQ[priority].push_front(textureData);
+
+	QueueEntry& entry = mTextureDataLookup[textureData.get()];
+	entry.priority = priority;
+	entry.position = mTextureDataQ[priority].begin();
+	entry.queuedTime = queuedTime;
+	entry.size = size;
+	mQueuedSize += size;
+
 	mEvent.notify_one();
 }
 
-bool TextureLoader::remove(std::shared_ptr<TextureData> textureData)
+bool TextureLoader::prioritize(std::shared_ptr<TextureData> textureData, Priority priority)
 {
-	// Just remove it from the queue so we don't attempt to load it
 	std::unique_lock<std::mutex> lock(mLoaderLock);
 
-	auto tx = std::find(mTextureDataQ.cbegin(), mTextureDataQ.cend(), textureData);
-	if (tx != mTextureDataQ.cend())
+	auto it = mTextureDataLookup.find(textureData.get());
+	if (it == mTextureDataLookup.cend())
+		return false;
+
+	if (it->second.priority != priority)
 	{
-		mTextureDataQ.erase(tx);
-		return true;
+		mTextureDataQ[it->second.priority].erase(it->second.position);
+		mTextureDataQ[priority].push_front(textureData);
+
+		it->second.priority = priority;
+		it->second.position = mTextureDataQ[priority].begin();
 	}
 
-	return false;
+	return true;
+}
+
+bool TextureLoader::remove(std::shared_ptr<TextureData> textureData)
+{
+	// Just remove it from the queue so we don't attempt to load it
+	std::unique_lock<std::mutex> lock(mLoaderLock);
+
+	auto it = mTextureDataLookup.find(textureData.get());
+	if (it == mTextureDataLookup.cend())
+		return false;
+
+	mTextureDataQ[it->second.priority].erase(it->second.position);
+	mQueuedSize -= it->second.size;
+	mTextureDataLookup.erase(it);
+	mStats.cancelled++;
+	return true;
 }
 
 size_t TextureLoader::getQueueSize()
@@ -343,11 +404,24 @@ size_t TextureLoader::getQueueSize()
 
 	// Gets the amount of video memory that will be used once all textures in
 	// the queue are loaded
-	size_t mem = 0;
-	for (auto tex : mTextureDataQ)	
-		mem += tex->width() * tex->height() * 4;
+	return mQueuedSize;
+}
 
-	return mem;
+size_t TextureLoader::getQueueCount()
+{
+	std::unique_lock<std::mutex> lock(mLoaderLock);
+	return mTextureDataLookup.size();
+}
+
+TextureLoader::Stats TextureLoader::getStats(bool reset)
+{
+	std::unique_lock<std::mutex> lock(mLoaderLock);
+
+	Stats ret = mStats;
+	if (reset)
+		mStats = Stats();
+
+	return ret;
 }
 
 void TextureLoader::clearQueue()
@@ -355,11 +429,103 @@ void TextureLoader::clearQueue()
 	std::unique_lock<std::mutex> lock(mLoaderLock);
 
 	// Just abort any waiting texture
-	mTextureDataQ.clear();
+	mStats.cancelled += (unsigned int)mTextureDataLookup.size();
+
+	for (int i = 0; i < PRIORITY_COUNT; i++)
+		mTextureDataQ[i].clear();
+
+	mTextureDataLookup.clear();
+	mQueuedSize = 0;
+}
+
+void TextureDataManager::evict(std::shared_ptr<TextureData> tex, size_t max_texture)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	unsigned int startTime = SDL_GetTicks();
+	size_t startSize = TextureResource::getTotalMemUsage();
+	size_t size = startSize;
+	int evicted = 0;
+
+	// mTextures goes from the most recently used texture to the least recently used one.
+	// First pass only takes off-screen textures that are not resources, second pass off-screen resources,
+	// and the last one anything but the texture being loaded
+	for (int pass = 0; pass < 3 && size >= max_texture; pass++)
+	{
+		for (auto it = mTextures.crbegin(); it != mTextures.crend() && size >= max_texture; ++it)
+		{
+			const std::shared_ptr<TextureData>& data = *it;
+			if (data == tex)
+				continue;
+
+			if (pass < 2)
+			{
+				// Everything after that has been used more recently
+				if (startTime - data->getLastUse() < TEXTURE_VISIBLE_DELAY)
+					break;
+
+				bool isResource = data->mPath.rfind(":/") == 0;
+				if (isResource != (pass == 1))
+					continue;
+			}
+
+			bool changed = false;
+
+			if (data->isLoaded())
+			{
+				data->releaseVRAM();
+				data->releaseRAM();
+
+				changed = true;
+			}
+
+			// It may be already in the loader queue. In this case it wouldn't have been using
+			// any VRAM yet but it will be. Remove it from the loader queue
+			if (mLoader->remove(data))
+				changed = true;
+
+			if (changed)
+			{
+				evicted++;
+				size = TextureResource::getTotalMemUsage();
+			}
+		}
+	}
+
+	size_t freed = startSize > size ? startSize - size : 0;
+
+	mEvictedCount += evicted;
+	mEvictedSize += freed;
+
+	LOG(LogDebug) << "TextureDataManager::evict() - Evicted " << evicted << " textures (" << freed / 1024 << " KB) in " << SDL_GetTicks() - startTime << "ms, " <<
+		"usage " << size / 1024 << " / " << max_texture / 1024 << " KB (RAM " << TextureData::getTotalRAMUsage() / 1024 << " KB, VRAM " << TextureData::getTotalVRAMUsage() / 1024 << " KB, queue " << getQueueSize() / 1024 << " KB)";
+}
+
+void TextureDataManager::getEvictionStats(unsigned int& count, size_t& size, bool reset)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	count = mEvictedCount;
+	size = mEvictedSize;
+
+	if (reset)
+	{
+		mEvictedCount = 0;
+		mEvictedSize = 0;
+	}
 }
 
 void TextureDataManager::clearQueue()
 {
 	if (mLoader != nullptr)
 		mLoader->clearQueue();
-}
\ No newline at end of file
+}
+TextureLoader::Stats TextureDataManager::getLoaderStats(bool reset)
+{
+	return mLoader->getStats(reset);
+}
+
+size_t TextureDataManager::getLoaderQueueCount()
+{
+	return mLoader->getQueueCount();
+}
@@ -18,28 +18,80 @@ class TextureDataManager;
 class TextureLoader
 {
 public:
+	// Requests are served by priority, then most recent first
+	enum Priority
+	{
+		PRIORITY_VISIBLE = 0,	// Rendered this frame
+		PRIORITY_NEXT_PAGE = 1,	// Will be visible after a scroll (extra rows of grids, neighbour items)
+		PRIORITY_PREFETCH = 2,	// Requested ahead, nobody is displaying it yet
+
+		PRIORITY_COUNT = 3
+	};
+
+	struct Stats
+	{
+		Stats() : loaded(0), cancelled(0), dropped(0)
+		{
+			for (int i = 0; i < PRIORITY_COUNT; i++)
+			{
+				count[i] = 0;
+				totalLatency[i] = 0;
+				maxLatency[i] = 0;
+			}
+		}
+
+		unsigned int averageLatency(int priority) const { return count[priority] == 0 ? 0 : totalLatency[priority] / count[priority]; }
+
+		unsigned int loaded;	// Textures loaded from the queue
+		unsigned int cancelled;	// Requests removed before being processed
+		unsigned int dropped;	// Requests discarded because nobody owns the texture anymore
+
+		// Time spent in the queue (ms), by priority at the time the texture was picked
+		unsigned int count[PRIORITY_COUNT];
+		unsigned int totalLatency[PRIORITY_COUNT];
+		unsigned int maxLatency[PRIORITY_COUNT];
+	};
+
 	TextureLoader(TextureDataManager* mgr);
 	~TextureLoader();
 
-	void load(std::shared_ptr<TextureData> textureData);
+	// Queues the texture. If it is already queued, it moves to the top and is promoted if priority is higher
+	void load(std::shared_ptr<TextureData> textureData, Priority priority = PRIORITY_VISIBLE);
+	// Changes the priority of a queued texture, even if it means demoting it. Returns false if it is not queued
+	bool prioritize(std::shared_ptr<TextureData> textureData, Priority priority);
 	bool remove(std::shared_ptr<TextureData> textureData);
 	void clearQueue();
 
 	size_t getQueueSize();
+	size_t getQueueCount();
+
+	// Gets the counters since the last reset
+	Stats getStats(bool reset = false);
 
 private:	
+	struct QueueEntry
+	{
+		Priority												priority;
+		std::list<std::shared_ptr<TextureData>>::iterator		position;
+		unsigned int											queuedTime;
+		size_t													size;
+	};
+
 	void threadProc();
 
 	std::list<std::shared_ptr<TextureData>> 										mProcessingTextureDataQ;
 
-	std::list<std::shared_ptr<TextureData>> 										mTextureDataQ;
-	std::map<TextureData*, std::list<std::shared_ptr<TextureData> >::const_iterator > 	mTextureDataLookup;
+	std::list<std::shared_ptr<TextureData>> 										mTextureDataQ[PRIORITY_COUNT];
+	std::map<TextureData*, QueueEntry>			 									mTextureDataLookup;
 
 	std::vector<std::thread>	mThreads;	
 	std::mutex					mLoaderLock;
 	std::condition_variable		mEvent;
 	bool 						mExit;
 
+	Stats						mStats;
+	size_t						mQueuedSize;
+
 	TextureDataManager*			mManager;
 };
 
@@ -70,6 +122,8 @@ public:
 	// will be deleted when the other thread has finished with it
 	void remove(const TextureResource* key);
 	void cancelAsync(const TextureResource* key);
+	// Changes the loading priority of a texture waiting in the loader queue
+	void setLoadingPriority(const TextureResource* key, TextureLoader::Priority priority);
 
 	std::shared_ptr<TextureData> get(const TextureResource* key, bool enableLoading = true);
 	bool bind(const TextureResource* key);
@@ -82,19 +136,34 @@ public:
 	// be committed to VRAM as the queue is processed
 	size_t  getQueueSize();
 	// Load a texture, freeing resources as necessary to make space
-	void load(std::shared_ptr<TextureData> tex, bool block = false);
+	void load(std::shared_ptr<TextureData> tex, bool block = false, TextureLoader::Priority priority = TextureLoader::PRIORITY_VISIBLE);
 
 	void clearQueue();
 
+	// Number of textures evicted to respect the VRAM budget, and the memory it freed, since the last reset
+	void getEvictionStats(unsigned int& count, size_t& size, bool reset = false);
+
+	TextureLoader::Stats getLoaderStats(bool reset = false);
+	size_t getLoaderQueueCount();
+
+	// Called by the loader threads. The owner is only updated by processLoadedTextures, on the UI thread
 	void onTextureLoaded(std::shared_ptr<TextureData> tex);
+	void processLoadedTextures();
 
 private:
+	// Frees the least recently used textures until the total memory usage is below max_texture
+	void evict(std::shared_ptr<TextureData> tex, size_t max_texture);
+
 	std::mutex					mMutex;
 
+	unsigned int				mEvictedCount;
+	size_t						mEvictedSize;
+
 	std::list<std::shared_ptr<TextureData> >												mTextures;
 	std::map<const TextureResource*, std::list<std::shared_ptr<TextureData> >::const_iterator > 	mTextureLookup;
 	std::shared_ptr<TextureData>															mBlank;
 	TextureLoader*																			mLoader;
+	std::vector<std::shared_ptr<TextureData> >												mLoadedTextures;
 };
 
 #endif // ES_CORE_RESOURCES_TEXTURE_DATA_MANAGER_H
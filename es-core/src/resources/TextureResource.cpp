@@ -2,6 +2,7 @@
 
 #include "utils/FileSystemUtil.h"
 #include "resources/TextureData.h"
+#include "resources/TextureAtlas.h"
 #include "ImageIO.h"
 #include "utils/AsyncUtil.h"
 #include <cstring>
@@ -12,7 +13,7 @@ TextureDataManager		TextureResource::sTextureDataManager;
 std::map< TextureResource::TextureKeyType, std::weak_ptr<TextureResource>> TextureResource::sTextureMap;
 std::set<TextureResource*> 	TextureResource::sAllTextures;
 
-TextureResource::TextureResource(const std::string& path, bool tile, bool linear, bool dynamic, bool allowAsync, MaxSizeInfo maxSize) : mTextureData(nullptr), mForceLoad(false)
+TextureResource::TextureResource(const std::string& path, bool tile, bool linear, bool dynamic, bool allowAsync, MaxSizeInfo maxSize, bool allowAtlas) : mTextureData(nullptr), mForceLoad(false)
 {
 #if _DEBUG
 	mPath = path;
@@ -28,6 +29,7 @@ TextureResource::TextureResource(const std::string& path, bool tile, bool linear
 		{
 			data = sTextureDataManager.add(this, tile, linear);
 			data->setMaxSize(maxSize);
+			data->setAllowAtlas(allowAtlas && !tile);
 			data->initFromPath(path);
 
 			bool async = false;
@@ -45,7 +47,8 @@ TextureResource::TextureResource(const std::string& path, bool tile, bool linear
 			}
 		
 			// Force the texture manager to load it using a blocking load
-			sTextureDataManager.load(data, !async); // 
+			// Async ones are only prefetched : they are promoted as soon as they are rendered
+			sTextureDataManager.load(data, !async, TextureLoader::PRIORITY_PREFETCH);
 
 			if (async)
 			{
@@ -169,6 +172,15 @@ bool TextureResource::bind()
 	}
 }
 
+bool TextureResource::getAtlasTexCoords(Vector4f& coords) const
+{
+	if (mTextureData != nullptr)
+		return false;
+
+	std::shared_ptr<TextureData> data = sTextureDataManager.get(this, false);
+	return data != nullptr && data->getAtlasTexCoords(coords);
+}
+
 void TextureResource::resetCache()
 {
 	sTextureDataManager.clearQueue();
@@ -180,7 +192,33 @@ void TextureResource::cancelAsync(std::shared_ptr<TextureResource> texture)
 		sTextureDataManager.cancelAsync(texture.get());
 }
 
-std::shared_ptr<TextureResource> TextureResource::get(const std::string& path, bool tile, bool linear, bool forceLoad, bool dynamic, bool asReloadable, MaxSizeInfo maxSize)
+void TextureResource::setLoadingPriority(std::shared_ptr<TextureResource> texture, TextureLoader::Priority priority)
+{
+	if (texture != nullptr && texture->mTextureData == nullptr)
+		sTextureDataManager.setLoadingPriority(texture.get(), priority);
+}
+
+void TextureResource::getEvictionStats(unsigned int& count, size_t& size, bool reset)
+{
+	sTextureDataManager.getEvictionStats(count, size, reset);
+}
+
+TextureLoader::Stats TextureResource::getLoaderStats(bool reset)
+{
+	return sTextureDataManager.getLoaderStats(reset);
+}
+
+size_t TextureResource::getLoaderQueueCount()
+{
+	return sTextureDataManager.getLoaderQueueCount();
+}
+
+void TextureResource::processLoadedTextures()
+{
+	sTextureDataManager.processLoadedTextures();
+}
+
+std::shared_ptr<TextureResource> TextureResource::get(const std::string& path, bool tile, bool linear, bool forceLoad, bool dynamic, bool asReloadable, MaxSizeInfo maxSize, bool allowAtlas)
 {
 	std::shared_ptr<ResourceManager>& rm = ResourceManager::getInstance();
 
@@ -196,7 +234,8 @@ std::shared_ptr<TextureResource> TextureResource::get(const std::string& path, b
 	if (canonicalPath.length() > 0 && canonicalPath[0] == ':')
 		dynamic = false;
 
-	TextureKeyType key(canonicalPath, tile, linear);
+	// Atlas textures get their own entry : only the components aware of the atlas may draw them
+	TextureKeyType key(canonicalPath, tile, linear, allowAtlas && dynamic);
 	auto foundTexture = sTextureMap.find(key);
 	if(foundTexture != sTextureMap.cend())
 	{
@@ -229,7 +268,7 @@ std::shared_ptr<TextureResource> TextureResource::get(const std::string& path, b
 	// need to create it
 	std::shared_ptr<TextureResource> tex;
 	
-	tex = std::shared_ptr<TextureResource>(new TextureResource(std::get<0>(key), tile, linear, dynamic, !forceLoad, maxSize));
+	tex = std::shared_ptr<TextureResource>(new TextureResource(std::get<0>(key), tile, linear, dynamic, !forceLoad, maxSize, std::get<3>(key)));
 	std::shared_ptr<TextureData> data = sTextureDataManager.get(tex.get(), !forceLoad);
 		
 	if (asReloadable) // // is it an SVG // if (key.first.substr(key.first.size() - 4, std::string::npos) != ".svg") // FCATMP	
@@ -291,15 +330,10 @@ bool TextureResource::isLoaded() const
 
 size_t TextureResource::getTotalMemUsage()
 {
-	size_t total = 0;
-	// Count up all textures that manage their own texture data
-	for (auto tex : sAllTextures)
-	{
-		if (tex->mTextureData != nullptr)
-			total += tex->mTextureData->getVRAMUsage();
-	}
-	// Now get the committed memory from the manager
-	total += sTextureDataManager.getCommittedSize();
+	// Running totals of all textures, managed or not
+	size_t total = TextureData::getTotalRAMUsage() + TextureData::getTotalVRAMUsage();
+	// The atlas pages, whatever the number of regions in use
+	total += TextureAtlas::getInstance()->getVRAMUsage();
 	// And the size of the loading queue
 	total += sTextureDataManager.getQueueSize();
 	return total;
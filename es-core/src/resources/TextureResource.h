@@ -4,6 +4,7 @@
 
 #include "math/Vector2i.h"
 #include "math/Vector2f.h"
+#include "math/Vector4f.h"
 #include "resources/ResourceManager.h"
 #include "resources/TextureDataManager.h"
 #include <set>
@@ -48,11 +49,13 @@ private:
 class TextureResource : public IReloadable
 {
 protected:
-	TextureResource(const std::string& path, bool tile, bool linear, bool dynamic, bool allowAsync, MaxSizeInfo maxSize);
+	TextureResource(const std::string& path, bool tile, bool linear, bool dynamic, bool allowAsync, MaxSizeInfo maxSize, bool allowAtlas = false);
 
 public:
-	static std::shared_ptr<TextureResource> get(const std::string& path, bool tile = false, bool linear = false, bool forceLoad = false, bool dynamic = true, bool asReloadable = true, MaxSizeInfo maxSize = MaxSizeInfo());
+	static std::shared_ptr<TextureResource> get(const std::string& path, bool tile = false, bool linear = false, bool forceLoad = false, bool dynamic = true, bool asReloadable = true, MaxSizeInfo maxSize = MaxSizeInfo(), bool allowAtlas = false);
 	static void cancelAsync(std::shared_ptr<TextureResource> texture);
+	// Moves a texture waiting to be loaded asynchronously to another priority (rendering it promotes it to PRIORITY_VISIBLE)
+	static void setLoadingPriority(std::shared_ptr<TextureResource> texture, TextureLoader::Priority priority);
 
 	void initFromPixels(const unsigned char* dataRGBA, size_t width, size_t height);
 	void initFromExternalPixels(unsigned char* dataRGBA, size_t width, size_t height);
@@ -70,10 +73,20 @@ public:
 	const Vector2i getSize() const;
 	bool bind();
 
+	// If the texture lives in the TextureAtlas, gets the texture coordinates of its region (x, y = top left, z, w = bottom right)
+	bool getAtlasTexCoords(Vector4f& coords) const;
+
 	static size_t getTotalMemUsage(); // returns an approximation of total VRAM used by textures (in bytes)
 	static size_t getTotalTextureSize(); // returns the number of bytes that would be used if all textures were in memory
 	static void resetCache();
 
+	static void getEvictionStats(unsigned int& count, size_t& size, bool reset = false);
+	static TextureLoader::Stats getLoaderStats(bool reset = false);
+	static size_t getLoaderQueueCount();
+
+	// Applies the size of the textures decoded by the loader threads. Called on the UI thread, once per frame
+	static void processLoadedTextures();
+
 public:
 	virtual bool unload();
 	virtual void reload();
@@ -92,7 +105,7 @@ private:
 	Vector2f					mSourceSize;
 	bool							mForceLoad;
 
-	typedef std::tuple<std::string, bool, bool> TextureKeyType;
+	typedef std::tuple<std::string, bool, bool, bool> TextureKeyType; // path, tile, linear, atlas
 	static std::map< TextureKeyType, std::weak_ptr<TextureResource> > sTextureMap; // map of textures, used to prevent duplicate textures
 	static std::map< TextureKeyType, std::shared_ptr<TextureResource> > sPermanentTextureMap; // map of textures, used to prevent duplicate textures // FCAWEAK
 	static std::set<TextureResource*> 	sAllTextures;	// Set of all textures, used for memory management
@@ -0,0 +1,279 @@
+#include "resources/ThumbnailCache.h"
+
+#include "utils/BinaryFileUtil.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "Log.h"
+#include "Settings.h"
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define THUMBNAIL_CACHE_MAGIC   0x42485445 // "ETHB"
+#define THUMBNAIL_CACHE_VERSION 1
+
+// A used thumbnail is touched at most once in this delay (s), not to write to the disk on every load
+#define THUMBNAIL_TOUCH_DELAY 3600
+
+// Pruning goes below the limit, so that the next thumbnails don't prune again right away (percents)
+#define THUMBNAIL_PRUNE_TARGET 90
+
+static IntSetting sThumbnailCacheMaxSize("ThumbnailCacheMaxSize");
+
+// Size of the cache folder, computed by the first save. Guarded by sCacheSizeLock
+static std::mutex sCacheSizeLock;
+static int64_t sCacheSize = -1;
+
+namespace
+{
+	struct CacheFileInfo
+	{
+		std::string path;
+		int64_t size;
+		time_t mtime;
+	};
+
+	std::vector<CacheFileInfo> getCacheFiles(const std::string& cachePath)
+	{
+		std::vector<CacheFileInfo> files;
+
+		for (auto file : Utils::FileSystem::getDirContent(cachePath))
+		{
+			// Not the temporary files being written
+			if (!Utils::String::endsWith(file, ".bin"))
+				continue;
+
+			struct stat64 info;
+			if (stat64(file.c_str(), &info) != 0 || !S_ISREG(info.st_mode))
+				continue;
+
+			CacheFileInfo item;
+			item.path = file;
+			item.size = (int64_t)info.st_size;
+			item.mtime = info.st_mtime;
+			files.push_back(item);
+		}
+
+		return files;
+	}
+
+	bool getFileKey(const std::string& path, int64_t& mtime, int64_t& size)
+	{
+		struct stat64 info;
+		if (stat64(path.c_str(), &info) != 0)
+			return false;
+
+		mtime = (int64_t)info.st_mtime;
+		size = (int64_t)info.st_size;
+		return true;
+	}
+}
+
+std::string ThumbnailCache::getCachePath()
+{
+	return Utils::FileSystem::getEsConfigPath() + "/cache/thumbnails";
+}
+
+std::string ThumbnailCache::getCacheFile(const std::string& path, int maxWidth, int maxHeight, bool externZoom)
+{
+	// The path is stored in the file as well : a collision is detected when loading
+	std::stringstream ss;
+	ss << getCachePath() << "/" << std::hex << std::setw(16) << std::setfill('0') << (uint64_t)std::hash<std::string>()(path) << std::dec
+		<< "_" << maxWidth << "x" << maxHeight << (externZoom ? "z" : "") << ".bin";
+
+	return ss.str();
+}
+
+bool ThumbnailCache::isCacheable(const std::string& path)
+{
+	return !path.empty() && path[0] != ':' && Settings::getInstance()->getBool("ThumbnailCache");
+}
+
+bool ThumbnailCache::readHeader(Utils::BinaryReader& reader, const std::string& path, int64_t& fileSize)
+{
+	if (reader.read<uint32_t>() != THUMBNAIL_CACHE_MAGIC || reader.read<uint32_t>() != THUMBNAIL_CACHE_VERSION)
+		return false;
+
+	if (reader.readString() != path)
+		return false;
+
+	int64_t mtime = reader.read<int64_t>();
+	int64_t size = reader.read<int64_t>();
+
+	int64_t fileMtime;
+	if (!getFileKey(path, fileMtime, fileSize) || mtime != fileMtime || size != fileSize)
+	{
+		LOG(LogDebug) << "ThumbnailCache::readHeader() - Source changed for \"" << path << "\"";
+		return false;
+	}
+
+	return reader.isValid();
+}
+
+bool ThumbnailCache::exists(const std::string& path, int maxWidth, int maxHeight, bool externZoom)
+{
+	if (!isCacheable(path) || maxWidth <= 0 || maxHeight <= 0)
+		return false;
+
+	Utils::MappedFile mapped(getCacheFile(path, maxWidth, maxHeight, externZoom));
+	if (mapped.data() == nullptr)
+		return false;
+
+	Utils::BinaryReader reader(mapped.data(), mapped.size());
+
+	int64_t size;
+	return readHeader(reader, path, size);
+}
+
+unsigned char* ThumbnailCache::load(const std::string& path, int maxWidth, int maxHeight, bool externZoom, size_t& width, size_t& height, Vector2i& baseSize, size_t& fileSize)
+{
+	if (!isCacheable(path) || maxWidth <= 0 || maxHeight <= 0)
+		return nullptr;
+
+	std::string cacheFile = getCacheFile(path, maxWidth, maxHeight, externZoom);
+
+	Utils::MappedFile mapped(cacheFile);
+	if (mapped.data() == nullptr)
+		return nullptr;
+
+	Utils::BinaryReader reader(mapped.data(), mapped.size());
+
+	int64_t size;
+	if (!readHeader(reader, path, size))
+		return nullptr;
+
+	touch(cacheFile);
+
+	int baseWidth = reader.read<int32_t>();
+	int baseHeight = reader.read<int32_t>();
+	uint32_t w = reader.read<uint32_t>();
+	uint32_t h = reader.read<uint32_t>();
+	uint32_t length = reader.read<uint32_t>();
+
+	if (!reader.isValid() || w == 0 || h == 0 || length != w * h * 4)
+		return nullptr;
+
+	const char* pixels = reader.readRaw(length);
+	if (pixels == nullptr)
+	{
+		LOG(LogError) << "ThumbnailCache::load() - Thumbnail of \"" << path << "\" is truncated";
+		return nullptr;
+	}
+
+	unsigned char* data = new unsigned char[length];
+	memcpy(data, pixels, length);
+
+	width = w;
+	height = h;
+	baseSize = Vector2i(baseWidth, baseHeight);
+	fileSize = (size_t)size;
+	return data;
+}
+
+bool ThumbnailCache::save(const std::string& path, int maxWidth, int maxHeight, bool externZoom, const unsigned char* data, size_t width, size_t height, const Vector2i& baseSize)
+{
+	if (!isCacheable(path) || data == nullptr || maxWidth <= 0 || maxHeight <= 0)
+		return false;
+
+	int64_t mtime, size;
+	if (!getFileKey(path, mtime, size))
+		return false;
+
+	uint32_t length = (uint32_t)(width * height * 4);
+
+	Utils::BinaryWriter writer;
+	writer.write<uint32_t>(THUMBNAIL_CACHE_MAGIC);
+	writer.write<uint32_t>(THUMBNAIL_CACHE_VERSION);
+	writer.writeString(path);
+	writer.write<int64_t>(mtime);
+	writer.write<int64_t>(size);
+	writer.write<int32_t>(baseSize.x());
+	writer.write<int32_t>(baseSize.y());
+	writer.write<uint32_t>((uint32_t)width);
+	writer.write<uint32_t>((uint32_t)height);
+	writer.write<uint32_t>(length);
+
+	writer.writeRaw(data, length);
+
+	std::string cacheFile = getCacheFile(path, maxWidth, maxHeight, externZoom);
+
+	// Replacing a thumbnail only adds the difference
+	struct stat64 info;
+	int64_t previousSize = stat64(cacheFile.c_str(), &info) == 0 ? (int64_t)info.st_size : 0;
+
+	if (!writer.save(cacheFile))
+		return false;
+
+	onFileSaved((int64_t)writer.data().size() - previousSize);
+	return true;
+}
+
+void ThumbnailCache::touch(const std::string& cacheFile)
+{
+	struct stat64 info;
+	if (stat64(cacheFile.c_str(), &info) != 0 || time(nullptr) - info.st_mtime < THUMBNAIL_TOUCH_DELAY)
+		return;
+
+	utimensat(AT_FDCWD, cacheFile.c_str(), nullptr, 0);
+}
+
+void ThumbnailCache::onFileSaved(int64_t sizeDelta)
+{
+	std::unique_lock<std::mutex> lock(sCacheSizeLock);
+
+	int64_t maxSize = (int64_t)sThumbnailCacheMaxSize * 1024 * 1024;
+
+	if (sCacheSize < 0)
+	{
+		sCacheSize = 0;
+		for (auto& file : getCacheFiles(getCachePath()))
+			sCacheSize += file.size;
+	}
+	else
+		sCacheSize += sizeDelta;
+
+	if (maxSize <= 0 || sCacheSize <= maxSize)
+		return;
+
+	// Least recently used first
+	std::vector<CacheFileInfo> files = getCacheFiles(getCachePath());
+	std::sort(files.begin(), files.end(), [](const CacheFileInfo& a, const CacheFileInfo& b) { return a.mtime < b.mtime; });
+
+	int64_t total = 0;
+	for (auto& file : files)
+		total += file.size;
+
+	int64_t target = maxSize * THUMBNAIL_PRUNE_TARGET / 100;
+	int removed = 0;
+
+	for (auto& file : files)
+	{
+		if (total <= target)
+			break;
+
+		if (Utils::FileSystem::removeFile(file.path))
+		{
+			total -= file.size;
+			removed++;
+		}
+	}
+
+	sCacheSize = total;
+
+	LOG(LogInfo) << "ThumbnailCache::onFileSaved() - Cache over " << sThumbnailCacheMaxSize << "MB, " << removed << " thumbnails removed";
+}
+
+void ThumbnailCache::clear()
+{
+	std::unique_lock<std::mutex> lock(sCacheSizeLock);
+
+	Utils::FileSystem::deleteDirectoryFiles(getCachePath());
+	sCacheSize = 0;
+}
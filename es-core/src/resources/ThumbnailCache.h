@@ -0,0 +1,43 @@
+#pragma once
+#ifndef ES_CORE_RESOURCES_THUMBNAIL_CACHE_H
+#define ES_CORE_RESOURCES_THUMBNAIL_CACHE_H
+
+#include "math/Vector2i.h"
+#include <stdint.h>
+#include <string>
+
+namespace Utils { class BinaryReader; }
+
+// Pixels of the images that had to be downscaled when loaded, stored as RGBA in the ES config folder.
+// A thumbnail is keyed by the source path and the size it was scaled to fit, and is only used while the
+// size & modification time of the source file are unchanged : loading it skips the decoding of the full image and the rescale.
+// The folder is kept under ThumbnailCacheMaxSize : the least recently used thumbnails are deleted first.
+class ThumbnailCache
+{
+public:
+	// Returns a buffer allocated with new[], or nullptr if there is no valid thumbnail
+	static unsigned char* load(const std::string& path, int maxWidth, int maxHeight, bool externZoom, size_t& width, size_t& height, Vector2i& baseSize, size_t& fileSize);
+
+	// Tells if there is a valid thumbnail, without reading the pixels
+	static bool exists(const std::string& path, int maxWidth, int maxHeight, bool externZoom);
+
+	static bool save(const std::string& path, int maxWidth, int maxHeight, bool externZoom, const unsigned char* data, size_t width, size_t height, const Vector2i& baseSize);
+
+	// Only files from the filesystem are cached, not the ones embedded in ES resources
+	static bool isCacheable(const std::string& path);
+
+	static void clear();
+
+private:
+	static bool readHeader(Utils::BinaryReader& reader, const std::string& path, int64_t& fileSize);
+
+	// Marks a thumbnail as used, by its modification time
+	static void touch(const std::string& cacheFile);
+	// Accounts a written file, and deletes the oldest ones past the limit
+	static void onFileSaved(int64_t sizeDelta);
+
+	static std::string getCachePath();
+	static std::string getCacheFile(const std::string& path, int maxWidth, int maxHeight, bool externZoom);
+};
+
+#endif // ES_CORE_RESOURCES_THUMBNAIL_CACHE_H
@@ -0,0 +1,84 @@
+#include "utils/BinaryFileUtil.h"
+
+#include "utils/FileSystemUtil.h"
+#include "Log.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Utils
+{
+	bool BinaryWriter::save(const std::string& path) const
+	{
+		std::string directory = Utils::FileSystem::getParent(path);
+		if (!Utils::FileSystem::exists(directory))
+			Utils::FileSystem::createDirectory(directory);
+
+		// Unique name : several threads may save the same file at once
+		std::string tmpFile = path + ".XXXXXX";
+
+		int fd = mkstemp(&tmpFile[0]);
+		if (fd < 0)
+		{
+			LOG(LogError) << "BinaryWriter::save() - Unable to create \"" << tmpFile << "\"";
+			return false;
+		}
+
+		fchmod(fd, 0644);
+
+		bool failed = false;
+		for (size_t written = 0; written < mBuffer.size() && !failed; )
+		{
+			ssize_t count = ::write(fd, mBuffer.c_str() + written, mBuffer.size() - written);
+			if (count > 0)
+				written += (size_t)count;
+			else if (count < 0 && errno != EINTR)
+				failed = true;
+		}
+
+		if (close(fd) != 0)
+			failed = true;
+
+		if (failed || std::rename(tmpFile.c_str(), path.c_str()) != 0)
+		{
+			LOG(LogError) << "BinaryWriter::save() - Unable to write \"" << path << "\"";
+			Utils::FileSystem::removeFile(tmpFile);
+			return false;
+		}
+
+		return true;
+	}
+
+	MappedFile::MappedFile(const std::string& path) : mData(nullptr), mSize(0)
+	{
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return;
+
+		struct stat64 info;
+		if (fstat64(fd, &info) == 0 && info.st_size > 0)
+		{
+			void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED)
+			{
+				mData = (const char*)data;
+				mSize = (size_t)info.st_size;
+			}
+		}
+
+		close(fd);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (mData != nullptr)
+			munmap((void*)mData, mSize);
+	}
+
+} // Utils::
@@ -0,0 +1,110 @@
+#pragma once
+#ifndef ES_CORE_UTILS_BINARY_FILE_UTIL_H
+#define ES_CORE_UTILS_BINARY_FILE_UTIL_H
+
+#include <string>
+#include <string.h>
+#include <stdint.h>
+
+// Helpers for the small binary caches kept in the ES config folder.
+// Values are stored in native byte order : caches are never shared between machines.
+namespace Utils
+{
+	class BinaryWriter
+	{
+	public:
+		template<typename T> void write(T value) { mBuffer.append((const char*)&value, sizeof(T)); }
+
+		void writeString(const std::string& value)
+		{
+			write<uint32_t>((uint32_t)value.size());
+			mBuffer.append(value);
+		}
+
+		void writeRaw(const void* data, size_t size) { mBuffer.append((const char*)data, size); }
+
+		inline const std::string& data() const { return mBuffer; }
+
+		// Writes to a temporary file first, so a crash never leaves a partial file behind
+		bool save(const std::string& path) const;
+
+	private:
+		std::string mBuffer;
+	};
+
+	class BinaryReader
+	{
+	public:
+		BinaryReader(const char* data, size_t size) : mCursor(data), mEnd(data + size), mValid(data != nullptr) { }
+
+		template<typename T> T read()
+		{
+			T value = T();
+			if (!mValid || (size_t)(mEnd - mCursor) < sizeof(T))
+			{
+				mValid = false;
+				return value;
+			}
+
+			memcpy(&value, mCursor, sizeof(T));
+			mCursor += sizeof(T);
+			return value;
+		}
+
+		std::string readString()
+		{
+			uint32_t length = read<uint32_t>();
+			if (!mValid || (size_t)(mEnd - mCursor) < length)
+			{
+				mValid = false;
+				return std::string();
+			}
+
+			std::string value(mCursor, length);
+			mCursor += length;
+			return value;
+		}
+
+		// Points to the next size bytes, without copying them
+		const char* readRaw(size_t size)
+		{
+			if (!mValid || (size_t)(mEnd - mCursor) < size)
+			{
+				mValid = false;
+				return nullptr;
+			}
+
+			const char* value = mCursor;
+			mCursor += size;
+			return value;
+		}
+
+		inline bool isValid() const { return mValid; }
+
+	private:
+		const char* mCursor;
+		const char* mEnd;
+		bool mValid;
+	};
+
+	// Read-only memory mapping of a whole file
+	class MappedFile
+	{
+	public:
+		MappedFile(const std::string& path);
+		~MappedFile();
+
+		inline const char* data() const { return mData; }
+		inline size_t size() const { return mSize; }
+
+	private:
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		const char* mData;
+		size_t mSize;
+	};
+
+} // Utils::
+
+#endif // ES_CORE_UTILS_BINARY_FILE_UTIL_H
@@ -14,6 +14,9 @@
 #include <dirent.h>
 #include <unistd.h>
 #include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <stdint.h>
 
 #include <fstream>
 #include <sstream>
@@ -79,6 +82,9 @@ namespace Utils
 			return "/usr/share/emulationstation"; // batocera
 		}
 		
+		// Sharded by path hash, so that the loading threads don't all wait on the same lock
+		#define FILE_CACHE_SHARDS 32
+
 		struct FileCache
 		{
 			FileCache() {}
@@ -135,8 +141,6 @@ namespace Utils
 			{
 				int ret = stat64(key.c_str(), info);
 
-				mFileCacheMutex.lock();
-
 				FileCache cache(ret == 0, false);
 				if (cache.exists)
 				{
@@ -150,10 +154,7 @@ namespace Utils
 					}
 				}
 
-				mFileCache[key] = cache;
-
-				mFileCacheMutex.unlock();
-
+				add(key, cache);
 				return ret;
 			}
 
@@ -162,51 +163,155 @@ namespace Utils
 				if (!mEnabled)
 					return;
 
-				mFileCacheMutex.lock();
-				mFileCache[key] = cache;
-				mFileCacheMutex.unlock();
+				size_t hash = std::hash<std::string>()(key);
+				Shard& shard = mShards[hash % FILE_CACHE_SHARDS];
+
+				std::unique_lock<std::mutex> lock(shard.lock, std::defer_lock);
+				lockShard(lock);
+				shard.files[key] = cache;
 			}
 
-			static FileCache* get(const std::string& key)
+			// Tells the cache that every file of the folder is known : missing files don't need a stat anymore
+			static void addDirectory(const std::string& path)
 			{
 				if (!mEnabled)
-					return nullptr;
+					return;
+
+				uint64_t hash = hashPath(path.c_str(), path.size());
+				Shard& shard = mShards[hash % FILE_CACHE_SHARDS];
+
+				std::unique_lock<std::mutex> lock(shard.lock, std::defer_lock);
+				lockShard(lock);
+				shard.directories[hash] = path;
+			}
 
-				std::unique_lock<std::mutex> lock(mFileCacheMutex);
+			static bool get(const std::string& key, FileCache& result)
+			{
+				if (!mEnabled)
+					return false;
 
-				auto it = mFileCache.find(key);
-				if (it != mFileCache.cend())
-					return &it->second;
+				size_t hash = std::hash<std::string>()(key);
+				Shard& shard = mShards[hash % FILE_CACHE_SHARDS];
 
-				it = mFileCache.find(Utils::FileSystem::getParent(key)+"/*");
-				if (it != mFileCache.cend())
 				{
-					mFileCache[key] = FileCache(false, false);
-					return &mFileCache[key];
-				}				
+					std::unique_lock<std::mutex> lock(shard.lock, std::defer_lock);
+					lockShard(lock);
+
+					auto it = shard.files.find(key);
+					if (it != shard.files.cend())
+					{
+						mHits++;
+						result = it->second;
+						return true;
+					}
+				}
 
-				return nullptr;
+				if (!isParentEnumerated(key))
+				{
+					mMisses++;
+					return false;
+				}
+
+				// The parent folder was listed, and the file was not part of it
+				mHits++;
+				result = FileCache(false, false);
+				add(key, result);
+				return true;
 			}
 
 			static void resetCache()
 			{
-				mFileCacheMutex.lock();
-				mFileCache.clear();
-				mFileCacheMutex.unlock();
+				for (int i = 0; i < FILE_CACHE_SHARDS; i++)
+				{
+					std::unique_lock<std::mutex> lock(mShards[i].lock);
+					mShards[i].files.clear();
+					mShards[i].directories.clear();
+				}
+			}
+
+			static void dumpStats()
+			{
+				size_t hits = mHits.exchange(0);
+				size_t misses = mMisses.exchange(0);
+				size_t contended = mContended.exchange(0);
+
+				if (hits + misses > 0)
+					LOG(LogDebug) << "FileCache - " << hits << " hits, " << misses << " misses (" << (hits * 100 / (hits + misses)) << "% hit rate), " << contended << " contended locks";
 			}
 
 			static void setEnabled(bool value) { mEnabled = value; }
 			static inline bool isEnabled() { return mEnabled; }
 
 		private:
-			static std::map<std::string, FileCache> mFileCache;
-			static std::mutex mFileCacheMutex;
-			static bool mEnabled;
+			struct Shard
+			{
+				std::mutex lock;
+				std::unordered_map<std::string, FileCache> files;
+				std::unordered_map<uint64_t, std::string> directories; // Listed folders, by path hash
+			};
+
+			static inline void lockShard(std::unique_lock<std::mutex>& lock)
+			{
+				if (!lock.try_lock())
+				{
+					mContended++;
+					lock.lock();
+				}
+			}
+
+			// FNV-1a, so that the parent folder can be hashed without copying it out of the file path
+			static inline uint64_t hashPath(const char* path, size_t length)
+			{
+				uint64_t hash = 14695981039346656037ULL;
+				for (size_t i = 0; i < length; i++)
+				{
+					hash ^= (unsigned char)path[i];
+					hash *= 1099511628211ULL;
+				}
+
+				return hash;
+			}
+
+			static bool isParentEnumerated(const std::string& key)
+			{
+				size_t offset = key.find_last_of('/');
+
+				// Not a generic path, take the slow way
+				if (offset == std::string::npos || offset == key.size() - 1 || key.find('\\') != std::string::npos || key.find("//") != std::string::npos)
+				{
+					std::string parent = Utils::FileSystem::getParent(key);
+					return isDirectoryEnumerated(parent.c_str(), parent.size());
+				}
+
+				return isDirectoryEnumerated(key.c_str(), offset);
+			}
+
+			static bool isDirectoryEnumerated(const char* path, size_t length)
+			{
+				uint64_t hash = hashPath(path, length);
+				Shard& shard = mShards[hash % FILE_CACHE_SHARDS];
+
+				std::unique_lock<std::mutex> lock(shard.lock, std::defer_lock);
+				lockShard(lock);
+
+				auto it = shard.directories.find(hash);
+				return it != shard.directories.cend() && it->second.size() == length && memcmp(it->second.c_str(), path, length) == 0;
+			}
+
+			static Shard mShards[FILE_CACHE_SHARDS];
+			static std::atomic<bool> mEnabled;
+
+			// Statistics
+			static std::atomic<size_t> mHits;
+			static std::atomic<size_t> mMisses;
+			static std::atomic<size_t> mContended;
 		};
 
-		std::map<std::string, FileCache> FileCache::mFileCache;
-		std::mutex FileCache::mFileCacheMutex;
-		bool FileCache::mEnabled = false;
+		FileCache::Shard FileCache::mShards[FILE_CACHE_SHARDS];
+		std::atomic<bool> FileCache::mEnabled(false);
+		std::atomic<size_t> FileCache::mHits(0);
+		std::atomic<size_t> FileCache::mMisses(0);
+		std::atomic<size_t> FileCache::mContended(0);
 
 		int FileSystemCacheActivator::mReferenceCount = 0;
 
@@ -227,6 +332,7 @@ namespace Utils
 
 			if (mReferenceCount <= 0)
 			{
+				FileCache::dumpStats();
 				FileCache::setEnabled(false);
 				FileCache::resetCache();
 			}
@@ -241,7 +347,7 @@ namespace Utils
 			if (isDirectory(path))
 			{
 				// tell filecache we enumerated the folder
-				FileCache::add(path + "/*", FileCache(true, true));
+				FileCache::addDirectory(path);
 
 				DIR* dir = opendir(path.c_str());
 
@@ -262,6 +368,7 @@ namespace Utils
 							FileInfo fi;
 							fi.path = fullName;
 							fi.hidden = Utils::FileSystem::isHidden(fullName);
+							fi.symlink = (entry->d_type == 10); // DT_LNK
 
 							if (entry->d_type == 10) // DT_LNK
 							{
@@ -290,6 +397,26 @@ namespace Utils
 			return contentList;
 
 		} // getDirContent
+
+		void cacheDirInfo(const std::string& _path, const fileList& _content)
+		{
+			if (!FileCache::isEnabled())
+				return;
+
+			std::string path = getGenericPath(_path);
+
+			// tell filecache we enumerated the folder
+			FileCache::addDirectory(path);
+
+			for (auto fi : _content)
+			{
+				FileCache cache(true, fi.directory);
+				cache.hidden = fi.hidden;
+				cache.isSymLink = fi.symlink;
+				FileCache::add(fi.path, cache);
+			}
+
+		} // cacheDirInfo
 		
 		stringList getDirContent(const std::string& _path, const bool _recursive, const bool includeHidden)
 		{
@@ -299,7 +426,7 @@ namespace Utils
 			// only parse the directory, if it's a directory
 			if(isDirectory(path))
 			{
-				FileCache::add(path + "/*", FileCache(true, true));
+				FileCache::addDirectory(path);
 
 
 				DIR* dir = opendir(path.c_str());
@@ -350,7 +477,7 @@ namespace Utils
 			fileList  contentList;
 
 			// tell filecache we enumerated the folder
-			FileCache::add(path + "/*", FileCache(true, true));
+			FileCache::addDirectory(path);
 
 			// only parse the directory, if it's a directory
 			// if (isDirectory(path))
@@ -374,6 +501,7 @@ namespace Utils
 							FileInfo fi;
 							fi.path = fullName;
 							fi.hidden = Utils::FileSystem::isHidden(fullName);
+							fi.symlink = (entry->d_type == 10); // DT_LNK
 
 							if (entry->d_type == 10) // DT_LNK
 							{
@@ -874,9 +1002,9 @@ namespace Utils
 			if (_path.empty())
 				return false;
 
-			auto it = FileCache::get(_path);
-			if (it != nullptr)
-				return it->exists;
+			FileCache cache;
+			if (FileCache::get(_path, cache))
+				return cache.exists;
 
 			std::string path = getGenericPath(_path);
 			struct stat64 info;
@@ -936,9 +1064,9 @@ namespace Utils
 
 		bool isRegularFile(const std::string& _path)
 		{
-			auto it = FileCache::get(_path);
-			if (it != nullptr)
-				return it->exists && !it->directory && !it->isSymLink;
+			FileCache cache;
+			if (FileCache::get(_path, cache))
+				return cache.exists && !cache.directory && !cache.isSymLink;
 
 			std::string path = getGenericPath(_path);
 			struct stat64 info;
@@ -957,9 +1085,9 @@ namespace Utils
 			if (_path.empty())
 				return false;
 
-			auto it = FileCache::get(_path);
-			if (it != nullptr && !it->isSymLink)
-				return it->exists && it->directory;
+			FileCache cache;
+			if (FileCache::get(_path, cache) && !cache.isSymLink)
+				return cache.exists && cache.directory;
 
 			std::string path = getGenericPath(_path);
 			struct stat64 info;
@@ -977,9 +1105,9 @@ namespace Utils
 			if (_path.empty())
 				return false;
 
-			auto it = FileCache::get(_path);
-			if (it != nullptr)
-				return it->exists && it->isSymLink;
+			FileCache cache;
+			if (FileCache::get(_path, cache))
+				return cache.exists && cache.isSymLink;
 				
 			std::string path = getGenericPath(_path);
 
@@ -999,9 +1127,9 @@ namespace Utils
 			if (_path.empty())
 				return false;
 
-			auto it = FileCache::get(_path);
-			if (it != nullptr)
-				return it->exists && it->hidden;
+			FileCache cache;
+			if (FileCache::get(_path, cache))
+				return cache.exists && cache.hidden;
 
 			std::string path = getGenericPath(_path);
 
@@ -68,12 +68,14 @@ namespace Utils
 			std::string path;
 			bool hidden;
 			bool directory;
+			bool symlink;
 		};
 
 		typedef std::list<FileInfo> fileList;
 
 		fileList        getDirectoryFiles(const std::string& _path);
 		fileList        getDirInfo       (const std::string& _path/*, const bool _recursive = false*/);
+		void            cacheDirInfo     (const std::string& _path, const fileList& _content); // Feeds the file cache with a listing obtained elsewhere
 
 		std::string readAllText          (const std::string fileName);
 		void        writeAllText         (const std::string fileName, const std::string text);
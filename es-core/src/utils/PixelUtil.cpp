@@ -0,0 +1,128 @@
+#include "utils/PixelUtil.h"
+
+#include <string.h>
+#include <vector>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PIXEL_NEON
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PIXEL_SSE2
+#endif
+
+namespace Utils
+{
+	namespace Pixel
+	{
+		void swapRedBlue(const unsigned char* src, unsigned char* dst, size_t count)
+		{
+			size_t i = 0;
+
+#if defined(PIXEL_NEON)
+			for (; i + 16 <= count; i += 16)
+			{
+				uint8x16x4_t px = vld4q_u8(src + i * 4);
+				uint8x16_t tmp = px.val[0];
+				px.val[0] = px.val[2];
+				px.val[2] = tmp;
+				vst4q_u8(dst + i * 4, px);
+			}
+#elif defined(PIXEL_SSE2)
+			const __m128i maskAG = _mm_set1_epi32(0xFF00FF00);
+			const __m128i maskRB = _mm_set1_epi32(0x00FF00FF);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i px = _mm_loadu_si128((const __m128i*)(src + i * 4));
+				__m128i rb = _mm_and_si128(px, maskRB);
+				rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+				_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(_mm_and_si128(px, maskAG), rb));
+			}
+#endif
+
+			for (; i < count; i++)
+			{
+				const unsigned char* s = src + i * 4;
+				unsigned char* d = dst + i * 4;
+
+				unsigned char r = s[0];
+				d[0] = s[2];
+				d[1] = s[1];
+				d[2] = r;
+				d[3] = s[3];
+			}
+		}
+
+		void flipVertical(unsigned char* pixels, size_t width, size_t height)
+		{
+			size_t pitch = width * 4;
+			std::vector<unsigned char> temp(pitch);
+
+			// memcpy is already vectorized by the C library
+			for (size_t y = 0; y < height / 2; y++)
+			{
+				unsigned char* top = pixels + y * pitch;
+				unsigned char* bottom = pixels + (height - y - 1) * pitch;
+
+				memcpy(temp.data(), top, pitch);
+				memcpy(top, bottom, pitch);
+				memcpy(bottom, temp.data(), pitch);
+			}
+		}
+
+		void halveRows(const unsigned char* src0, const unsigned char* src1, unsigned char* dst, size_t width)
+		{
+			size_t dstWidth = width / 2;
+			size_t x = 0;
+
+#if defined(PIXEL_NEON)
+			for (; x + 8 <= dstWidth; x += 8)
+			{
+				uint8x16x4_t a = vld4q_u8(src0 + x * 8);
+				uint8x16x4_t b = vld4q_u8(src1 + x * 8);
+
+				uint8x8x4_t px;
+				for (int c = 0; c < 4; c++)
+					px.val[c] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[c]), b.val[c]), 2); // (sum + 2) >> 2
+
+				vst4_u8(dst + x * 4, px);
+			}
+#elif defined(PIXEL_SSE2)
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i round = _mm_set1_epi16(2);
+
+			for (; x + 2 <= dstWidth; x += 2)
+			{
+				__m128i a = _mm_loadu_si128((const __m128i*)(src0 + x * 8));
+				__m128i b = _mm_loadu_si128((const __m128i*)(src1 + x * 8));
+
+				// Columns 0-1 and 2-3, summed vertically on 16 bits
+				__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+				__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+				__m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+				sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+
+				_mm_storel_epi64((__m128i*)(dst + x * 4), _mm_packus_epi16(sum, sum));
+			}
+#endif
+
+			for (; x < dstWidth; x++)
+			{
+				const unsigned char* a = src0 + x * 8;
+				const unsigned char* b = src1 + x * 8;
+				unsigned char* d = dst + x * 4;
+
+				for (int c = 0; c < 4; c++)
+					d[c] = (unsigned char)((a[c] + a[c + 4] + b[c] + b[c + 4] + 2) >> 2);
+			}
+		}
+
+		void halve(const unsigned char* src, size_t srcPitch, unsigned char* dst, size_t dstPitch, size_t width, size_t height)
+		{
+			for (size_t y = 0; y < height / 2; y++)
+				halveRows(src + y * 2 * srcPitch, src + (y * 2 + 1) * srcPitch, dst + y * dstPitch, width);
+		}
+	}
+}
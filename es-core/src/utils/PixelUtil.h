@@ -0,0 +1,28 @@
+#pragma once
+#ifndef ES_CORE_UTILS_PIXEL_UTIL_H
+#define ES_CORE_UTILS_PIXEL_UTIL_H
+
+#include <stddef.h>
+
+// Pixel loops of the image loading path, on 32 bits pixels.
+// Uses NEON on ARM and SSE2 on x86 when the compiler targets them, a plain C loop otherwise : the result is the same on every path.
+namespace Utils
+{
+	namespace Pixel
+	{
+		// Exchanges the 1st and 3rd bytes of each pixel (BGRA <-> RGBA). src and dst may be the same buffer
+		void swapRedBlue(const unsigned char* src, unsigned char* dst, size_t count);
+
+		// Reverses the order of the rows
+		void flipVertical(unsigned char* pixels, size_t width, size_t height);
+
+		// Averages each 2x2 block of the two source rows into one pixel of dst, rounding to nearest.
+		// dst is (width / 2) pixels wide : the last column of an odd width is dropped
+		void halveRows(const unsigned char* src0, const unsigned char* src1, unsigned char* dst, size_t width);
+
+		// Same on a whole image, the last row of an odd height is dropped. Pitches are in bytes
+		void halve(const unsigned char* src, size_t srcPitch, unsigned char* dst, size_t dstPitch, size_t width, size_t height);
+	}
+}
+
+#endif // ES_CORE_UTILS_PIXEL_UTIL_H
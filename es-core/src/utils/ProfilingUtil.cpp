@@ -1,20 +1,32 @@
-
 #if defined(USE_PROFILING)
 
 #include "utils/ProfilingUtil.h"
 
+#include "utils/FileSystemUtil.h"
 #include "math/Misc.h"
 #include "Log.h"
 
 #include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+#include <signal.h>
+#include <time.h>
 
 #if defined(_WIN32)
 // because windows...
 #include <Windows.h>
 #define snprintf _snprintf
-#else // _WIN32
-#include <sys/time.h>
-#endif // !_WIN32
+#endif // _WIN32
+
+// Scopes with an index above are traced, but not counted by _dump
+#define PROFILING_MAX_SCOPES 1024
+// Nested scopes deeper than this are traced, but not counted by _dump
+#define PROFILING_MAX_DEPTH  64
+// Oldest events skipped by _exportTrace when the buffer of a running thread has wrapped : they may be overwritten while being read
+#define PROFILING_TRACE_MARGIN 1024
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -22,18 +34,85 @@ namespace Utils
 {
 	namespace Profiling
 	{
-		std::vector<Profile*>     profiles;
-		std::vector<ThreadStack*> threadStacks;
-		std::recursive_mutex      mutex;
-		unsigned int              counter = 0;
+		struct Stat
+		{
+			double       timeTotal;
+			double       timeExternal;
+			double       timeMin;
+			double       timeMax;
+			unsigned int callCount;
+
+		}; // Stat
+
+		struct Frame
+		{
+			unsigned int index;
+			double       timeBegin;
+			double       timeExternal;
+
+		}; // Frame
+
+		struct TraceEvent
+		{
+			uint64_t     counter;
+			unsigned int index;
+			unsigned int begin;
+
+		}; // TraceEvent
+
+		// Written by its thread only. Kept when the thread ends, and given to the next new thread
+		struct ThreadData
+		{
+			ThreadData(unsigned int _id) : id(_id), used(true), head(0), depth(0)
+			{
+				for(Stat& stat : stats)
+				{
+					stat.timeTotal    = 0.0;
+					stat.timeExternal = 0.0;
+					stat.timeMin      = 999999999.0;
+					stat.timeMax      = 0.0;
+					stat.callCount    = 0;
+				}
+			}
+
+			unsigned int              id;
+			std::string               name; // guarded by mutex
+			std::atomic<bool>         used;
+
+			TraceEvent                events[PROFILING_TRACE_BUFFER_SIZE];
+			std::atomic<unsigned int> head;
+
+			Frame                     stack[PROFILING_MAX_DEPTH];
+			unsigned int              depth;
+
+			Stat                      stats[PROFILING_MAX_SCOPES];
+
+		}; // ThreadData
+
+		struct ThreadSlot
+		{
+			ThreadSlot() : data(nullptr) { }
+			~ThreadSlot() { if(data) data->used = false; }
+
+			ThreadData* data;
+
+		}; // ThreadSlot
+
+		static std::vector<std::string> messages;
+		static std::vector<ThreadData*> threads;
+		static std::mutex               mutex;
+		static std::atomic<bool>        exportRequested(false);
+
+		static thread_local ThreadSlot  threadSlot;
 
 //////////////////////////////////////////////////////////////////////////
 
 		static double getFrequency( void )
 		{
 #if defined(_WIN32)
-			uint64_t qpFrequency;
-			QueryPerformanceFrequency((LARGE_INTEGER*)&qpFrequency);
+			static uint64_t qpFrequency = 0;
+			if(qpFrequency == 0)
+				QueryPerformanceFrequency((LARGE_INTEGER*)&qpFrequency);
 			return 1.0 / qpFrequency;
 #else // _WIN32
 			return 1.0 / 1000000.0;
@@ -42,91 +121,90 @@ namespace Utils
 
 //////////////////////////////////////////////////////////////////////////
 
-	static uint64_t getCounter( void )
-	{
+		static uint64_t getCounter( void )
+		{
 #if defined(_WIN32)
 			uint64_t qpCounter;
 			QueryPerformanceCounter((LARGE_INTEGER*)&qpCounter);
 			return qpCounter;
 #else // _WIN32
-			timeval tv;
-			gettimeofday(&tv, nullptr);
-			return static_cast<uint64_t>(tv.tv_sec) * 1000000u + static_cast<uint64_t>(tv.tv_usec);
+			timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return static_cast<uint64_t>(ts.tv_sec) * 1000000u + static_cast<uint64_t>(ts.tv_nsec) / 1000u;
 #endif // !_WIN32
-	} // getCounter
+		} // getCounter
 
 //////////////////////////////////////////////////////////////////////////
 
-		static double getTime(void)
+		static ThreadData* getThreadData(void)
 		{
-			return getCounter() * getFrequency();
+			if(threadSlot.data)
+				return threadSlot.data;
 
-		} // getTime
+			std::unique_lock<std::mutex> lock(mutex);
 
-//////////////////////////////////////////////////////////////////////////
+			for(ThreadData* data : threads)
+			{
+				if(!data->used)
+				{
+					data->used  = true;
+					data->depth = 0;
+					data->name.clear();
+					threadSlot.data = data;
+					return data;
+				}
+			}
 
-		static bool _sortProfiles(const Profile* _a, const Profile* _b)
-		{
-			return _a->message < _b->message;
+			threadSlot.data = new ThreadData((unsigned int)threads.size() + 1);
+			threads.push_back(threadSlot.data);
+			return threadSlot.data;
 
-		} // _sortProfiles
+		} // getThreadData
 
 //////////////////////////////////////////////////////////////////////////
 
-		unsigned int _generateIndex(void)
+		static void record(ThreadData* _data, const uint64_t _counter, const unsigned int _index, const bool _begin)
 		{
-			mutex.lock();
-			unsigned int index = counter++;
-			mutex.unlock();
+			const unsigned int head  = _data->head.load(std::memory_order_relaxed);
+			TraceEvent&        event = _data->events[head % PROFILING_TRACE_BUFFER_SIZE];
 
-			return index;
+			event.counter = _counter;
+			event.index   = _index;
+			event.begin   = _begin ? 1 : 0;
 
-		} // _generateIndex
+			_data->head.store(head + 1, std::memory_order_release);
+
+		} // record
 
 //////////////////////////////////////////////////////////////////////////
 
-		void _begin(const unsigned int _index, const std::string& _message)
+		unsigned int _generateIndex(const std::string& _message)
 		{
-			const std::thread::id threadId    = std::this_thread::get_id();
-			ThreadStack*          threadStack = nullptr;
-			Profile*              profile     = nullptr;
+			std::unique_lock<std::mutex> lock(mutex);
 
-			mutex.lock();
+			messages.push_back(_message);
+			return (unsigned int)messages.size() - 1;
 
-			for( ThreadStack* threadStackIt : threadStacks )
-				if(threadStackIt->id == threadId)
-					threadStack = threadStackIt;
+		} // _generateIndex
 
-			if(!threadStack)
-			{
-				threadStack     = new ThreadStack;
-				threadStack->id = threadId;
+//////////////////////////////////////////////////////////////////////////
 
-				threadStacks.push_back(threadStack);
-			}
+		void _begin(const unsigned int _index)
+		{
+			ThreadData*    data    = getThreadData();
+			const uint64_t counter = getCounter();
 
-			while(profiles.size() < counter)
+			if(data->depth < PROFILING_MAX_DEPTH)
 			{
-				profile               = new Profile;
-				profile->message      = "";
-				profile->timeBegin    = 0.0;
-				profile->timeTotal    = 0.0;
-				profile->timeExternal = 0.0;
-				profile->timeMin      = 999999999.0;
-				profile->timeMax      = 0.0;
-				profile->callCount    = 0;
-
-				profiles.push_back(profile);
+				Frame& frame       = data->stack[data->depth];
+				frame.index        = _index;
+				frame.timeBegin    = counter * getFrequency();
+				frame.timeExternal = 0.0;
 			}
 
-			profile = profiles[_index];
+			data->depth++;
 
-			threadStack->stack.push(profile);
-
-			profile->message   = _message;
-			profile->timeBegin = getTime();
-
-			mutex.unlock();
+			record(data, counter, _index, true);
 
 		} // _begin
 
@@ -134,38 +212,45 @@ namespace Utils
 
 		int _end(void)
 		{
-			const double          timeEnd     = getTime();
-			const std::thread::id threadId    = std::this_thread::get_id();
-			ThreadStack*          threadStack = nullptr;
-			Profile*              profile     = nullptr;
+			ThreadData*    data    = getThreadData();
+			const uint64_t counter = getCounter();
 
-			mutex.lock();
-
-			for( ThreadStack* threadStackIt : threadStacks )
-				if(threadStackIt->id == threadId)
-					threadStack = threadStackIt;
+			if(data->depth == 0)
+				return 0;
 
-			profile = threadStack->stack.top();
-			threadStack->stack.pop();
+			data->depth--;
 
-			// timer wrapped (~24 days)
-			if(timeEnd < profile->timeBegin)
+			if(data->depth >= PROFILING_MAX_DEPTH)
 			{
-				mutex.unlock();
+				record(data, counter, 0, false);
 				return 0;
 			}
 
-			const double timeElapsed = timeEnd - profile->timeBegin;
+			const Frame& frame = data->stack[data->depth];
 
-			profile->timeTotal += timeElapsed;
-			profile->timeMin    = (profile->timeMin < timeElapsed) ? profile->timeMin : timeElapsed;
-			profile->timeMax    = (profile->timeMax > timeElapsed) ? profile->timeMax : timeElapsed;
-			profile->callCount++;
+			record(data, counter, frame.index, false);
 
-			if(!threadStack->stack.empty())
-				threadStack->stack.top()->timeExternal += timeElapsed;
+			const double timeEnd = counter * getFrequency();
 
-			mutex.unlock();
+			// timer wrapped
+			if(timeEnd < frame.timeBegin)
+				return 0;
+
+			const double timeElapsed = timeEnd - frame.timeBegin;
+
+			if(frame.index < PROFILING_MAX_SCOPES)
+			{
+				Stat& stat = data->stats[frame.index];
+
+				stat.timeTotal    += timeElapsed;
+				stat.timeExternal += frame.timeExternal;
+				stat.timeMin       = (stat.timeMin < timeElapsed) ? stat.timeMin : timeElapsed;
+				stat.timeMax       = (stat.timeMax > timeElapsed) ? stat.timeMax : timeElapsed;
+				stat.callCount++;
+			}
+
+			if(data->depth > 0)
+				data->stack[data->depth - 1].timeExternal += timeElapsed;
 
 			return timeElapsed;
 
@@ -175,48 +260,198 @@ namespace Utils
 
 		void _dump(void)
 		{
-			std::sort(profiles.begin(), profiles.end(), _sortProfiles);
+			std::unique_lock<std::mutex> lock(mutex);
+
+			const unsigned int count = std::min((unsigned int)messages.size(), (unsigned int)PROFILING_MAX_SCOPES);
+			if(count == 0)
+				return;
 
-			if(!profiles.empty())
+			// Totals of every thread
+			std::vector<Stat> stats(count);
+			for(unsigned int i = 0; i < count; i++)
 			{
-				char buffer[1024];
-				int  longestMessage = 0;
+				Stat& stat = stats[i];
+
+				stat.timeTotal    = 0.0;
+				stat.timeExternal = 0.0;
+				stat.timeMin      = 999999999.0;
+				stat.timeMax      = 0.0;
+				stat.callCount    = 0;
+
+				for(ThreadData* data : threads)
+				{
+					const Stat& threadStat = data->stats[i];
+
+					stat.timeTotal    += threadStat.timeTotal;
+					stat.timeExternal += threadStat.timeExternal;
+					stat.timeMin       = (stat.timeMin < threadStat.timeMin) ? stat.timeMin : threadStat.timeMin;
+					stat.timeMax       = (stat.timeMax > threadStat.timeMax) ? stat.timeMax : threadStat.timeMax;
+					stat.callCount    += threadStat.callCount;
+				}
+			}
+
+			std::vector<unsigned int> order;
+			for(unsigned int i = 0; i < count; i++)
+				if(stats[i].callCount > 0 && messages[i].length())
+					order.push_back(i);
+
+			std::sort(order.begin(), order.end(), [](const unsigned int _a, const unsigned int _b) { return messages[_a] < messages[_b]; });
 
-				for(Profile* profile : profiles)
-					longestMessage = Math::max(longestMessage, (int)profile->message.length());
+			char buffer[1024];
+			int  longestMessage = 0;
 
-				char format1[1024];
-				snprintf(format1, 1024, "%%-%ds\t%%12s\t%%12s\t%%12s\t%%12s\t%%12s\t%%20s\t%%20s", longestMessage);
+			for(unsigned int i : order)
+				longestMessage = Math::max(longestMessage, (int)messages[i].length());
 
-				snprintf(buffer, 1024, format1, "Message", "Calls", "Total Time", "Avg Time", "Min Time", "Max Time", "Internal Total Time", "Internal Avg Time");
+			char format1[1024];
+			snprintf(format1, 1024, "%%-%ds\t%%12s\t%%12s\t%%12s\t%%12s\t%%12s\t%%20s\t%%20s", longestMessage);
+
+			snprintf(buffer, 1024, format1, "Message", "Calls", "Total Time", "Avg Time", "Min Time", "Max Time", "Internal Total Time", "Internal Avg Time");
+			LOG(LogDebug) << buffer;
+
+			char format2[1024];
+			snprintf(format2, 1024, "%%-%ds\t%%12d\t%%12.6f\t%%12.6f\t%%12.6f\t%%12.6f\t%%20.6f\t%%20.6f", longestMessage);
+
+			for(unsigned int i : order)
+			{
+				const Stat& stat = stats[i];
+
+				snprintf(buffer, 1024, format2, messages[i].c_str(), stat.callCount, stat.timeTotal, stat.timeTotal / stat.callCount, stat.timeMin, stat.timeMax, stat.timeTotal - stat.timeExternal, (stat.timeTotal - stat.timeExternal) / stat.callCount);
 				LOG(LogDebug) << buffer;
+			}
+
+		} // _dump
+
+//////////////////////////////////////////////////////////////////////////
+
+		void _setThreadName(const std::string& _name)
+		{
+			ThreadData* data = getThreadData();
+
+			std::unique_lock<std::mutex> lock(mutex);
+			data->name = _name;
+
+		} // _setThreadName
+
+//////////////////////////////////////////////////////////////////////////
+
+		static std::string escapeJson(const std::string& _string)
+		{
+			std::string ret;
+
+			for(char c : _string)
+			{
+				if(c == '"' || c == '\\')
+					ret += '\\';
+
+				if((unsigned char)c >= 0x20)
+					ret += c;
+			}
+
+			return ret;
+
+		} // escapeJson
+
+//////////////////////////////////////////////////////////////////////////
+
+		bool _exportTrace(const std::string& _path)
+		{
+			std::ofstream out(_path, std::ios::out | std::ios::trunc);
+			if(!out.is_open())
+			{
+				LOG(LogError) << "Profiling::_exportTrace() - Unable to write " << _path;
+				return false;
+			}
+
+			std::unique_lock<std::mutex> lock(mutex);
+
+			const double toMicroseconds = getFrequency() * 1000000.0;
 
-				char format2[1024];
-				snprintf(format2, 1024, "%%-%ds\t%%12d\t%%12.6f\t%%12.6f\t%%12.6f\t%%12.6f\t%%20.6f\t%%20.6f", longestMessage);
+			char buffer[256];
+			bool first = true;
 
-				for(Profile* profile : profiles)
+			out << "{\"traceEvents\":[";
+
+			for(ThreadData* data : threads)
+			{
+				std::string name = data->name.empty() ? "Thread " + std::to_string(data->id) : data->name;
+
+				out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << data->id << ",\"args\":{\"name\":\"" << escapeJson(name) << "\"}}";
+				first = false;
+
+				const unsigned int head  = data->head.load(std::memory_order_acquire);
+				unsigned int       count = std::min(head, (unsigned int)PROFILING_TRACE_BUFFER_SIZE);
+
+				if(head > PROFILING_TRACE_BUFFER_SIZE)
+					count -= PROFILING_TRACE_MARGIN;
+
+				// Ends whose begin was overwritten are skipped, the viewer expects them paired
+				int depth = 0;
+
+				for(unsigned int i = head - count; i != head; i++)
 				{
-					if(profile->message.length())
+					const TraceEvent event = data->events[i % PROFILING_TRACE_BUFFER_SIZE];
+
+					if(event.begin)
 					{
-						snprintf(buffer, 1024, format2, profile->message.c_str(), profile->callCount, profile->timeTotal, profile->timeTotal / profile->callCount, profile->timeMin, profile->timeMax, profile->timeTotal - profile->timeExternal, (profile->timeTotal - profile->timeExternal) / profile->callCount);
-						LOG(LogDebug) << buffer;
+						depth++;
+
+						const std::string& message = event.index < messages.size() ? messages[event.index] : std::string();
+						snprintf(buffer, sizeof(buffer), "\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", event.counter * toMicroseconds, data->id);
+						out << ",\n{\"name\":\"" << escapeJson(message) << "\"," << buffer;
 					}
+					else if(depth > 0)
+					{
+						depth--;
 
-					delete profile;
+						snprintf(buffer, sizeof(buffer), "\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", event.counter * toMicroseconds, data->id);
+						out << ",\n{" << buffer;
+					}
 				}
-
-				profiles.clear();
 			}
 
-			if(!threadStacks.empty())
-			{
-				for(ThreadStack* threadStack : threadStacks)
-					delete threadStack;
+			out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+			out.close();
+
+			LOG(LogInfo) << "Profiling::_exportTrace() - Trace written to " << _path;
+			return true;
+
+		} // _exportTrace
+
+//////////////////////////////////////////////////////////////////////////
+
+		void _requestExport(void)
+		{
+			exportRequested = true;
+
+		} // _requestExport
+
+//////////////////////////////////////////////////////////////////////////
+
+		static void onSignal(int _signal)
+		{
+			_requestExport();
 
-				threadStacks.clear();
+		} // onSignal
+
+//////////////////////////////////////////////////////////////////////////
+
+		void _frame(void)
+		{
+			static bool signalInstalled = false;
+			if(!signalInstalled)
+			{
+				signalInstalled = true;
+#if !defined(_WIN32)
+				// kill -USR2 <pid> writes a trace
+				signal(SIGUSR2, onSignal);
+#endif // !_WIN32
 			}
 
-		} // _dump
+			if(exportRequested.exchange(false))
+				_exportTrace(Utils::FileSystem::getEsConfigPath() + "/es_trace_" + std::to_string(time(NULL)) + ".json");
+
+		} // _frame
 
 	} // Profiling::
 
@@ -4,55 +4,39 @@
 
 #if defined(USE_PROFILING)
 
-#include <mutex>
-#include <stack>
 #include <string>
-#include <thread>
-#include <vector>
+
+// Events kept per thread for the trace, the oldest are overwritten
+#define PROFILING_TRACE_BUFFER_SIZE 32768
 
 namespace Utils
 {
 	namespace Profiling
 	{
-		struct Profile
-		{
-			std::string  message;
-			double       timeBegin;
-			double       timeTotal;
-			double       timeExternal;
-			double       timeMin;
-			double       timeMax;
-			unsigned int callCount;
-
-		}; // Profile
-
-		struct ThreadStack
-		{
-			std::stack<Profile*> stack;
-			std::thread::id      id;
-
-		}; // ThreadStack
+		// Each thread records its scopes in its own buffers : a scope takes no lock.
+		// _dump logs the totals of every scope, _exportTrace writes the last events as a Chrome trace (chrome://tracing, Perfetto).
 
-		extern std::vector<Profile*>     profiles;
-		extern std::vector<ThreadStack*> threadStacks;
-		extern std::recursive_mutex      mutex;
-		extern unsigned int              counter;
-
-//////////////////////////////////////////////////////////////////////////
-
-		unsigned int _generateIndex(void);
-		void         _begin        (const unsigned int _index, const std::string& _message);
+		unsigned int _generateIndex(const std::string& _message);
+		void         _begin        (const unsigned int _index);
 		int          _end          (void);
 		void         _dump         (void);
 
+		void         _setThreadName(const std::string& _name);
+		bool         _exportTrace  (const std::string& _path);
+
+		// Async-signal-safe, the trace is written by the next _frame
+		void         _requestExport(void);
+		// Called once per frame by the main loop. Also installs the SIGUSR2 handler requesting an export
+		void         _frame        (void);
+
 //////////////////////////////////////////////////////////////////////////
 
 		class Scope
 		{
 		public:
 
-			 Scope(const unsigned int _index, const std::string& _message) { _begin(_index, _message); }
-			~Scope(void)                                                   { _end(); }
+			 Scope(const unsigned int _index) { _begin(_index); }
+			~Scope(void)                      { _end(); }
 
 		}; // Scope
 
@@ -66,10 +50,14 @@ namespace Utils
 #define __profilingUniqueIndex         _profilingUniqueIndex(__LINE__)
 #define __profilingUniqueScope         _profilingUniqueScope(__LINE__)
 
-#define ProfileBegin(_message) static const unsigned int __profilingUniqueIndex = Utils::Profiling::_generateIndex(); Utils::Profiling::_begin(__profilingUniqueIndex, _message)
-#define ProfileEnd()           Utils::Profiling::_end()
-#define ProfileScope(_message) static const unsigned int __profilingUniqueIndex = Utils::Profiling::_generateIndex(); const Utils::Profiling::Scope __profilingUniqueScope(__profilingUniqueIndex, _message)
-#define ProfileDump()          Utils::Profiling::_dump()
+// The message is read once per call site
+#define ProfileBegin(_message)    static const unsigned int __profilingUniqueIndex = Utils::Profiling::_generateIndex(_message); Utils::Profiling::_begin(__profilingUniqueIndex)
+#define ProfileEnd()              Utils::Profiling::_end()
+#define ProfileScope(_message)    static const unsigned int __profilingUniqueIndex = Utils::Profiling::_generateIndex(_message); const Utils::Profiling::Scope __profilingUniqueScope(__profilingUniqueIndex)
+#define ProfileDump()             Utils::Profiling::_dump()
+#define ProfileThreadName(_name)  Utils::Profiling::_setThreadName(_name)
+#define ProfileFrame()            Utils::Profiling::_frame()
+#define ProfileExport()           Utils::Profiling::_requestExport()
 
 #else // USE_PROFILING
 
@@ -77,6 +65,9 @@ namespace Utils
 #define ProfileEnd()
 #define ProfileScope(_message)
 #define ProfileDump()
+#define ProfileThreadName(_name)
+#define ProfileFrame()
+#define ProfileExport()
 
 #endif // !USE_PROFILING
 
@@ -84,4 +75,4 @@ namespace Utils
 #define __PRETTY_FUNCTION__ __FUNCTION__
 #endif // !__PRETTY_FUNCTION__
 
-#endif // ES_CORE_UTILS_TIME_UTIL_H
+#endif // ES_CORE_UTILS_PROFILING_UTIL_H
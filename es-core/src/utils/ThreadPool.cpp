@@ -1,84 +1,199 @@
 #include "ThreadPool.h"
+#include "ProfilingUtil.h"
+#include "Log.h"
 
 namespace Utils
 {
-	ThreadPool::ThreadPool() : mRunning(true), mWaiting(false), mNumWork(0)
+	// Pool & worker index of the current thread, so that work queued from a worker stays on its own deque
+	static thread_local ThreadPool* sCurrentPool = nullptr;
+	static thread_local size_t sCurrentWorker = 0;
+
+	ThreadPool::ThreadPool(size_t threadCount) : mRunning(true), mPending(0), mNumWork(0), mNextQueue(0), mExecuted(0), mStolen(0)
+	{
+		size_t num_threads = threadCount;
+		if (num_threads == 0)
+			num_threads = std::thread::hardware_concurrency();
+
+		if (num_threads == 0)
+			num_threads = 2;
+
+		mQueues.reserve(num_threads);
+		for (size_t i = 0; i < num_threads; i++)
+			mQueues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+
+		mThreads.reserve(num_threads);
+		for (size_t i = 0; i < num_threads; i++)
+			mThreads.push_back(std::thread(&ThreadPool::threadProc, this, i));
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mRunning = false;
+		}
+
+		mWorkAvailable.notify_all();
+
+		for (std::thread& t : mThreads)
+			if (t.joinable())
+				t.join();
+
+		LOG(LogDebug) << "ThreadPool::~ThreadPool() - " << mThreads.size() << " workers, " << mExecuted.load() << " items executed, " << mStolen.load() << " stolen";
+	}
+
+	void ThreadPool::queueWorkItem(work_function work, Priority priority)
 	{
-		size_t num_threads = std::thread::hardware_concurrency() * 2;
+		size_t id;
+		if (sCurrentPool == this)
+			id = sCurrentWorker;
+		else
+			id = mNextQueue++ % mQueues.size();
+
+		{
+			WorkerQueue* queue = mQueues[id].get();
+			std::unique_lock<std::mutex> lock(queue->lock);
+			queue->items[priority].push_back(work);
+		}
 
-		auto doWork = [&](size_t id)
 		{
-			while (mRunning)
+			std::unique_lock<std::mutex> lock(mMutex);
+			mPending++;
+			mNumWork++;
+		}
+
+		mWorkAvailable.notify_one();
+	}
+
+	bool ThreadPool::popWork(size_t id, work_function& work, int lastPriority)
+	{
+		size_t count = mQueues.size();
+
+		for (int priority = 0; priority <= lastPriority; priority++)
+		{
+			// Own queue first, oldest item first
 			{
-				_mutex.lock();
-				if (!mWorkQueue.empty())
+				WorkerQueue* queue = mQueues[id].get();
+				std::unique_lock<std::mutex> lock(queue->lock);
+
+				auto& items = queue->items[priority];
+				if (!items.empty())
 				{
-					auto work = mWorkQueue.front();
-					mWorkQueue.pop();
-					_mutex.unlock();
+					work = std::move(items.front());
+					items.pop_front();
+					return true;
+				}
+			}
 
-					try
-					{
-						work();
-					}
-					catch (...) {}
+			// Then steal from the other end of the other workers' queues
+			for (size_t i = 1; i < count; i++)
+			{
+				WorkerQueue* queue = mQueues[(id + i) % count].get();
+				std::unique_lock<std::mutex> lock(queue->lock);
 
-					mNumWork--;
-				}
-				else
+				auto& items = queue->items[priority];
+				if (!items.empty())
 				{
-					_mutex.unlock();
+					work = std::move(items.back());
+					items.pop_back();
+					mStolen++;
+					return true;
+				}
+			}
+		}
 
-					// Extra code : Exit finished threads
-					if (mWaiting)
-						return;
+		return false;
+	}
 
-					std::this_thread::yield();
-					std::this_thread::sleep_for(std::chrono::milliseconds(1));
-				}
+	void ThreadPool::threadProc(size_t id)
+	{
+		sCurrentPool = this;
+		sCurrentWorker = id;
+
+		ProfileThreadName("ThreadPool " + std::to_string(id));
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mWorkAvailable.wait(lock, [this] { return mPending > 0 || !mRunning; });
+
+				if (mPending == 0)
+					return; // Stopped, and nothing left to do
+
+				// Reserve one of the queued items
+				mPending--;
 			}
-		};
 
-		mThreads.reserve(num_threads);
+			// The reserved item is in one of the queues, but another worker may have grabbed the one we saw first
+			work_function work;
+			while (!popWork(id, work))
+				std::this_thread::yield();
 
-		for (size_t i = 0; i < num_threads; i++)
-			mThreads.push_back(std::thread(doWork, i));
+			execute(work);
+		}
 	}
 
-	ThreadPool::~ThreadPool()
+	void ThreadPool::execute(work_function& work)
 	{
-		mRunning = false;
+		try
+		{
+			work();
+		}
+		catch (...) {}
 
-		for (std::thread& t : mThreads)
-			if (t.joinable())
-				t.join();
+		mExecuted++;
+
+		std::unique_lock<std::mutex> lock(mMutex);
+		if (--mNumWork == 0)
+			mWorkDone.notify_all();
 	}
 
-	void ThreadPool::queueWorkItem(work_function work)
+	bool ThreadPool::runPendingWork(Priority priority)
 	{
-		_mutex.lock();
-		mWorkQueue.push(work);
-		mNumWork++;
-		_mutex.unlock();
+		// Reserved like a worker does, so that no worker waits for the item taken here
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			if (mPending == 0)
+				return false;
+
+			mPending--;
+		}
+
+		work_function work;
+		if (!popWork(sCurrentPool == this ? sCurrentWorker : 0, work, priority))
+		{
+			// Only lower priority items left (or taken meanwhile) : give the reservation back
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mPending++;
+			}
+
+			mWorkAvailable.notify_one();
+			return false;
+		}
+
+		execute(work);
+		return true;
 	}
 
 	void ThreadPool::wait()
 	{
-		mWaiting = true;
-		while (mNumWork.load() > 0)
-			std::this_thread::yield();
+		std::unique_lock<std::mutex> lock(mMutex);
+		mWorkDone.wait(lock, [this] { return mNumWork == 0; });
 	}
 
 	void ThreadPool::wait(work_function work, int delay)
 	{
-		mWaiting = true;
-
-		while (mNumWork.load() > 0)
+		while (true)
 		{
-			work();
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				if (mWorkDone.wait_for(lock, std::chrono::milliseconds(delay), [this] { return mNumWork == 0; }))
+					return;
+			}
 
-			std::this_thread::yield();
-			std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+			work();
 		}
 	}
-}
\ No newline at end of file
+}
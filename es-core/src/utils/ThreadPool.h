@@ -2,31 +2,85 @@
 
 #include <thread>
 #include <mutex>
-#include <queue>
+#include <condition_variable>
+#include <deque>
 #include <atomic>
 #include <functional>
+#include <future>
+#include <memory>
+#include <vector>
 
 namespace Utils
 {
+	// Work-stealing pool : each worker owns a set of deques (one per priority) and steals from the others when idle.
+	// Idle workers sleep on a condition variable instead of polling.
 	class ThreadPool
 	{
 	public:
 		typedef std::function<void(void)> work_function;
 
-		ThreadPool();
+		enum Priority
+		{
+			PRIORITY_HIGH = 0,
+			PRIORITY_NORMAL = 1,
+			PRIORITY_LOW = 2,
+
+			PRIORITY_COUNT = 3
+		};
+
+		// threadCount = 0 : one worker per hardware thread
+		ThreadPool(size_t threadCount = 0);
 		~ThreadPool();
 
-		void queueWorkItem(work_function work);
+		void queueWorkItem(work_function work, Priority priority = PRIORITY_NORMAL);
+
+		template<typename F>
+		std::future<typename std::result_of<F()>::type> enqueue(F work, Priority priority = PRIORITY_NORMAL)
+		{
+			typedef typename std::result_of<F()>::type result_type;
+
+			auto task = std::make_shared<std::packaged_task<result_type()>>(work);
+			std::future<result_type> result = task->get_future();
+			queueWorkItem([task] { (*task)(); }, priority);
+			return result;
+		}
+
+		// Blocks until every queued item has been processed
 		void wait();
+		// Same, but calls work every 'delay' ms while waiting (used to refresh the loading screen)
 		void wait(work_function work, int delay = 50);
 
+		// Runs one queued item of priority 'priority' or higher on the calling thread, if any.
+		// Lets a task waiting for the items it queued help instead of blocking its worker
+		bool runPendingWork(Priority priority);
+
+		size_t getThreadCount() const { return mThreads.size(); }
+
 	private:
-		bool mRunning;
-		bool mWaiting;
-		std::queue<work_function> mWorkQueue;
-		std::atomic<size_t> mNumWork;
-		std::mutex _mutex;
+		struct WorkerQueue
+		{
+			std::mutex lock;
+			std::deque<work_function> items[PRIORITY_COUNT];
+		};
+
+		void threadProc(size_t id);
+		bool popWork(size_t id, work_function& work, int lastPriority = PRIORITY_COUNT - 1);
+		void execute(work_function& work);
+
+		std::vector<std::unique_ptr<WorkerQueue>> mQueues;
 		std::vector<std::thread> mThreads;
 
+		std::mutex mMutex;
+		std::condition_variable mWorkAvailable;
+		std::condition_variable mWorkDone;
+
+		bool mRunning;
+		size_t mPending;  // Queued, not started yet
+		size_t mNumWork;  // Queued or running
+		std::atomic<size_t> mNextQueue;
+
+		// Statistics
+		std::atomic<size_t> mExecuted;
+		std::atomic<size_t> mStolen;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,235 @@
+// Compares the vectorized loops of PixelUtil with a plain C version of the same operation.
+// Sizes cross the SIMD block boundaries, widths are odd and buffers are not aligned.
+// With --bench, times both versions on a 1000x1400 image instead.
+
+#include "utils/PixelUtil.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+static int sFailures = 0;
+
+static void check(bool condition, const char* test, size_t size, size_t offset)
+{
+	if (condition)
+		return;
+
+	printf("FAILED %s - size %d, offset %d\n", test, (int)size, (int)offset);
+	sFailures++;
+}
+
+static void fillRandom(std::vector<unsigned char>& buffer)
+{
+	for (auto& value : buffer)
+		value = (unsigned char)(rand() & 0xFF);
+}
+
+static void referenceSwapRedBlue(const unsigned char* src, unsigned char* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		dst[i * 4 + 0] = src[i * 4 + 2];
+		dst[i * 4 + 1] = src[i * 4 + 1];
+		dst[i * 4 + 2] = src[i * 4 + 0];
+		dst[i * 4 + 3] = src[i * 4 + 3];
+	}
+}
+
+static void referenceHalveRows(const unsigned char* src0, const unsigned char* src1, unsigned char* dst, size_t width)
+{
+	for (size_t x = 0; x < width / 2; x++)
+		for (int c = 0; c < 4; c++)
+			dst[x * 4 + c] = (unsigned char)((src0[x * 8 + c] + src0[x * 8 + 4 + c] + src1[x * 8 + c] + src1[x * 8 + 4 + c] + 2) >> 2);
+}
+
+static void testSwapRedBlue()
+{
+	for (size_t count = 0; count <= 70; count++)
+	{
+		for (size_t offset = 0; offset < 4; offset++)
+		{
+			std::vector<unsigned char> src(count * 4 + offset);
+			fillRandom(src);
+
+			// Guard bytes after the pixels catch writes past the end
+			std::vector<unsigned char> expected(count * 4 + offset + 16, 0xCD);
+			std::vector<unsigned char> result(expected);
+
+			referenceSwapRedBlue(src.data() + offset, expected.data() + offset, count);
+			Utils::Pixel::swapRedBlue(src.data() + offset, result.data() + offset, count);
+			check(result == expected, "swapRedBlue", count, offset);
+
+			// In place
+			std::vector<unsigned char> inPlace(src);
+			inPlace.resize(expected.size(), 0xCD);
+			Utils::Pixel::swapRedBlue(inPlace.data() + offset, inPlace.data() + offset, count);
+			check(std::equal(inPlace.begin() + offset, inPlace.end(), expected.begin() + offset), "swapRedBlue in place", count, offset);
+		}
+	}
+}
+
+static void testHalveRows()
+{
+	for (size_t width = 0; width <= 70; width++)
+	{
+		for (size_t offset = 0; offset < 4; offset++)
+		{
+			std::vector<unsigned char> src0(width * 4 + offset);
+			std::vector<unsigned char> src1(width * 4 + offset);
+			fillRandom(src0);
+			fillRandom(src1);
+
+			std::vector<unsigned char> expected((width / 2) * 4 + offset + 16, 0xCD);
+			std::vector<unsigned char> result(expected);
+
+			referenceHalveRows(src0.data() + offset, src1.data() + offset, expected.data() + offset, width);
+			Utils::Pixel::halveRows(src0.data() + offset, src1.data() + offset, result.data() + offset, width);
+			check(result == expected, "halveRows", width, offset);
+		}
+	}
+
+	// Rounding extremes
+	std::vector<unsigned char> full(64 * 4, 0xFF);
+	std::vector<unsigned char> empty(64 * 4, 0x00);
+	std::vector<unsigned char> expected(32 * 4);
+	std::vector<unsigned char> result(32 * 4);
+
+	referenceHalveRows(full.data(), empty.data(), expected.data(), 64);
+	Utils::Pixel::halveRows(full.data(), empty.data(), result.data(), 64);
+	check(result == expected, "halveRows rounding", 64, 0);
+
+	referenceHalveRows(full.data(), full.data(), expected.data(), 64);
+	Utils::Pixel::halveRows(full.data(), full.data(), result.data(), 64);
+	check(result == expected, "halveRows saturation", 64, 0);
+}
+
+static void testHalve()
+{
+	const size_t width = 37;
+	const size_t height = 11;
+	const size_t srcPitch = width * 4 + 3;
+	const size_t dstPitch = (width / 2) * 4 + 5;
+
+	std::vector<unsigned char> src(srcPitch * height);
+	fillRandom(src);
+
+	std::vector<unsigned char> expected(dstPitch * (height / 2), 0xCD);
+	std::vector<unsigned char> result(expected);
+
+	for (size_t y = 0; y < height / 2; y++)
+		referenceHalveRows(src.data() + y * 2 * srcPitch, src.data() + (y * 2 + 1) * srcPitch, expected.data() + y * dstPitch, width);
+
+	Utils::Pixel::halve(src.data(), srcPitch, result.data(), dstPitch, width, height);
+	check(result == expected, "halve", width, 0);
+}
+
+static void testFlipVertical()
+{
+	const size_t width = 13;
+	const size_t height = 7;
+
+	std::vector<unsigned char> pixels(width * 4 * height);
+	fillRandom(pixels);
+
+	std::vector<unsigned char> result(pixels);
+	Utils::Pixel::flipVertical(result.data(), width, height);
+
+	bool same = true;
+	for (size_t y = 0; y < height; y++)
+		same &= memcmp(result.data() + y * width * 4, pixels.data() + (height - y - 1) * width * 4, width * 4) == 0;
+
+	check(same, "flipVertical", width, 0);
+}
+
+static void referenceFlipVertical(unsigned char* pixels, size_t width, size_t height)
+{
+	size_t pitch = width * 4;
+
+	for (size_t y = 0; y < height / 2; y++)
+	{
+		unsigned char* top = pixels + y * pitch;
+		unsigned char* bottom = pixels + (height - y - 1) * pitch;
+
+		for (size_t x = 0; x < pitch; x++)
+			std::swap(top[x], bottom[x]);
+	}
+}
+
+// Average time of one call, in microseconds
+template<typename F>
+static double measure(F func)
+{
+	const int iterations = 50;
+
+	func(); // warm up the caches
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++)
+		func();
+
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+static void report(const char* name, double reference, double optimized)
+{
+	printf("%-12s reference %8.1f us   PixelUtil %8.1f us   x%.2f\n", name, reference, optimized, optimized > 0 ? reference / optimized : 0);
+}
+
+static int bench()
+{
+	const size_t width = 1000;
+	const size_t height = 1400;
+	const size_t pitch = width * 4;
+	const size_t halfPitch = (width / 2) * 4;
+
+	std::vector<unsigned char> src(pitch * height);
+	std::vector<unsigned char> dst(pitch * height);
+	std::vector<unsigned char> half(halfPitch * (height / 2));
+	fillRandom(src);
+
+	printf("%dx%d image\n", (int)width, (int)height);
+
+	report("swapRedBlue",
+		measure([&] { referenceSwapRedBlue(src.data(), dst.data(), width * height); }),
+		measure([&] { Utils::Pixel::swapRedBlue(src.data(), dst.data(), width * height); }));
+
+	report("halve",
+		measure([&]
+		{
+			for (size_t y = 0; y < height / 2; y++)
+				referenceHalveRows(src.data() + y * 2 * pitch, src.data() + (y * 2 + 1) * pitch, half.data() + y * halfPitch, width);
+		}),
+		measure([&] { Utils::Pixel::halve(src.data(), pitch, half.data(), halfPitch, width, height); }));
+
+	report("flipVertical",
+		measure([&] { referenceFlipVertical(dst.data(), width, height); }),
+		measure([&] { Utils::Pixel::flipVertical(dst.data(), width, height); }));
+
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	srand(1234);
+
+	if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+		return bench();
+
+	testSwapRedBlue();
+	testHalveRows();
+	testHalve();
+	testFlipVertical();
+
+	if (sFailures != 0)
+	{
+		printf("%d failure(s)\n", sFailures);
+		return 1;
+	}
+
+	printf("All tests passed\n");
+	return 0;
+}
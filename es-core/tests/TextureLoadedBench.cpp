@@ -0,0 +1,101 @@
+// Times the notification of the textures decoded by the loader threads, with 5000 textures in the TextureDataManager.
+// The previous version walked the whole lookup map for each decoded texture to find its TextureResource,
+// it's rebuilt here next to TextureDataManager::onTextureLoaded & processLoadedTextures.
+
+#include "resources/TextureData.h"
+#include "resources/TextureDataManager.h"
+#include "resources/TextureResource.h"
+
+#include <stdio.h>
+#include <chrono>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+static const int TEXTURE_COUNT = 5000;
+static const int LOADED_COUNT = 200; // Decoded during a fast scroll in a grid
+
+// Without a path, the resource stays out of the manager of TextureResource : the bench adds it to its own
+class BenchTexture : public TextureResource
+{
+public:
+	BenchTexture() : TextureResource("", false, false, true, false, MaxSizeInfo()) { }
+};
+
+typedef std::map<const TextureResource*, std::list<std::shared_ptr<TextureData>>::const_iterator> TextureLookup;
+
+// The previous TextureDataManager::onTextureLoaded
+static void legacyOnTextureLoaded(std::mutex& mutex, const TextureLookup& lookup, std::shared_ptr<TextureData> tex)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+
+	for (auto it = lookup.cbegin(); it != lookup.cend(); it++)
+	{
+		std::shared_ptr<TextureData> texture = *(*it).second;
+		if (texture == tex)
+		{
+			const TextureResource* pResource = it->first;
+			((TextureResource*)pResource)->onTextureLoaded(tex);
+		}
+	}
+}
+
+// Average time of one call, in microseconds
+template<typename F>
+static double measure(F func)
+{
+	const int iterations = 20;
+
+	func(); // warm up the caches
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++)
+		func();
+
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main(int /*argc*/, char* /*argv*/[])
+{
+	std::vector<std::unique_ptr<BenchTexture>> resources;
+	for (int i = 0; i < TEXTURE_COUNT; i++)
+		resources.push_back(std::unique_ptr<BenchTexture>(new BenchTexture()));
+
+	// Destroyed before the resources it points to
+	TextureDataManager manager;
+
+	std::vector<std::shared_ptr<TextureData>> textures;
+	for (auto& resource : resources)
+		textures.push_back(manager.add(resource.get(), false, false));
+
+	// Same layout as the lookup of the manager
+	std::mutex mutex;
+	std::list<std::shared_ptr<TextureData>> list;
+	TextureLookup lookup;
+	for (int i = 0; i < TEXTURE_COUNT; i++)
+	{
+		list.push_front(textures[i]);
+		lookup[resources[i].get()] = list.cbegin();
+	}
+
+	// The last decoded textures are the most recently added ones, like the visible items of a gamelist
+	double legacy = measure([&]
+	{
+		for (int i = TEXTURE_COUNT - LOADED_COUNT; i < TEXTURE_COUNT; i++)
+			legacyOnTextureLoaded(mutex, lookup, textures[i]);
+	});
+
+	double current = measure([&]
+	{
+		for (int i = TEXTURE_COUNT - LOADED_COUNT; i < TEXTURE_COUNT; i++)
+			manager.onTextureLoaded(textures[i]);
+
+		manager.processLoadedTextures();
+	});
+
+	printf("%d textures, %d decoded\n", TEXTURE_COUNT, LOADED_COUNT);
+	printf("map scan %10.1f us   owner + processLoadedTextures %8.1f us   x%.0f\n", legacy, current, current > 0 ? legacy / current : 0);
+	return 0;
+}
@@ -0,0 +1,216 @@
+// Times a workload shaped like SystemData::loadConfig on the ThreadPool and on the pool it replaced :
+// one item per system, a few large systems among many small ones, parsing (CPU) mixed with file system waits,
+// while the calling thread refreshes a loading screen. Reports the wall time and the CPU time of the process.
+
+#include "utils/ThreadPool.h"
+
+#include <stdio.h>
+#include <sys/resource.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The pool before the work-stealing one : workers poll the queue every ms, wait() polls the item count
+class LegacyThreadPool
+{
+public:
+	typedef std::function<void(void)> work_function;
+
+	LegacyThreadPool() : mRunning(true), mWaiting(false), mNumWork(0)
+	{
+		size_t num_threads = std::thread::hardware_concurrency() * 2;
+
+		auto doWork = [&]()
+		{
+			while (mRunning)
+			{
+				_mutex.lock();
+				if (!mWorkQueue.empty())
+				{
+					auto work = mWorkQueue.front();
+					mWorkQueue.pop();
+					_mutex.unlock();
+
+					work();
+					mNumWork--;
+				}
+				else
+				{
+					_mutex.unlock();
+
+					if (mWaiting)
+						return;
+
+					std::this_thread::yield();
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+		};
+
+		for (size_t i = 0; i < num_threads; i++)
+			mThreads.push_back(std::thread(doWork));
+	}
+
+	~LegacyThreadPool()
+	{
+		mRunning = false;
+
+		for (std::thread& t : mThreads)
+			if (t.joinable())
+				t.join();
+	}
+
+	void queueWorkItem(work_function work)
+	{
+		_mutex.lock();
+		mWorkQueue.push(work);
+		mNumWork++;
+		_mutex.unlock();
+	}
+
+	void wait(work_function work, int delay = 50)
+	{
+		mWaiting = true;
+
+		while (mNumWork.load() > 0)
+		{
+			work();
+
+			std::this_thread::yield();
+			std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+		}
+	}
+
+private:
+	bool mRunning;
+	bool mWaiting;
+	std::queue<work_function> mWorkQueue;
+	std::atomic<size_t> mNumWork;
+	std::mutex _mutex;
+	std::vector<std::thread> mThreads;
+};
+
+static const int SYSTEM_COUNT = 60;
+
+// Every 10th system is a large one, like the arcade or snes folders of a full card
+static int getGameCount(int system)
+{
+	return system % 10 == 0 ? 3000 : 150;
+}
+
+// Parses the games of a system : hashing stands for the gamelist & path work, a short sleep every 100 games for the disk
+static size_t loadSystem(int system)
+{
+	size_t hash = 0;
+
+	for (int game = 0; game < getGameCount(system); game++)
+	{
+		std::string path = "/roms/system" + std::to_string(system) + "/game" + std::to_string(game) + ".zip";
+		for (int i = 0; i < 40; i++)
+			hash ^= std::hash<std::string>()(path + std::to_string(hash + i));
+
+		if (game % 100 == 0)
+			std::this_thread::sleep_for(std::chrono::microseconds(500));
+	}
+
+	return hash;
+}
+
+struct Measure
+{
+	double wall; // ms
+	double cpu;  // ms
+};
+
+static double getCpuTime()
+{
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+
+	return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+}
+
+template<typename F>
+static Measure measure(F func)
+{
+	double cpu = getCpuTime();
+	auto start = std::chrono::steady_clock::now();
+
+	func();
+
+	Measure ret;
+	ret.wall = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	ret.cpu = getCpuTime() - cpu;
+	return ret;
+}
+
+static void report(const char* name, const Measure& legacy, const Measure& pool)
+{
+	printf("%-20s wall %8.1f ms -> %8.1f ms   cpu %8.1f ms -> %8.1f ms\n", name, legacy.wall, pool.wall, legacy.cpu, pool.cpu);
+}
+
+static void loadLegacy()
+{
+	std::atomic<int> processed(0);
+	std::atomic<size_t> result(0);
+	int refreshes = 0;
+
+	LegacyThreadPool pool;
+
+	for (int system = 0; system < SYSTEM_COUNT; system++)
+		pool.queueWorkItem([system, &processed, &result] { result ^= loadSystem(system); processed++; });
+
+	pool.wait([&refreshes] { refreshes++; }, 50);
+}
+
+static void loadPool(size_t threadCount)
+{
+	std::atomic<int> processed(0);
+	int refreshes = 0;
+
+	Utils::ThreadPool pool(threadCount);
+
+	std::vector<std::future<size_t>> systems;
+	for (int system = 0; system < SYSTEM_COUNT; system++)
+		systems.push_back(pool.enqueue([system, &processed] { size_t hash = loadSystem(system); processed++; return hash; }));
+
+	pool.wait([&refreshes] { refreshes++; }, 50);
+
+	size_t result = 0;
+	for (auto& system : systems)
+		result ^= system.get();
+}
+
+// The pools stay alive while nothing is queued, e.g. while the loading screen fades
+static void idleLegacy()
+{
+	LegacyThreadPool pool;
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+}
+
+static void idlePool()
+{
+	Utils::ThreadPool pool;
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+}
+
+int main(int /*argc*/, char* /*argv*/[])
+{
+	printf("%d systems, %d hardware threads, legacy pool -> ThreadPool\n", SYSTEM_COUNT, (int)std::thread::hardware_concurrency());
+
+	// Warm up the allocator and the caches
+	loadPool(0);
+
+	report("loadConfig", measure(loadLegacy), measure([] { loadPool(0); }));
+	// The legacy pool starts twice as many workers, which overlaps more of the disk waits
+	report("same worker count", measure(loadLegacy), measure([] { loadPool(std::thread::hardware_concurrency() * 2); }));
+	report("idle 500 ms", measure(idleLegacy), measure(idlePool));
+
+	return 0;
+}